@@ -35,10 +35,6 @@ namespace LLG_arrays{
 	extern std::vector <double> y_euler_array;	
 	extern std::vector <double> z_euler_array;
 
-	extern std::vector <double> x_heun_array;	
-	extern std::vector <double> y_heun_array;	
-	extern std::vector <double> z_heun_array;
-
 	extern std::vector <double> x_spin_storage_array;	
 	extern std::vector <double> y_spin_storage_array;	
 	extern std::vector <double> z_spin_storage_array;
@@ -89,6 +89,7 @@ namespace atoms
 	extern std::vector <int> category_array;
 	extern std::vector <int> grain_array;
 	extern std::vector <int> cell_array;
+   extern std::vector <uint64_t> global_id_array; /// Decomposition independent atom id from unit cell position
 
 	extern std::vector <double> x_spin_array;
 	extern std::vector <double> y_spin_array;
@@ -27,6 +27,9 @@ namespace cells{
    extern int num_atoms_in_unit_cell;
    extern int num_cells; /// number of macro-cells
    extern int num_local_cells; /// number of macro-cells
+   extern int num_cells_x; /// number of macro-cells in x,y,z
+   extern int num_cells_y;
+   extern int num_cells_z;
    extern double macro_cell_size; /// lateral size of local macro-cells (A)
 
    extern std::vector <int> local_cell_array;
@@ -28,6 +28,11 @@ namespace config{
    //-----------------------------------------------------------------------------
    void output();
 
+   //-----------------------------------------------------------------------------
+   // Function to complete any outstanding data output at the end of a simulation
+   //-----------------------------------------------------------------------------
+   void finalize();
+
    //---------------------------------------------------------------------------
    // Function to process input file parameters for config module
    //---------------------------------------------------------------------------
@@ -307,6 +307,10 @@ namespace create{
 	// Variable for total number of atoms that are not filler
 	extern int num_total_atoms_non_filler;
 
+   // New atom number for each local atom in generation order, used to keep output
+   // in generation order if atoms are renumbered (empty if not renumbered)
+   extern std::vector<int> renumbered_atom_array;
+
 	// Functions
    void initialize();
 	bool match_material_parameter(std::string const word, std::string const value, std::string const unit, int const line, int const super_index, const int sub_index);
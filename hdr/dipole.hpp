@@ -54,6 +54,11 @@ namespace dipole{
    //-----------------------------------------------------------------------------
    void calculate_field(const uint64_t sim_time);
 
+   //-----------------------------------------------------------------------------
+   // Function to output statistics of adaptive field updates
+   //-----------------------------------------------------------------------------
+   void output_update_statistics();
+
    //--------------------------------------------------------
    // Function to send cells field to be output in cfg file
    //--------------------------------------------------------
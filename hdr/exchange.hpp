@@ -90,6 +90,17 @@ namespace exchange{
    //---------------------------------------------------------------------------
    double single_spin_energy(const int atom, const double sx, const double sy, const double sz);
 
+   //---------------------------------------------------------------------------
+   // Calculate exchange field acting on a single spin, adding to hx, hy, hz.
+   // Returns true if the atom interacts with its own periodic image.
+   //---------------------------------------------------------------------------
+   bool single_spin_field(const int atom, double& hx, double& hy, double& hz);
+
+   //---------------------------------------------------------------------------
+   // Calculate change in exchange energy with periodic images of the same spin
+   //---------------------------------------------------------------------------
+   double self_image_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]);
+
    //-----------------------------------------------------------------------------
    // Function to calculate exchange fields for spins between start and end index
    //-----------------------------------------------------------------------------
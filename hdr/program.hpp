@@ -53,6 +53,7 @@ namespace program
 	extern int LLB_Boltzmann();
 	extern int timestep_scaling();
 	extern void boltzmann_dist();
+	extern void random_number_benchmark();
         extern void setting_process();
 
 }
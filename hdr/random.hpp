@@ -24,6 +24,8 @@
 //
 #ifndef RANDOM_H_
 #define RANDOM_H_
+#include <stdint.h>
+#include <vector>
 #include "mtrand.hpp"
 namespace mtrandom
 //==========================================================
@@ -33,9 +35,27 @@ namespace mtrandom
 	extern MTRand grnd; /// single sequence of random numbers
 	extern double gaussian();
 	extern double gaussianc(MTRand&);
+	extern void gaussian_array(std::vector<double>& array, const int start_index, const int end_index);
 	
 	extern int voronoi_seed;
 	extern int integration_seed;
+
+	// Counter based random number generation for thermal fields
+	extern bool counter_based; /// flag to use counter based (Philox) generator for thermal fields
+	extern uint64_t counter; /// counter for counter based generator, incremented every time step
+
+	// Streams of counter based random numbers
+	enum stream_t { thermal_stream = 0, ltmp_stream = 1, mc_stream = 2 };
+
+	extern void gaussian_block(const stream_t stream,
+										const std::vector<uint64_t>& id_array,
+										std::vector<double>& x_array,
+										std::vector<double>& y_array,
+										std::vector<double>& z_array,
+										const int start_index,
+										const int end_index);
+
+	extern void counter_uniforms(const stream_t stream, const uint64_t id, const uint64_t count, double u[4]);
 }
 
 
@@ -134,6 +134,9 @@ namespace sim{
    extern bool save_checkpoint_flag; // Save checkpoint
    extern bool save_checkpoint_continuous_flag; // save checkpoints during simulations
    extern int save_checkpoint_rate; // Default increment between checkpoints
+   extern int checkpoint_generations; // Number of previous checkpoint files kept
+   extern bool asynchronous_checkpoint_flag; // write checkpoints in the background
+   extern int checkpoint_output_nodes; // Number of collated checkpoint files (0 = file per process)
 
 	// Initialization functions
 	extern void initialize(int num_materials);
@@ -171,6 +174,7 @@ namespace sim{
 
 	// Field and energy functions
 	extern double calculate_spin_energy(const int atom);
+	extern double calculate_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]);
    extern double spin_applied_field_energy(const double, const double, const double);
    extern double spin_magnetostatic_energy(const int, const double, const double, const double);
 
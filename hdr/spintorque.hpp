@@ -55,6 +55,11 @@ namespace st{
    // Variables used for the spin torque calculation
    //-----------------------------------------------------------------------------
 
+   //-----------------------------------------------------------------------------
+   // Function to check spin torque calculation is enabled
+   //-----------------------------------------------------------------------------
+   bool is_enabled();
+
    //-----------------------------------------------------------------------------
    // Function to initialise spin torque calculation
    //-----------------------------------------------------------------------------
@@ -87,6 +87,12 @@ namespace stats
    extern bool calculate_material_susceptibility;
 
    class susceptibility_statistic_t;
+   class magnetization_statistic_t;
+
+   // Function to calculate several magnetization statistics in a single pass over atoms
+   void calculate_magnetizations(const std::vector<magnetization_statistic_t*>& stats_list,
+                                 const std::vector<double>& sx, const std::vector<double>& sy,
+                                 const std::vector<double>& sz, const std::vector<double>& mm);
 
    //----------------------------------
    // Magnetization Class definition
@@ -94,6 +100,9 @@ namespace stats
    class magnetization_statistic_t{
 
       friend class susceptibility_statistic_t;
+      friend void calculate_magnetizations(const std::vector<magnetization_statistic_t*>& stats_list,
+                                           const std::vector<double>& sx, const std::vector<double>& sy,
+                                           const std::vector<double>& sz, const std::vector<double>& mm);
 
       public:
          //magnetization_statistic_t (const int in_mask_size, std::vector<int> in_mask);
@@ -115,6 +124,8 @@ namespace stats
 			std::string output_mean_magnetization();
 
       private:
+         void normalize_magnetization();
+
          bool initialized;
          int num_atoms;
          int mask_size;
@@ -132,6 +132,7 @@ namespace vout{
 // Checkpoint load/save functions
 void load_checkpoint();
 void save_checkpoint();
+void wait_for_checkpoint();
 
 namespace vio{
    bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
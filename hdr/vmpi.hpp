@@ -44,7 +44,8 @@ namespace vmpi{
 	extern int my_rank; 					///< Local CPU ID
 	extern int num_processors;			///< Total number of CPUs
 	extern int mpi_mode; 				///< MPI Simulation Mode (0 = Geometric Decomposition, 1 = Replicated Data, 2 = Statistical Parallelism)
-   extern unsigned int ppn;			///< Processors per node
+   extern unsigned int ppn;			///< Processors per node (0 = determine from shared memory nodes)
+   extern int mpi_thread_level;		///< Thread support level provided by MPI library
 	extern int num_core_atoms;			///< Number of atoms on local CPU with no external communication
 	extern int num_bdry_atoms;			///< Number of atoms on local CPU with external communication
 	extern int num_halo_atoms;			///< Number of atoms on remote CPUs needed for boundary atom integration
@@ -60,6 +61,9 @@ namespace vmpi{
 
 
 	extern bool replicated_data_staged; ///< Flag for staged system generation
+	extern bool load_balancing; ///< Flag to rebalance geometric decomposition by atom weights
+	extern double load_balancing_atom_weight; ///< Cost of integrating an atom relative to one exchange interaction
+	extern std::string load_balancing_timings_file; ///< File of measured compute times used to calibrate atom weight
 
 	extern char hostname[20];			///< Hostname of local CPU
 	extern double min_dimensions[3]; 	///< Minimum coordinates of system on local cpu
@@ -79,6 +83,9 @@ namespace vmpi{
 	extern std::vector<double> ComputeTimeArray;
 	extern std::vector<double> WaitTimeArray;
 	extern bool DetailedMPITiming; /// flag to control logging of compute and wait times
+	extern std::vector<double> PeerWaitTimeArray; /// Total time spent waiting for each processor
+	extern std::vector<double> PeerSendBytesArray; /// Total bytes of halo data sent to each processor
+	extern std::vector<double> PeerRecvBytesArray; /// Total bytes of halo data received from each processor
 
 	extern std::vector<int> send_atom_translation_array;
 	extern std::vector<int> send_start_index_array;
@@ -90,9 +97,12 @@ namespace vmpi{
 	extern std::vector<int> recv_num_array;
 	extern std::vector<double> recv_spin_data_array;
 
+	extern int num_core_atom_chunks; /// Number of chunks of core atoms with halo swap progressed between chunks
+
 	#ifdef MPICF
-		extern std::vector<MPI_Request> requests;
+		extern std::vector<MPI_Request> requests; /// persistent requests for halo swap
 		extern std::vector<MPI_Status> stati;
+		extern std::vector<int> request_peer_array; /// processor for each request
 	#endif
 
 	//functions declarations
@@ -100,6 +110,7 @@ namespace vmpi{
 	extern int hosts();
 	extern int finalise();
    extern void geometric_decomposition(int, double []);
+   extern bool balance_decomposition(std::vector<cs::catom_t>& catom_array, double system_size[3]);
 	extern int crystal_xyz(std::vector<cs::catom_t> &);
 	extern int copy_halo_atoms(std::vector<cs::catom_t> &);
 	extern int set_replicated_data(std::vector<cs::catom_t> &);
@@ -108,7 +119,10 @@ namespace vmpi{
 	extern double SwapTimer(double, double&);
 
    // functions for sending/receiving halo data
+   extern void init_halo_swap_requests();
+   extern void free_halo_swap_requests();
    extern void mpi_init_halo_swap();
+   extern void mpi_progress_halo_swap();
    extern void mpi_complete_halo_swap();
 
 	// wrapper functions avoiding MPI library
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef VOMP_H_
+#define VOMP_H_
+
+// C++ standard library headers
+#include <string>
+
+// Vampire headers
+#include "vomp.hpp"
+
+//--------------------------------------------------------------------------------
+// Namespace for variables and functions for shared memory (OpenMP) module
+//--------------------------------------------------------------------------------
+namespace vomp{
+
+   //-----------------------------------------------------------------------------
+   // Function to initialise openmp module
+   //-----------------------------------------------------------------------------
+   void initialize();
+
+   //-----------------------------------------------------------------------------
+   // Function to get number of threads used for shared memory parallel loops
+   //-----------------------------------------------------------------------------
+   int get_num_threads();
+
+   //-----------------------------------------------------------------------------
+   // Function to get thread id of calling thread (0 outside parallel regions)
+   //-----------------------------------------------------------------------------
+   int get_thread_id();
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for openmp module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
+
+} // end of vomp namespace
+
+#endif //VOMP_H_
@@ -11,6 +11,8 @@
 
 // System headers
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 
 // Program headers
 
@@ -46,6 +48,31 @@ namespace vutil{
       }
    };
 
+   //---------------------------------------------------------------------
+   // Function to calculate 64 bit FNV-1a checksum of data for integrity
+   // checks of output files, processing 8 bytes at a time for speed. The
+   // checksum of data split into parts which are multiples of 8 bytes (except
+   // the last) is calculated by passing the checksum of the previous part as
+   // the initial value.
+   //---------------------------------------------------------------------
+   inline uint64_t checksum(const char* data, const uint64_t size, uint64_t hash = 14695981039346656037ULL){
+
+      const uint64_t prime = 1099511628211ULL;
+      const uint64_t num_words = size/8;
+
+      for(uint64_t i = 0; i < num_words; i++){
+         uint64_t word;
+         std::memcpy(&word, data + 8*i, 8);
+         hash = (hash ^ word)*prime;
+      }
+      for(uint64_t i = 8*num_words; i < size; i++){
+         hash = (hash ^ uint64_t((unsigned char)data[i]))*prime;
+      }
+
+      return hash;
+
+   }
+
 } // end of namespace vutil
 
 #endif //VUTIL_H_
@@ -48,6 +48,7 @@ namespace anisotropy{
          const double scale = 0.5*4.0;
 
          // Loop over all atoms between start and end index
+         #pragma omp parallel for schedule(static)
          for(int atom = start_index; atom < end_index; atom++){
 
             // get atom material
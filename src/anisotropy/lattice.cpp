@@ -56,6 +56,7 @@ namespace anisotropy{
          }
 
          // Now calculate fields
+         #pragma omp parallel for schedule(static)
          for(int atom = start_index; atom < end_index; atom++){
 
             // get material for atom
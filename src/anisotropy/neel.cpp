@@ -79,6 +79,7 @@ namespace anisotropy{
          if(!internal::enable_neel_anisotropy) return;
 
          // loop over all atoms
+         #pragma omp parallel for schedule(static)
          for(int atom = start_index; atom<end_index; atom++){
 
             const double sx = spin_array_x[atom]; // store spin direction in temporary variables
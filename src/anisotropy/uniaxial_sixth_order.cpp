@@ -69,6 +69,7 @@ namespace anisotropy{
          const double scale = oneo16 * 2.0/3.0; // Factor to rescale anisotropies to usual scale
 
          // Loop over all atoms between start and end index
+         #pragma omp parallel for schedule(static)
          for(int atom = start_index; atom < end_index; atom++){
 
             // get atom material
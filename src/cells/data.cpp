@@ -31,6 +31,9 @@ namespace cells{
    int num_atoms_in_unit_cell=0;
    int num_cells; /// number of macro-cells
    int num_local_cells=0; /// number of macro-cells
+   int num_cells_x=0; /// number of macro-cells in x,y,z
+   int num_cells_y=0;
+   int num_cells_z=0;
    double macro_cell_size = 10.0; /// macro-cells size (A)
 
    std::vector <int> local_cell_array;
@@ -75,6 +78,15 @@ namespace cells{
       std::vector<double> spin_array_z;
       std::vector<int> atom_type_array;
       int num_atoms;
+
+      mag_reduction_t mag_reduction = automatic;
+      bool sparse_mag_reduction = false;
+      std::vector<int> mag_cell_array;
+      std::vector<int> global_mag_cell_array;
+      std::vector<int> mag_counts;
+      std::vector<int> mag_displacements;
+      std::vector<double> mag_buffer;
+      std::vector<double> mag_recv_buffer;
    } // end of internal namespace
 
 } // end of cells namespace
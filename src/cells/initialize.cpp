@@ -83,6 +83,9 @@ namespace cells{
       unsigned int dz =  static_cast<unsigned int>(ceil((system_dimensions_z+0.01)/cells::macro_cell_size));
 
       cells::num_cells = dx*dy*dz;
+      cells::num_cells_x = dx;
+      cells::num_cells_y = dy;
+      cells::num_cells_z = dz;
       cells::internal::cell_position_array.resize(3*cells::num_cells);
 
       //std::cout << " variable cells::num_cells = " << cells::num_cells << std::endl;
@@ -323,6 +326,9 @@ namespace cells{
 
       zlog << zTs() << "Number of local macrocells on rank " << vmpi::my_rank << ": " << cells::num_local_cells << std::endl;
 
+      // Determine how cell magnetisation is reduced between processors
+      cells::internal::initialize_mag_reduction(num_local_atoms);
+
       // Set initialised flag
       cells::internal::initialised=true;
 
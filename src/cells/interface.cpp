@@ -45,6 +45,34 @@ namespace cells{
          cells::macro_cell_size = csize;
          return true;
       }
+      //--------------------------------------------------------------------
+      test="magnetisation-reduction";
+      if(word==test){
+         test="auto";
+         if(value == test){
+            cells::internal::mag_reduction = cells::internal::automatic;
+            return true;
+         }
+         test="dense";
+         if(value == test){
+            cells::internal::mag_reduction = cells::internal::dense;
+            return true;
+         }
+         test="sparse";
+         if(value == test){
+            cells::internal::mag_reduction = cells::internal::sparse;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"auto\"" << std::endl;
+            std::cerr << "\t\"dense\"" << std::endl;
+            std::cerr << "\t\"sparse\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
 
       //--------------------------------------------------------------------
       // Keyword not found
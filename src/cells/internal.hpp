@@ -38,6 +38,7 @@ namespace cells{
       //-------------------------------------------------------------------------
       // Internal data type definitions
       //-------------------------------------------------------------------------
+      enum mag_reduction_t { automatic = 0, dense = 1, sparse = 2 };
 
       //-------------------------------------------------------------------------
       // Internal shared variables
@@ -56,9 +57,20 @@ namespace cells{
       extern int num_atoms;
       //extern int num_local_atoms;
 
+      // variables for parallel reduction of cell magnetisation
+      extern mag_reduction_t mag_reduction; /// requested reduction method
+      extern bool sparse_mag_reduction; /// flag set if only local cells are exchanged
+      extern std::vector<int> mag_cell_array; /// list of cells with local magnetic atoms
+      extern std::vector<int> global_mag_cell_array; /// list of cells with magnetic atoms on all processors
+      extern std::vector<int> mag_counts; /// number of values sent by each processor
+      extern std::vector<int> mag_displacements; /// offset of values sent by each processor
+      extern std::vector<double> mag_buffer; /// packed buffer of cell magnetisation
+      extern std::vector<double> mag_recv_buffer; /// packed buffer of cell magnetisation from all processors
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
+      void initialize_mag_reduction(const int num_local_atoms);
 
    } // end of internal namespace
 
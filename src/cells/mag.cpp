@@ -22,6 +22,7 @@
 #include "create.hpp"
 
 #include "atoms.hpp"
+#include "vio.hpp"
 
 // cells module internal headers
 #include "internal.hpp"
@@ -66,13 +67,151 @@ namespace cells{
       }
 
       #ifdef MPICF
-      // Reduce magnetisation on all nodes
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_x[0],   cells::mag_array_x.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_y[0],   cells::mag_array_y.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_z[0],   cells::mag_array_z.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+      if(cells::internal::sparse_mag_reduction){
+
+         // pack magnetisation of cells with local magnetic atoms
+         const int num_mag_cells = cells::internal::mag_cell_array.size();
+         for(int lc=0; lc<num_mag_cells; ++lc){
+            const int cell = cells::internal::mag_cell_array[lc];
+            cells::internal::mag_buffer[3*lc+0] = cells::mag_array_x[cell];
+            cells::internal::mag_buffer[3*lc+1] = cells::mag_array_y[cell];
+            cells::internal::mag_buffer[3*lc+2] = cells::mag_array_z[cell];
+         }
+
+         // Gather magnetisation of cells from all nodes
+         MPI_Allgatherv(&cells::internal::mag_buffer[0], 3*num_mag_cells, MPI_DOUBLE,
+                        &cells::internal::mag_recv_buffer[0], &cells::internal::mag_counts[0],
+                        &cells::internal::mag_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+         // Sum contributions in processor order (cells can be shared by several processors)
+         for(int i=0; i<cells::num_cells; ++i) {
+            cells::mag_array_x[i] = 0.0;
+            cells::mag_array_y[i] = 0.0;
+            cells::mag_array_z[i] = 0.0;
+         }
+
+         const int num_global_mag_cells = cells::internal::global_mag_cell_array.size()-1;
+         for(int gc=0; gc<num_global_mag_cells; ++gc){
+            const int cell = cells::internal::global_mag_cell_array[gc];
+            cells::mag_array_x[cell] += cells::internal::mag_recv_buffer[3*gc+0];
+            cells::mag_array_y[cell] += cells::internal::mag_recv_buffer[3*gc+1];
+            cells::mag_array_z[cell] += cells::internal::mag_recv_buffer[3*gc+2];
+         }
+
+      }
+      else{
+
+         // pack x,y,z magnetisation into single buffer
+         const int num_cells = cells::num_cells;
+         cells::internal::mag_buffer.resize(3*num_cells);
+         std::copy(cells::mag_array_x.begin(), cells::mag_array_x.begin()+num_cells, cells::internal::mag_buffer.begin());
+         std::copy(cells::mag_array_y.begin(), cells::mag_array_y.begin()+num_cells, cells::internal::mag_buffer.begin()+num_cells);
+         std::copy(cells::mag_array_z.begin(), cells::mag_array_z.begin()+num_cells, cells::internal::mag_buffer.begin()+2*num_cells);
+
+         // Reduce magnetisation on all nodes
+         MPI_Allreduce(MPI_IN_PLACE, &cells::internal::mag_buffer[0], 3*num_cells, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+         std::copy(cells::internal::mag_buffer.begin(),             cells::internal::mag_buffer.begin()+num_cells,   cells::mag_array_x.begin());
+         std::copy(cells::internal::mag_buffer.begin()+num_cells,   cells::internal::mag_buffer.begin()+2*num_cells, cells::mag_array_y.begin());
+         std::copy(cells::internal::mag_buffer.begin()+2*num_cells, cells::internal::mag_buffer.end(),               cells::mag_array_z.begin());
+
+      }
       #endif
 
       return EXIT_SUCCESS;
 
    }
+
+   namespace internal{
+
+      //--------------------------------------------------------------------------
+      // Function to choose how cell magnetisation is reduced between processors.
+      //
+      // The dense method sums the full x,y,z arrays on all processors in a
+      // single reduction. The sparse method gathers only the cells containing
+      // local magnetic atoms from each processor, which moves less data when
+      // most cells are empty or owned by a single processor. In automatic mode
+      // the method with the smaller estimated data volume is used.
+      //--------------------------------------------------------------------------
+      void initialize_mag_reduction(const int num_local_atoms){
+
+         #ifdef MPICF
+
+            // find cells containing local magnetic atoms
+            std::vector<int> has_mag_atoms(cells::num_cells, 0);
+            for(int atom=0; atom<num_local_atoms; ++atom){
+               const int type = cells::internal::atom_type_array[atom];
+               if(mp::material[type].non_magnetic==0) has_mag_atoms[cells::atom_cell_id_array[atom]] = 1;
+            }
+
+            cells::internal::mag_cell_array.clear();
+            for(int cell=0; cell<cells::num_cells; ++cell){
+               if(has_mag_atoms[cell]) cells::internal::mag_cell_array.push_back(cell);
+            }
+
+            // collect number of cells sent by each processor
+            const int num_mag_cells = cells::internal::mag_cell_array.size();
+            std::vector<int> cell_counts(vmpi::num_processors, 0);
+            std::vector<int> cell_displacements(vmpi::num_processors, 0);
+            MPI_Allgather(&num_mag_cells, 1, MPI_INT, &cell_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+            int num_global_mag_cells = 0;
+            for(int p=0; p<vmpi::num_processors; ++p){
+               cell_displacements[p] = num_global_mag_cells;
+               num_global_mag_cells += cell_counts[p];
+            }
+
+            // estimated bytes received per processor and update for ring algorithms:
+            // allreduce = reduce-scatter + allgather of 3*num_cells values,
+            // allgatherv = 3 values for each cell sent by other processors
+            const double np = double(vmpi::num_processors);
+            const double dense_bytes  = 2.0*(np-1.0)/np*3.0*double(cells::num_cells)*sizeof(double);
+            const double sparse_bytes = (np-1.0)/np*3.0*double(num_global_mag_cells)*sizeof(double);
+
+            if(cells::internal::mag_reduction == cells::internal::automatic) cells::internal::sparse_mag_reduction = sparse_bytes < dense_bytes;
+            else cells::internal::sparse_mag_reduction = (cells::internal::mag_reduction == cells::internal::sparse);
+
+            zlog << zTs() << "Cell magnetisation reduction: " << num_global_mag_cells << " cell contributions from all processors for " << cells::num_cells << " cells" << std::endl;
+            zlog << zTs() << "Cell magnetisation reduction: estimated bytes per processor per update " << dense_bytes << " (dense allreduce), " << sparse_bytes << " (sparse allgather)" << std::endl;
+
+            if(cells::internal::sparse_mag_reduction){
+
+               // gather global list of cells sent by each processor (padded to avoid empty buffers)
+               std::vector<int> send_cell_array(cells::internal::mag_cell_array);
+               send_cell_array.push_back(0);
+               cells::internal::global_mag_cell_array.resize(num_global_mag_cells+1);
+               MPI_Allgatherv(&send_cell_array[0], num_mag_cells, MPI_INT,
+                              &cells::internal::global_mag_cell_array[0], &cell_counts[0],
+                              &cell_displacements[0], MPI_INT, MPI_COMM_WORLD);
+
+               cells::internal::mag_counts.resize(vmpi::num_processors);
+               cells::internal::mag_displacements.resize(vmpi::num_processors);
+               for(int p=0; p<vmpi::num_processors; ++p){
+                  cells::internal::mag_counts[p] = 3*cell_counts[p];
+                  cells::internal::mag_displacements[p] = 3*cell_displacements[p];
+               }
+
+               cells::internal::mag_buffer.resize(3*num_mag_cells+1);
+               cells::internal::mag_recv_buffer.resize(3*num_global_mag_cells+1);
+
+               zlog << zTs() << "Cell magnetisation reduction: using sparse allgather of local cells" << std::endl;
+
+            }
+            else{
+               zlog << zTs() << "Cell magnetisation reduction: using dense allreduce of all cells" << std::endl;
+            }
+
+         #else
+
+            // no reduction is needed for a single processor
+            (void)num_local_atoms;
+
+         #endif
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
 } // end of cells namespace
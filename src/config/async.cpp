@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+// Vampire headers
+#include "config.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// config module headers
+#include "internal.hpp"
+
+namespace config{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function run by background thread to write spin data to disk
+//------------------------------------------------------------------------------
+void async_write_data(std::string filename){
+   config::internal::async_io_time = write_data(filename, config::internal::async_buffer, config::internal::async_snapshot);
+   return;
+}
+
+//------------------------------------------------------------------------------
+// Function called at program exit to finish writing spin data in the
+// background, since destroying a running thread terminates the program
+//------------------------------------------------------------------------------
+void join_async_writer(){
+   std::thread& writer = config::internal::async_writer;
+   if(!writer.joinable()) return;
+   if(writer.get_id() == std::this_thread::get_id()) writer.detach();
+   else writer.join();
+   return;
+}
+
+//------------------------------------------------------------------------------
+// Function to start writing spin data to disk in the background.
+//
+// Spin data are double buffered: the new snapshot has already been copied to
+// local_buffer (or gathered to collated_buffer) while the previous file may
+// still have been in flight. After waiting for the previous write to finish
+// the buffers are swapped and the snapshot is written from async_buffer,
+// either by a background thread or a non-blocking collective MPI-IO write,
+// while the simulation continues.
+//------------------------------------------------------------------------------
+void start_async_output(std::string filename){
+
+   // wait for previous file to be written
+   wait_for_async_output();
+
+   // ensure background writer is joined if the program exits early
+   static bool exit_hook_registered = false;
+   if(!exit_hook_registered) exit_hook_registered = (std::atexit(join_async_writer) == 0);
+
+   config::internal::async_file_counter = sim::output_atoms_file_counter;
+   config::internal::async_snapshot = config::internal::current_snapshot;
+
+   #ifdef MPICF
+
+   switch(config::internal::mode){
+
+      case config::internal::mpi_io:{
+
+         // swap buffers and keep the same size for the next snapshot
+         config::internal::async_buffer.resize(config::internal::local_buffer.size());
+         config::internal::async_buffer.swap(config::internal::local_buffer);
+
+         char *cfilename = (char*)filename.c_str();
+         MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &async_fh);
+
+         async_timer.start();
+
+         // prepare data (encoded data are kept in encoded_buffer until written)
+         void* data;
+         int data_size;
+         MPI_Datatype data_type;
+         MPI_Offset data_offset = prepare_mpi_io_output(async_fh, config::internal::async_buffer, data, data_size, data_type);
+
+         // non-blocking collective writes require MPI 3.1
+         #if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+            MPI_File_iwrite_at_all(async_fh, data_offset, data, data_size, data_type, &async_request);
+         #else
+            MPI_Status status;
+            MPI_File_write_at_all(async_fh, data_offset, data, data_size, data_type, &status);
+            async_request = MPI_REQUEST_NULL;
+         #endif
+
+         break;
+      }
+
+      case config::internal::fpprocess:
+         config::internal::async_buffer.resize(config::internal::local_buffer.size());
+         config::internal::async_buffer.swap(config::internal::local_buffer);
+         config::internal::async_writer = std::thread(async_write_data, filename);
+         break;
+
+      case config::internal::fpnode:
+         // data have already been gathered to collated buffer
+         if(config::internal::io_group_master){
+            config::internal::async_buffer.resize(config::internal::collated_buffer.size());
+            config::internal::async_buffer.swap(config::internal::collated_buffer);
+            config::internal::async_writer = std::thread(async_write_data, filename);
+         }
+         break;
+
+      default:
+         break;
+
+   }
+
+   #else
+
+      config::internal::async_buffer.resize(config::internal::local_buffer.size());
+      config::internal::async_buffer.swap(config::internal::local_buffer);
+      config::internal::async_writer = std::thread(async_write_data, filename);
+
+   #endif
+
+   config::internal::async_in_flight = true;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to wait for background write of spin data to complete. Blocks only
+// if the previous file is still being written.
+//------------------------------------------------------------------------------
+void wait_for_async_output(){
+
+   if(!config::internal::async_in_flight) return;
+
+   vutil::vtimer_t wait_timer;
+   wait_timer.start();
+
+   double io_time = 0.0;
+
+   #ifdef MPICF
+
+   switch(config::internal::mode){
+
+      case config::internal::mpi_io:
+         MPI_Wait(&async_request, MPI_STATUS_IGNORE);
+         // complete record in container
+         if(config::internal::container_output) finish_container_record(async_fh, config::internal::async_snapshot);
+         MPI_File_close(&async_fh);
+         async_timer.stop();
+         io_time = async_timer.elapsed_time();
+         break;
+
+      case config::internal::fpprocess:
+         config::internal::async_writer.join();
+         io_time = config::internal::async_io_time;
+         break;
+
+      case config::internal::fpnode:{
+         if(config::internal::io_group_master){
+            config::internal::async_writer.join();
+            io_time = config::internal::async_io_time;
+         }
+         // calculate actual bandwidth on root process
+         double max_io_time = 0.0;
+         MPI_Reduce(&io_time, &max_io_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+         io_time = max_io_time;
+         break;
+      }
+
+      default:
+         break;
+
+   }
+
+   #else
+
+      config::internal::async_writer.join();
+      io_time = config::internal::async_io_time;
+
+   #endif
+
+   wait_timer.stop();
+
+   const double wait_time = wait_timer.elapsed_time();
+
+   config::internal::async_total_io_time += io_time;
+   config::internal::async_total_wait_time += wait_time;
+   config::internal::async_in_flight = false;
+
+   if(io_time < 1.0e-12) io_time = 1.0e-12;
+
+   // determine size of compact spin data
+   if(config::internal::spin_encoding != config::internal::full) update_encoded_data_size();
+
+   // Output bandwidth to log file
+   zlog << zTs() << "Configuration file " << std::setfill('0') << std::setw(8) << config::internal::async_file_counter << " written asynchronously "
+        << config::internal::io_data_size/io_time << " GB/s in " << io_time << " s [ waited " << wait_time << " s]";
+   if(config::internal::spin_encoding != config::internal::full){
+      zlog << " " << 1.0e9*config::internal::io_data_size/double(config::internal::total_output_atoms) << " bytes/atom";
+   }
+   zlog << std::endl;
+
+   return;
+
+}
+
+} // end of internal namespace
+
+//------------------------------------------------------------------------------
+// Function to complete any outstanding data output at the end of a simulation
+//------------------------------------------------------------------------------
+void finalize(){
+
+   if(!config::internal::asynchronous_output || !config::internal::initialised) return;
+
+   // wait for last file to be written
+   config::internal::wait_for_async_output();
+
+   // fraction of write time hidden behind simulation
+   const double io_time = config::internal::async_total_io_time;
+   const double wait_time = config::internal::async_total_wait_time;
+   const double efficiency = io_time > 0.0 ? 100.0*(1.0 - std::min(wait_time, io_time)/io_time) : 100.0;
+
+   zlog << zTs() << "Asynchronous configuration output: " << io_time << " s writing, " << wait_time << " s waiting, overlap efficiency "
+        << efficiency << " %" << std::endl;
+
+   return;
+
+}
+
+} // end of config namespace
@@ -52,7 +52,16 @@ void atoms(){
    // calculate real time
    const double real_time = double(sim::time) * mp::dt_SI;
 
-   if(config::internal::mode != legacy && vmpi::my_rank == 0){
+   // store meta data for container index
+   config::internal::current_snapshot.id = sim::output_atoms_file_counter;
+   config::internal::current_snapshot.time = real_time;
+   config::internal::current_snapshot.temperature = sim::temperature;
+   for(int i = 0; i < 3; i++){
+      config::internal::current_snapshot.field[i] = sim::H_vec[i]*sim::H_applied;
+      config::internal::current_snapshot.magnetization[i] = magnetisation[i];
+   }
+
+   if(config::internal::mode != legacy && vmpi::my_rank == 0 && !config::internal::container_output){
       write_meta(real_time, sim::temperature, sim::H_vec[0], sim::H_vec[1], sim::H_vec[2], sim::H_applied, magnetisation[0], magnetisation[1], magnetisation[2]);
    }
 
@@ -77,6 +86,36 @@ void atoms(){
    // convert stringstream to string
    std::string filename = file_sstr.str();
 
+   // all snapshots are appended to single file in container mode
+   if(config::internal::container_output) filename = config::internal::container_filename;
+
+   //-----------------------------------------------------
+   // Asynchronous output (legacy output is always synchronous)
+   //-----------------------------------------------------
+   if(config::internal::asynchronous_output && config::internal::mode != config::internal::legacy){
+
+      // Gather data from all processors in io group
+      #ifdef MPICF
+         if(config::internal::mode == config::internal::fpnode){
+            MPI_Gatherv(&local_buffer[0], local_buffer.size(), MPI_DOUBLE, &collated_buffer[0], &io_group_recv_counts[0], &io_group_displacements[0], MPI_DOUBLE, io_group_master_id, io_comm);
+         }
+      #endif
+
+      // write data in background
+      start_async_output(filename);
+
+      // stop total timer
+      total_timer.stop();
+
+      zlog << zTs() << "Outputting configuration file " << std::setfill('0') << std::setw(8) << sim::output_atoms_file_counter << " to disk asynchronously [ " << total_timer.elapsed_time() << " s]" << std::endl;
+
+      // increment file counter
+      sim::output_atoms_file_counter++;
+
+      return;
+
+   }
+
    // Output informative message to log file on root process
    zlog << zTs() << "Outputting configuration file " << std::setfill('0') << std::setw(8) << sim::output_atoms_file_counter << " to disk " << std::flush;
 
@@ -104,18 +143,21 @@ void atoms(){
          char *cfilename = (char*)filename.c_str();
          // Open file on all processors
          MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
-         // write number of atoms on root process
-         if(vmpi::my_rank == 0) MPI_File_write(fh, &total_output_atoms, 1, MPI_UINT64_T, &status);
-
-         // Calculate local byte offset since MPI-IO is simple and doesn't update the file handle pointer after I/O
-         MPI_Offset data_offset = config::internal::buffer_offset + sizeof(uint64_t);
-
          timer.start(); // start timer
 
+         // prepare data and write headers
+         void* data;
+         int data_size;
+         MPI_Datatype data_type;
+         MPI_Offset data_offset = prepare_mpi_io_output(fh, config::internal::local_buffer, data, data_size, data_type);
+
          // Write data to disk
-         MPI_File_write_at_all(fh, data_offset, &config::internal::local_buffer[0], config::internal::local_buffer.size(), MPI_DOUBLE, &status);
+         MPI_File_write_at_all(fh, data_offset, data, data_size, data_type, &status);
          //MPI_File_write_ordered(fh, &config::internal::local_buffer[0], config::internal::local_buffer.size(), MPI_DOUBLE, &status);
 
+         // complete record in container
+         if(config::internal::container_output) finish_container_record(fh, config::internal::current_snapshot);
+
          timer.stop(); // Stop timer
 
          // Close file
@@ -127,14 +169,14 @@ void atoms(){
       }
 
       case config::internal::fpprocess:
-         io_time = write_data(filename, config::internal::local_buffer);
+         io_time = write_data(filename, config::internal::local_buffer, config::internal::current_snapshot);
          break;
 
       case config::internal::fpnode:
          // Gather data from all processors in io group
          MPI_Gatherv(&local_buffer[0], local_buffer.size(), MPI_DOUBLE, &collated_buffer[0], &io_group_recv_counts[0], &io_group_displacements[0], MPI_DOUBLE, io_group_master_id, io_comm);
          // output data on master io processes
-         if(config::internal::io_group_master) io_time = write_data(filename, config::internal::collated_buffer);
+         if(config::internal::io_group_master) io_time = write_data(filename, config::internal::collated_buffer, config::internal::current_snapshot);
          double max_io_time = 0.0;
          // calculate actual bandwidth on root process
          MPI_Reduce(&io_time, &max_io_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
@@ -150,14 +192,21 @@ void atoms(){
       // check for legacy output
       if(config::internal::mode == config::internal::legacy) io_time = config::internal::legacy_atoms();
       // otherwise use new one by default
-      else io_time = write_data(filename, config::internal::local_buffer);
+      else io_time = write_data(filename, config::internal::local_buffer, config::internal::current_snapshot);
    #endif
 
+   // determine size of compact spin data
+   if(config::internal::spin_encoding != config::internal::full) update_encoded_data_size();
+
    // stop total timer
    total_timer.stop();
 
    // Output bandwidth to log file
-   zlog << config::internal::io_data_size/io_time << " GB/s in " << io_time << " s [ " << total_timer.elapsed_time() << " s]" << std::endl;
+   zlog << config::internal::io_data_size/io_time << " GB/s in " << io_time << " s [ " << total_timer.elapsed_time() << " s]";
+   if(config::internal::spin_encoding != config::internal::full){
+      zlog << " " << 1.0e9*config::internal::io_data_size/double(config::internal::total_output_atoms) << " bytes/atom";
+   }
+   zlog << std::endl;
 
    // increment file counter
    sim::output_atoms_file_counter++;
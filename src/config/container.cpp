@@ -0,0 +1,568 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// Vampire headers
+#include "config.hpp"
+#include "errors.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// config module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Spin data container format
+//
+// All spin snapshots of an io group are appended to a single file with an
+// index at the end for random access. All integers are little-endian.
+//
+//    file header (32 bytes)
+//       bytes  0 -  7   "VSPINC01" identifier
+//       bytes  8 - 15   number of atoms in file
+//       bytes 16 - 19   io group id
+//       bytes 20 - 23   number of io groups
+//       bytes 24 - 31   reserved (0)
+//
+//    snapshot records (one per snapshot)
+//       bytes  0 -   7  "VSNAPREC" identifier
+//       bytes  8 -  15  snapshot id (file counter)
+//       bytes 16 -  23  size of spin data (bytes)
+//       bytes 24 -  31  checksum of spin data (0 if not calculated)
+//       bytes 32 -  95  time, temperature, field (x,y,z) and magnetization
+//                       (x,y,z) as IEEE doubles
+//       bytes 96 - 103  checksum of bytes 0-95 of record header
+//       bytes 104 - 111 reserved (0)
+//       spin data in the same format as a spins-*.data binary file
+//
+//    index (88 bytes per snapshot)
+//       record offset, record size, snapshot id, time, temperature, field
+//       and magnetization
+//
+//    trailer (32 bytes, at end of file)
+//       bytes  0 -  7   "VSPINIDX" identifier
+//       bytes  8 - 15   number of snapshots in index
+//       bytes 16 - 23   offset of index
+//       bytes 24 - 31   checksum of index
+//
+// Snapshot n is found in O(1) from the trailer at the end of the file. New
+// records overwrite the old index, with the spin data written before the
+// record header and the index written last, so that a record is only valid
+// once completely written. If the program stops while appending, the index
+// is rebuilt from the valid records by scanning the file (and by vdc).
+//------------------------------------------------------------------------------
+
+namespace config{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to pack and unpack double as little-endian integer
+//------------------------------------------------------------------------------
+inline void pack_double(char* buffer, const double value){
+   uint64_t bits = 0;
+   std::memcpy(&bits, &value, sizeof(double));
+   pack_uint(buffer, bits, 8);
+}
+
+inline double unpack_double(const char* buffer){
+   const uint64_t bits = unpack_uint(buffer, 8);
+   double value = 0.0;
+   std::memcpy(&value, &bits, sizeof(double));
+   return value;
+}
+
+//------------------------------------------------------------------------------
+// Function to pack snapshot meta data (time, temperature, field, magnetization)
+//------------------------------------------------------------------------------
+void pack_snapshot_data(const snapshot_t& snapshot, char* buffer){
+   pack_double(buffer +  0, snapshot.time);
+   pack_double(buffer +  8, snapshot.temperature);
+   for(int i = 0; i < 3; i++) pack_double(buffer + 16 + 8*i, snapshot.field[i]);
+   for(int i = 0; i < 3; i++) pack_double(buffer + 40 + 8*i, snapshot.magnetization[i]);
+}
+
+void unpack_snapshot_data(const char* buffer, snapshot_t& snapshot){
+   snapshot.time        = unpack_double(buffer + 0);
+   snapshot.temperature = unpack_double(buffer + 8);
+   for(int i = 0; i < 3; i++) snapshot.field[i] = unpack_double(buffer + 16 + 8*i);
+   for(int i = 0; i < 3; i++) snapshot.magnetization[i] = unpack_double(buffer + 40 + 8*i);
+}
+
+//------------------------------------------------------------------------------
+// Function to pack record header for snapshot
+//------------------------------------------------------------------------------
+void pack_record_header(const snapshot_t& snapshot, const uint64_t payload_bytes, const uint64_t payload_checksum, char* header){
+
+   const char identifier[8] = {'V','S','N','A','P','R','E','C'};
+   std::memcpy(header, identifier, 8);
+
+   pack_uint(header +  8, snapshot.id, 8);
+   pack_uint(header + 16, payload_bytes, 8);
+   pack_uint(header + 24, payload_checksum, 8);
+   pack_snapshot_data(snapshot, header + 32);
+   pack_uint(header + 96, vutil::checksum(header, 96), 8);
+   pack_uint(header + 104, 0, 8);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to report failed write to container file and exit
+//------------------------------------------------------------------------------
+void container_write_error(){
+   terminaltextcolor(RED);
+   std::cerr << "Error: Unable to write to spin data container " << container_filename << ". Exiting." << std::endl;
+   terminaltextcolor(WHITE);
+   zlog << zTs() << "Error: Unable to write to spin data container " << container_filename << ". Exiting." << std::endl;
+   err::vexit();
+}
+
+//------------------------------------------------------------------------------
+// Function to pack index and trailer to be written at end of container. If
+// the file was previously longer (after restarting from an earlier snapshot)
+// the index is padded so that the trailer remains at the end of the file.
+//------------------------------------------------------------------------------
+void pack_container_index(std::vector<char>& index){
+
+   const uint64_t index_size = index_entry_size*container_index.size();
+
+   // pad index to previous end of file
+   uint64_t padding = 0;
+   if(container_end + index_size + trailer_size < container_file_size) padding = container_file_size - (container_end + index_size + trailer_size);
+
+   index.assign(index_size + padding + trailer_size, 0);
+
+   for(uint64_t i = 0; i < container_index.size(); i++){
+      char* entry = &index[index_entry_size*i];
+      pack_uint(entry +  0, container_index[i].offset, 8);
+      pack_uint(entry +  8, container_index[i].size, 8);
+      pack_uint(entry + 16, container_index[i].id, 8);
+      pack_snapshot_data(container_index[i], entry + 24);
+   }
+
+   char* trailer = &index[index_size + padding];
+   const char identifier[8] = {'V','S','P','I','N','I','D','X'};
+   std::memcpy(trailer, identifier, 8);
+   pack_uint(trailer +  8, container_index.size(), 8);
+   pack_uint(trailer + 16, container_end, 8);
+   pack_uint(trailer + 24, vutil::checksum(&index[0], index_size), 8);
+
+   container_file_size = container_end + index.size();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to write index and trailer at end of container
+//------------------------------------------------------------------------------
+void write_container_index(std::ostream& file){
+
+   std::vector<char> index;
+   pack_container_index(index);
+
+   file.seekp(container_end);
+   file.write(&index[0], index.size());
+   file.flush();
+
+   if(!file.good()) container_write_error();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read index of container from trailer at end of file. Returns
+// false if the index is missing or invalid.
+//------------------------------------------------------------------------------
+bool read_container_index(std::istream& file, const uint64_t file_size){
+
+   if(file_size < uint64_t(container_header_size + trailer_size)) return false;
+
+   char trailer[trailer_size];
+   file.seekg(file_size - trailer_size);
+   file.read(trailer, trailer_size);
+   if(!file.good() || std::memcmp(trailer, "VSPINIDX", 8) != 0) return false;
+
+   const uint64_t num_snapshots = unpack_uint(trailer +  8, 8);
+   const uint64_t index_offset  = unpack_uint(trailer + 16, 8);
+   const uint64_t checksum      = unpack_uint(trailer + 24, 8);
+
+   if(index_offset < uint64_t(container_header_size) || index_offset + index_entry_size*num_snapshots + trailer_size > file_size) return false;
+
+   std::vector<char> index(index_entry_size*num_snapshots + 1);
+   file.seekg(index_offset);
+   file.read(&index[0], index_entry_size*num_snapshots);
+   if(!file.good() || vutil::checksum(&index[0], index_entry_size*num_snapshots) != checksum) return false;
+
+   container_index.resize(num_snapshots);
+   for(uint64_t i = 0; i < num_snapshots; i++){
+      const char* entry = &index[index_entry_size*i];
+      container_index[i].offset = unpack_uint(entry +  0, 8);
+      container_index[i].size   = unpack_uint(entry +  8, 8);
+      container_index[i].id     = unpack_uint(entry + 16, 8);
+      unpack_snapshot_data(entry + 24, container_index[i]);
+   }
+
+   container_end = index_offset;
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to rebuild index of container by scanning records from the start
+// of the file, stopping at the first incomplete or invalid record
+//------------------------------------------------------------------------------
+void recover_container_index(std::istream& file, const uint64_t file_size){
+
+   container_index.clear();
+   container_end = container_header_size;
+
+   std::vector<char> payload;
+
+   while(container_end + record_header_size <= file_size){
+
+      char header[record_header_size];
+      file.seekg(container_end);
+      file.read(header, record_header_size);
+
+      if(!file.good() || std::memcmp(header, "VSNAPREC", 8) != 0) break;
+      if(vutil::checksum(header, 96) != unpack_uint(header + 96, 8)) break;
+
+      const uint64_t payload_bytes = unpack_uint(header + 16, 8);
+      const uint64_t checksum      = unpack_uint(header + 24, 8);
+
+      if(container_end + record_header_size + payload_bytes > file_size) break;
+
+      // verify spin data if checksum was calculated
+      if(checksum != 0){
+         payload.resize(payload_bytes + 1);
+         file.read(&payload[0], payload_bytes);
+         if(!file.good() || vutil::checksum(&payload[0], payload_bytes) != checksum) break;
+      }
+
+      snapshot_t snapshot;
+      snapshot.id = unpack_uint(header + 8, 8);
+      snapshot.offset = container_end;
+      snapshot.size = record_header_size + payload_bytes;
+      unpack_snapshot_data(header + 32, snapshot);
+
+      container_index.push_back(snapshot);
+      container_end += snapshot.size;
+
+   }
+
+   file.clear();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to open existing container when continuing from a checkpoint,
+// discarding snapshots at or after the current file counter. Returns false if
+// the file does not exist.
+//------------------------------------------------------------------------------
+bool open_existing_container(){
+
+   std::fstream file(container_filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+   if(!file.is_open()) return false;
+
+   file.seekg(0, std::ios::end);
+   container_file_size = file.tellg();
+
+   // check file header
+   char header[container_header_size];
+   file.seekg(0);
+   file.read(header, container_header_size);
+   if(!file.good() || std::memcmp(header, "VSPINC01", 8) != 0){
+      terminaltextcolor(RED);
+      std::cerr << "Error: File " << container_filename << " is not a valid spin data container. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: File " << container_filename << " is not a valid spin data container. Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // read index, rebuilding it if the last append did not complete
+   if(!read_container_index(file, container_file_size)){
+      zlog << zTs() << "Warning: Index of spin data container " << container_filename << " is invalid - recovering snapshots from file" << std::endl;
+      file.clear();
+      recover_container_index(file, container_file_size);
+   }
+
+   // seek to snapshot at current file counter (snapshot ids are consecutive)
+   const uint64_t counter = sim::output_atoms_file_counter;
+   if(container_index.size() > 0 && counter >= container_index[0].id){
+      const uint64_t num_snapshots = counter - container_index[0].id;
+      if(num_snapshots < container_index.size()){
+         container_end = container_index[num_snapshots].offset;
+         container_index.resize(num_snapshots);
+      }
+   }
+   else{
+      container_end = container_header_size;
+      container_index.clear();
+   }
+
+   zlog << zTs() << "Continuing spin data container " << container_filename << " with " << container_index.size() << " snapshots" << std::endl;
+
+   // rewrite index for remaining snapshots
+   write_container_index(file);
+   file.close();
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to create new container file
+//------------------------------------------------------------------------------
+void create_container(){
+
+   std::ofstream file(container_filename.c_str(), std::ios::binary | std::ios::trunc);
+
+   if(!file.is_open()){
+      terminaltextcolor(RED);
+      std::cerr << "Error: Unable to open spin data container " << container_filename << " for writing. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: Unable to open spin data container " << container_filename << " for writing. Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // number of atoms in container
+   uint64_t num_atoms = local_output_atom_list.size();
+   if(config::internal::mode == config::internal::mpi_io) num_atoms = total_output_atoms;
+   if(config::internal::mode == config::internal::fpnode) num_atoms = collated_buffer.size()/3;
+
+   char header[container_header_size];
+   std::memcpy(header, "VSPINC01", 8);
+   pack_uint(header +  8, num_atoms, 8);
+   pack_uint(header + 16, io_group_id, 4);
+   pack_uint(header + 20, num_io_groups, 4);
+   pack_uint(header + 24, 0, 8);
+   file.write(header, container_header_size);
+
+   container_index.clear();
+   container_end = container_header_size;
+   container_file_size = 0;
+
+   write_container_index(file);
+   file.close();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to write meta data file listing container files
+//------------------------------------------------------------------------------
+void write_container_meta(){
+
+   std::ofstream ofile("spins-container.meta");
+
+   // Get system date
+   time_t rawtime = time(NULL);
+   struct tm * timeinfo = localtime(&rawtime);
+
+   ofile << "#------------------------------------------------------"<< "\n";
+   ofile << "# Atomistic spin configuration container for vampire v5+"<< "\n";
+   ofile << "#------------------------------------------------------"<< "\n";
+   ofile << "# Date: "<< asctime(timeinfo);
+   ofile << "#------------------------------------------------------"<< "\n";
+   ofile << "Number of container files: " << config::internal::num_io_groups << "\n";
+
+   if(config::internal::num_io_groups == 1) ofile << "spins-container.data" << "\n";
+   else{
+      for(int fid = 0; fid < config::internal::num_io_groups; fid++){
+         ofile << "spins-container-" << std::setfill('0') << std::setw(6) << fid << ".data" << "\n";
+      }
+   }
+
+   ofile << "#------------------------------------------------------"<< std::endl;
+
+   ofile.close();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to initialise container output, opening existing containers if
+// continuing from a checkpoint
+//------------------------------------------------------------------------------
+void initialize_container(){
+
+   std::stringstream file_sstr;
+   if(config::internal::num_io_groups == 1) file_sstr << "spins-container.data";
+   else file_sstr << "spins-container-" << std::setfill('0') << std::setw(6) << config::internal::io_group_id << ".data";
+   container_filename = file_sstr.str();
+
+   // determine processes writing to container (root writes headers for mpi-io)
+   container_writer = true;
+   #ifdef MPICF
+      if(config::internal::mode == config::internal::mpi_io) container_writer = (vmpi::my_rank == 0);
+      if(config::internal::mode == config::internal::fpnode) container_writer = config::internal::io_group_master;
+   #endif
+
+   if(container_writer){
+      const bool continuing = sim::load_checkpoint_flag && sim::load_checkpoint_continue_flag;
+      if(!continuing || !open_existing_container()) create_container();
+   }
+
+   // all processes need end of container for mpi-io offsets
+   #ifdef MPICF
+      if(config::internal::mode == config::internal::mpi_io){
+         MPI_Bcast(&container_end, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+      }
+   #endif
+
+   if(vmpi::my_rank == 0){
+      write_container_meta();
+      zlog << zTs() << "Outputting spin configurations to container file " << container_filename << std::endl;
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to append snapshot to container file (serial, file per process and
+// file per node modes)
+//------------------------------------------------------------------------------
+double write_container(const std::vector<double>& buffer, const snapshot_t& snapshot){
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer
+   timer.start();
+
+   // spin data in same format as binary data files
+   char header[spin_header_size];
+   const char* data;
+   uint64_t header_bytes;
+   uint64_t data_bytes;
+
+   if(spin_encoding != full){
+      encode_spin_data(buffer);
+      pack_spin_header(buffer.size()/3, encoded_buffer.size(), header);
+      header_bytes = spin_header_size;
+      data = &encoded_buffer[0];
+      data_bytes = encoded_buffer.size();
+   }
+   else{
+      pack_uint(header, buffer.size()/3, 8);
+      header_bytes = sizeof(uint64_t);
+      data = reinterpret_cast<const char*>(&buffer[0]);
+      data_bytes = sizeof(double)*buffer.size();
+   }
+
+   const uint64_t payload_bytes = header_bytes + data_bytes;
+   const uint64_t checksum = vutil::checksum(data, data_bytes, vutil::checksum(header, header_bytes));
+
+   std::fstream file(container_filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+
+   if(!file.is_open()){
+      terminaltextcolor(RED);
+      std::cerr << "Error: Unable to open spin data container " << container_filename << " for writing. Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: Unable to open spin data container " << container_filename << " for writing. Exiting." << std::endl;
+      err::vexit();
+   }
+
+   // write spin data, then record header to complete record
+   file.seekp(container_end + record_header_size);
+   file.write(header, header_bytes);
+   if(data_bytes > 0) file.write(data, data_bytes);
+
+   char record_header[record_header_size];
+   pack_record_header(snapshot, payload_bytes, checksum, record_header);
+   file.seekp(container_end);
+   file.write(record_header, record_header_size);
+   file.flush();
+
+   // index is only updated once the record is complete
+   if(!file.good()) container_write_error();
+
+   // update index
+   snapshot_t entry = snapshot;
+   entry.offset = container_end;
+   entry.size = record_header_size + payload_bytes;
+   container_index.push_back(entry);
+   container_end += entry.size;
+
+   write_container_index(file);
+   file.close();
+
+   // end timer
+   timer.stop();
+
+   encoded_bytes = record_header_size + payload_bytes;
+
+   return timer.elapsed_time();
+
+}
+
+#ifdef MPICF
+//------------------------------------------------------------------------------
+// Function to complete container record after collective write of spin data
+// in mpi-io mode. The root process writes the record header and index.
+//------------------------------------------------------------------------------
+void finish_container_record(MPI_File fh, const snapshot_t& snapshot){
+
+   // ensure spin data are written by all processes before completing record
+   if(MPI_File_sync(fh) != MPI_SUCCESS) container_write_error();
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   const uint64_t record_size = record_header_size + container_payload_bytes;
+
+   if(vmpi::my_rank == 0){
+
+      // spin data checksum is not calculated since data are distributed
+      char record_header[record_header_size];
+      pack_record_header(snapshot, container_payload_bytes, 0, record_header);
+
+      MPI_Status status;
+      if(MPI_File_write_at(fh, container_end, record_header, record_header_size, MPI_BYTE, &status) != MPI_SUCCESS) container_write_error();
+
+      snapshot_t entry = snapshot;
+      entry.offset = container_end;
+      entry.size = record_size;
+      container_index.push_back(entry);
+
+   }
+
+   container_end += record_size;
+
+   if(vmpi::my_rank == 0){
+      std::vector<char> index;
+      pack_container_index(index);
+      MPI_Status status;
+      if(MPI_File_write_at(fh, container_end, &index[0], index.size(), MPI_BYTE, &status) != MPI_SUCCESS) container_write_error();
+   }
+
+   return;
+
+}
+#endif
+
+} // end of internal namespace
+
+} // end of config namespace
@@ -77,6 +77,45 @@ namespace config{
       std::vector<int> io_group_recv_counts(0); // data to receive from each process in io group
       std::vector<int> io_group_displacements(0); // offsets in obuf to receive from each process in io group
 
+      // variables for asynchronous spin data output
+      bool asynchronous_output = false; // flag to enable asynchronous spin data output
+      bool async_in_flight = false; // flag set if a spin data file is still being written
+      std::vector<double> async_buffer(0); // buffer of spin data being written in background
+      std::thread async_writer; // background thread writing spin data
+      uint64_t async_file_counter = 0; // index of file being written
+      double async_io_time = 0.0; // time taken to write file in background (s)
+      double async_total_io_time = 0.0; // total time spent writing files in background (s)
+      double async_total_wait_time = 0.0; // total time simulation waited for writes to complete (s)
+      vutil::vtimer_t async_timer; // timer for non-blocking MPI-IO writes
+
+      // variables for compact spin data output
+      encoding_t spin_encoding = full; // encoding of spin directions (full, octahedral, spherical)
+      int spin_encoding_bits = 32; // bits per encoded spin (32 or 48)
+      bool delta_encoding = false; // flag to enable delta encoding to previous snapshot
+      int delta_keyframe_rate = 10; // number of snapshots between keyframes
+      uint64_t num_encoded_snapshots = 0; // number of snapshots encoded
+      std::vector<uint32_t> previous_spin_codes(0); // codes of previous snapshot
+      std::vector<char> encoded_buffer(0); // encoded spin data
+      bool encoded_delta = false; // flag set if last snapshot was delta encoded
+      uint64_t encoded_bytes = 0; // bytes output by this process for last snapshot
+
+      // variables for spin data container output
+      bool container_output = false; // flag to enable single container file per io group
+      bool container_writer = false; // flag set if this process writes to container file
+      std::string container_filename = ""; // name of container file
+      uint64_t container_end = 0; // offset of end of last record in container (bytes)
+      uint64_t container_file_size = 0; // size of container file (bytes)
+      uint64_t container_payload_bytes = 0; // size of spin data in record being written
+      std::vector<snapshot_t> container_index(0); // index of snapshots in container
+      snapshot_t current_snapshot; // meta data of snapshot being output
+      snapshot_t async_snapshot; // meta data of snapshot being written in background
+      uint64_t encoded_file_bytes = 0; // total size of compact spin data in mpi-io file
+
+      #ifdef MPICF
+         MPI_File async_fh; // file handle for non-blocking MPI-IO write
+         MPI_Request async_request; // request for non-blocking MPI-IO write
+      #endif
+
       #ifdef MPICF
          MPI_Offset linear_offset; // offset for mpi-io collective routines for integer data (bytes)
          MPI_Offset buffer_offset; // offset for mpi-io collective routines for 3 vector double data (bytes)
@@ -0,0 +1,367 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+// Vampire headers
+#include "config.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// config module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Compact spin data format
+//
+// Spin directions are quantised to two integer codes of bits/2 bits each,
+// either the octahedral projection of the unit vector (u,v) or the spherical
+// angles (theta, phi). Spin lengths are not stored.
+//
+// Each file starts with a 48 byte little-endian header
+//
+//    bytes  0 -  7   "VSPINQ01" identifier
+//    bytes  8 - 15   number of atoms in file
+//    bytes 16 - 19   encoding (1 = octahedral, 2 = spherical)
+//    bytes 20 - 23   bits per spin (32 or 48)
+//    bytes 24 - 27   delta flag (0 = keyframe, 1 = delta to previous snapshot)
+//    bytes 28 - 31   reserved (0)
+//    bytes 32 - 39   maximum angular error (radians, IEEE double)
+//    bytes 40 - 47   number of bytes of spin data following header
+//
+// Keyframes store the codes of each atom as two little-endian integers of
+// bits/16 bytes. Delta frames store the difference to the codes of the
+// previous snapshot (modulo 2^(bits/2)) as zig-zag encoded variable length
+// integers with 7 bits per byte, so that small changes need a single byte.
+// Frames are only delta encoded if this is smaller than a keyframe.
+//------------------------------------------------------------------------------
+
+namespace config{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to append variable length integer to byte buffer
+//------------------------------------------------------------------------------
+inline void append_varint(std::vector<char>& buffer, uint64_t value){
+   while(value >= 0x80){
+      buffer.push_back(char((value & 0x7F) | 0x80));
+      value >>= 7;
+   }
+   buffer.push_back(char(value));
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate maximum angular error of spin encoding (radians)
+//------------------------------------------------------------------------------
+double spin_encoding_error(){
+
+   const int bits = spin_encoding_bits/2; // bits per code
+   const double steps = std::pow(2.0, bits) - 2.0; // number of quantisation steps in [-1,1] or [0,pi]
+
+   switch(spin_encoding){
+
+      // half step in u and v displaces the point on the octahedron by at most
+      // sqrt(6) h, magnified by at most sqrt(3) on projection to the sphere
+      case octahedral:{
+         const double h = 1.0/steps;
+         return 2.0*asin(std::min(1.0, 1.5*sqrt(2.0)*h));
+      }
+
+      // half step in theta plus half step in phi
+      case spherical:
+         return 0.5*M_PI/steps + M_PI/std::pow(2.0, bits);
+
+      default:
+         return 0.0;
+
+   }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to quantise 3-vector spin data to two codes per spin
+//------------------------------------------------------------------------------
+void quantise_spin_data(const std::vector<double>& buffer, std::vector<uint32_t>& codes){
+
+   const uint64_t num_spins = buffer.size()/3;
+   codes.resize(2*num_spins);
+
+   const int bits = spin_encoding_bits/2;
+   const uint32_t max_code = (uint32_t(1) << bits) - 2;
+   const double steps = double(max_code);
+
+   if(spin_encoding == octahedral){
+
+      const double scale = 0.5*steps;
+
+      for(uint64_t i = 0; i < num_spins; i++){
+
+         const double x = buffer[3*i+0];
+         const double y = buffer[3*i+1];
+         const double z = buffer[3*i+2];
+
+         // project onto octahedron |x|+|y|+|z| = 1
+         const double l1 = fabs(x) + fabs(y) + fabs(z);
+         const double il1 = l1 > 0.0 ? 1.0/l1 : 0.0;
+         double u = x*il1;
+         double v = y*il1;
+
+         // fold lower hemisphere over diagonals
+         if(z < 0.0){
+            const double su = u >= 0.0 ? 1.0 : -1.0;
+            const double sv = v >= 0.0 ? 1.0 : -1.0;
+            const double fu = (1.0 - fabs(v))*su;
+            const double fv = (1.0 - fabs(u))*sv;
+            u = fu;
+            v = fv;
+         }
+
+         const double qu = floor((u + 1.0)*scale + 0.5);
+         const double qv = floor((v + 1.0)*scale + 0.5);
+
+         codes[2*i+0] = uint32_t(std::min(steps, std::max(0.0, qu)));
+         codes[2*i+1] = uint32_t(std::min(steps, std::max(0.0, qv)));
+
+      }
+
+   }
+   else{
+
+      const double theta_scale = steps/M_PI;
+      const double num_phi = std::pow(2.0, bits);
+      const double phi_scale = num_phi/(2.0*M_PI);
+      const uint32_t phi_mask = (uint32_t(1) << bits) - 1;
+
+      for(uint64_t i = 0; i < num_spins; i++){
+
+         const double x = buffer[3*i+0];
+         const double y = buffer[3*i+1];
+         const double z = buffer[3*i+2];
+
+         const double r = sqrt(x*x + y*y + z*z);
+         const double cos_theta = r > 0.0 ? std::min(1.0, std::max(-1.0, z/r)) : 1.0;
+
+         const double theta = acos(cos_theta);
+         const double phi = atan2(y, x); // [-pi,pi]
+
+         const double qt = floor(theta*theta_scale + 0.5);
+         const double qp = floor((phi + M_PI)*phi_scale + 0.5);
+
+         codes[2*i+0] = uint32_t(std::min(steps, std::max(0.0, qt)));
+         codes[2*i+1] = uint32_t(qp) & phi_mask; // phi is periodic
+
+      }
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to encode codes of last snapshot as keyframe to encoded_buffer
+//------------------------------------------------------------------------------
+void encode_keyframe(){
+
+   const int bytes_per_code = spin_encoding_bits/16;
+
+   encoded_buffer.resize(previous_spin_codes.size()*bytes_per_code);
+
+   for(uint64_t i = 0; i < previous_spin_codes.size(); i++){
+      pack_uint(&encoded_buffer[bytes_per_code*i], previous_spin_codes[i], bytes_per_code);
+   }
+
+   encoded_delta = false;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to encode spin data in compact format to encoded_buffer (without
+// header). Codes are saved for delta encoding of the next snapshot.
+//------------------------------------------------------------------------------
+void encode_spin_data(const std::vector<double>& buffer){
+
+   std::vector<uint32_t> codes;
+   quantise_spin_data(buffer, codes);
+
+   const int bits = spin_encoding_bits/2;
+   const int bytes_per_code = bits/8;
+   const uint64_t keyframe_size = codes.size()*bytes_per_code;
+
+   encoded_buffer.clear();
+
+   // determine if delta frame is possible for this snapshot
+   encoded_delta = delta_encoding && previous_spin_codes.size() == codes.size() &&
+                   num_encoded_snapshots % uint64_t(delta_keyframe_rate) != 0;
+
+   if(encoded_delta){
+
+      encoded_buffer.reserve(codes.size());
+
+      const int64_t range = int64_t(1) << bits;
+      const uint32_t mask = uint32_t(range - 1);
+
+      for(uint64_t i = 0; i < codes.size(); i++){
+
+         // difference modulo 2^bits as signed integer
+         int64_t d = int64_t((codes[i] - previous_spin_codes[i]) & mask);
+         if(d >= range/2) d -= range;
+
+         // zig-zag encode so small negative differences are small
+         const uint64_t zz = (uint64_t(d) << 1) ^ uint64_t(d >> 63);
+         append_varint(encoded_buffer, zz);
+
+         // give up if larger than keyframe
+         if(encoded_buffer.size() >= keyframe_size) break;
+
+      }
+
+      if(encoded_buffer.size() >= keyframe_size && codes.size() > 0) encoded_delta = false;
+
+   }
+
+   previous_spin_codes.swap(codes);
+   num_encoded_snapshots++;
+
+   if(!encoded_delta) encode_keyframe();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to pack header of compact spin data file
+//------------------------------------------------------------------------------
+void pack_spin_header(const uint64_t num_atoms, const uint64_t num_bytes, char* header){
+
+   const char identifier[8] = {'V','S','P','I','N','Q','0','1'};
+   std::memcpy(header, identifier, 8);
+
+   const double error = spin_encoding_error();
+   uint64_t error_bits = 0;
+   std::memcpy(&error_bits, &error, sizeof(double));
+
+   pack_uint(header +  8, num_atoms, 8);
+   pack_uint(header + 16, uint64_t(spin_encoding), 4);
+   pack_uint(header + 20, uint64_t(spin_encoding_bits), 4);
+   pack_uint(header + 24, encoded_delta ? 1 : 0, 4);
+   pack_uint(header + 28, 0, 4);
+   pack_uint(header + 32, error_bits, 8);
+   pack_uint(header + 40, num_bytes, 8);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to output spin data in compact binary format
+//------------------------------------------------------------------------------
+double write_data_encoded(std::string filename, const std::vector<double> &buffer){
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer (encoding is part of output cost)
+   timer.start();
+
+   encode_spin_data(buffer);
+
+   char header[spin_header_size];
+   pack_spin_header(buffer.size()/3, encoded_buffer.size(), header);
+
+   // Declare and open output file
+   std::ofstream ofile;
+   ofile.open(filename.c_str(), std::ios::binary);
+
+   // output header and data
+   ofile.write(header, spin_header_size);
+   if(encoded_buffer.size() > 0) ofile.write(&encoded_buffer[0], encoded_buffer.size());
+
+   // close output file
+   ofile.close();
+
+   // end timer
+   timer.stop();
+
+   encoded_bytes = spin_header_size + encoded_buffer.size();
+
+   return timer.elapsed_time();
+
+}
+
+#ifdef MPICF
+//------------------------------------------------------------------------------
+// Function to encode local spin data for collective MPI-IO output. The header
+// is written by the root process at base_offset and the byte offset of local
+// data returned.
+//------------------------------------------------------------------------------
+MPI_Offset write_encoded_header(MPI_File fh, const std::vector<double> &buffer, const MPI_Offset base_offset){
+
+   encode_spin_data(buffer);
+
+   // delta encoding is chosen per process, so use keyframes if any process did not
+   int local_delta = encoded_delta ? 1 : 0;
+   int all_delta = 0;
+   MPI_Allreduce(&local_delta, &all_delta, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+   if(encoded_delta && all_delta == 0) encode_keyframe();
+
+   // calculate offset and total size of encoded data
+   uint64_t local_bytes = encoded_buffer.size();
+   uint64_t offset = 0;
+   uint64_t total_bytes = 0;
+   MPI_Exscan(&local_bytes, &offset, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   MPI_Allreduce(&local_bytes, &total_bytes, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   if(vmpi::my_rank == 0) offset = 0;
+
+   encoded_bytes = local_bytes;
+   encoded_file_bytes = spin_header_size + total_bytes;
+
+   // write header on root process
+   if(vmpi::my_rank == 0){
+      char header[spin_header_size];
+      pack_spin_header(total_output_atoms, total_bytes, header);
+      MPI_Status status;
+      MPI_File_write_at(fh, base_offset, header, spin_header_size, MPI_BYTE, &status);
+      encoded_bytes += spin_header_size;
+   }
+
+   return base_offset + MPI_Offset(spin_header_size + offset);
+
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Function to update size of last spin data output from all processes (GB)
+//------------------------------------------------------------------------------
+void update_encoded_data_size(){
+
+   #ifdef MPICF
+      uint64_t total_bytes = 0;
+      MPI_Reduce(&encoded_bytes, &total_bytes, 1, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
+   #else
+      const uint64_t total_bytes = encoded_bytes;
+   #endif
+
+   io_data_size = 1.0e-9*double(total_bytes);
+
+   return;
+
+}
+
+} // end of internal namespace
+
+} // end of config namespace
@@ -48,8 +48,11 @@ namespace config{
                                  atoms_output_max[1] * cs::system_dimensions[1],
                                  atoms_output_max[2] * cs::system_dimensions[2]};
 
-         // loop over all local atoms and determine atoms to be outputted
-         for (uint64_t atom = 0; atom < num_atoms; atom++){
+         // loop over all local atoms in generation order and determine atoms to be outputted
+         const bool renumbered = (create::renumbered_atom_array.size() == num_atoms);
+         for (uint64_t index = 0; index < num_atoms; index++){
+
+            const uint64_t atom = renumbered ? create::renumbered_atom_array[index] : index;
 
             const double cc[3] = {atoms::x_coord_array[atom], atoms::y_coord_array[atom], atoms::z_coord_array[atom]};
 
@@ -181,6 +184,29 @@ namespace config{
          // Output informative message to log
          zlog << " done!" << std::endl;
 
+         // compact spin encoding is only available for binary output
+         if(config::internal::spin_encoding != config::internal::full){
+            if(config::internal::format != config::internal::binary || config::internal::mode == config::internal::legacy){
+               zlog << zTs() << "Warning: config:spin-encoding requires binary format and non-legacy output mode - outputting full spin data" << std::endl;
+               config::internal::spin_encoding = config::internal::full;
+            }
+            else{
+               zlog << zTs() << "Encoding spin data with " << config::internal::spin_encoding_bits << " bits per spin, maximum angular error "
+                    << config::internal::spin_encoding_error() << " rad";
+               if(config::internal::delta_encoding) zlog << ", delta encoded with keyframe every " << config::internal::delta_keyframe_rate << " snapshots";
+               zlog << std::endl;
+            }
+         }
+
+         // container output is only available for binary output
+         if(config::internal::container_output){
+            if(config::internal::format != config::internal::binary || config::internal::mode == config::internal::legacy){
+               zlog << zTs() << "Warning: config:output-container requires binary format and non-legacy output mode - outputting separate files" << std::endl;
+               config::internal::container_output = false;
+            }
+            else config::internal::initialize_container();
+         }
+
          return;
 
       }
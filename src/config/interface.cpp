@@ -186,6 +186,76 @@ namespace config{
          config::internal::identify_surface_atoms = true;
          return EXIT_SUCCESS;
       }
+      //-------------------------------------------------------------------
+      test="asynchronous-output";
+      if(word==test){
+         config::internal::asynchronous_output = true;
+         return EXIT_SUCCESS;
+      }
+      //-------------------------------------------------------------------
+      test="output-container";
+      if(word==test){
+         config::internal::container_output = true;
+         return EXIT_SUCCESS;
+      }
+      //--------------------------------------------------------------------
+      test="spin-encoding";
+      if(word==test){
+         test="none";
+         if(value == test){
+            config::internal::spin_encoding = internal::full;
+            return EXIT_SUCCESS;
+         }
+         test="octahedral-32";
+         if(value == test){
+            config::internal::spin_encoding = internal::octahedral;
+            config::internal::spin_encoding_bits = 32;
+            return EXIT_SUCCESS;
+         }
+         test="octahedral-48";
+         if(value == test){
+            config::internal::spin_encoding = internal::octahedral;
+            config::internal::spin_encoding_bits = 48;
+            return EXIT_SUCCESS;
+         }
+         test="spherical-32";
+         if(value == test){
+            config::internal::spin_encoding = internal::spherical;
+            config::internal::spin_encoding_bits = 32;
+            return EXIT_SUCCESS;
+         }
+         test="spherical-48";
+         if(value == test){
+            config::internal::spin_encoding = internal::spherical;
+            config::internal::spin_encoding_bits = 48;
+            return EXIT_SUCCESS;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"none\"" << std::endl;
+            std::cerr << "\t\"octahedral-32\"" << std::endl;
+            std::cerr << "\t\"octahedral-48\"" << std::endl;
+            std::cerr << "\t\"spherical-32\"" << std::endl;
+            std::cerr << "\t\"spherical-48\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //-------------------------------------------------------------------
+      test="spin-delta-encoding";
+      if(word==test){
+         config::internal::delta_encoding = true;
+         return EXIT_SUCCESS;
+      }
+      //-----------------------------------------
+      test="spin-delta-keyframe-rate";
+      if(word==test){
+         int i=atoi(value.c_str());
+         vin::check_for_valid_int(i, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
+         internal::delta_keyframe_rate=i;
+         return EXIT_SUCCESS;
+      }
       //-----------------------------------------
       test="field-range-descending-minimum";
       if(word==test){
@@ -21,10 +21,13 @@
 
 // C++ standard library headers
 #include <cstdint>
+#include <string>
+#include <thread>
 
 // Vampire headers
 #include "config.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 
 namespace config
 {
@@ -35,6 +38,27 @@ namespace internal
    // enumerated integers for option selection
    enum format_t{ binary = 0, text = 1};
    enum mode_t{ legacy = 0, mpi_io = 1, fpprocess = 2, fpnode = 3};
+   enum encoding_t{ full = 0, octahedral = 1, spherical = 2};
+
+   // size of compact spin data file header (bytes)
+   const int spin_header_size = 48;
+
+   // sizes of spin data container file sections (bytes)
+   const int container_header_size = 32;
+   const int record_header_size = 112;
+   const int index_entry_size = 88;
+   const int trailer_size = 32;
+
+   // simple struct to store snapshot meta data for container index
+   struct snapshot_t{
+      uint64_t id; // snapshot (file counter) number
+      uint64_t offset; // offset of record in container file (bytes)
+      uint64_t size; // size of record in container file (bytes)
+      double time; // time (seconds)
+      double temperature; // system temperature (Kelvin)
+      double field[3]; // applied field (Tesla)
+      double magnetization[3]; // magnetization (normalized)
+   };
 
    //-------------------------------------------------------------------------
    // Internal data type definitions
@@ -86,6 +110,45 @@ namespace internal
    extern std::vector<int> io_group_recv_counts; // data to receive from each process in io group
    extern std::vector<int> io_group_displacements; // offsets in obuf to receive from each process in io group
 
+   // variables for asynchronous spin data output
+   extern bool asynchronous_output; // flag to enable asynchronous spin data output
+   extern bool async_in_flight; // flag set if a spin data file is still being written
+   extern std::vector<double> async_buffer; // buffer of spin data being written in background
+   extern std::thread async_writer; // background thread writing spin data
+   extern uint64_t async_file_counter; // index of file being written
+   extern double async_io_time; // time taken to write file in background (s)
+   extern double async_total_io_time; // total time spent writing files in background (s)
+   extern double async_total_wait_time; // total time simulation waited for writes to complete (s)
+   extern vutil::vtimer_t async_timer; // timer for non-blocking MPI-IO writes
+
+   // variables for compact spin data output
+   extern encoding_t spin_encoding; // encoding of spin directions (full, octahedral, spherical)
+   extern int spin_encoding_bits; // bits per encoded spin (32 or 48)
+   extern bool delta_encoding; // flag to enable delta encoding to previous snapshot
+   extern int delta_keyframe_rate; // number of snapshots between keyframes
+   extern uint64_t num_encoded_snapshots; // number of snapshots encoded
+   extern std::vector<uint32_t> previous_spin_codes; // codes of previous snapshot
+   extern std::vector<char> encoded_buffer; // encoded spin data
+   extern bool encoded_delta; // flag set if last snapshot was delta encoded
+   extern uint64_t encoded_bytes; // bytes output by this process for last snapshot
+
+   // variables for spin data container output
+   extern bool container_output; // flag to enable single container file per io group
+   extern bool container_writer; // flag set if this process writes to container file
+   extern std::string container_filename; // name of container file
+   extern uint64_t container_end; // offset of end of last record in container (bytes)
+   extern uint64_t container_file_size; // size of container file (bytes)
+   extern uint64_t container_payload_bytes; // size of spin data in record being written
+   extern std::vector<snapshot_t> container_index; // index of snapshots in container
+   extern snapshot_t current_snapshot; // meta data of snapshot being output
+   extern snapshot_t async_snapshot; // meta data of snapshot being written in background
+   extern uint64_t encoded_file_bytes; // total size of compact spin data in mpi-io file
+
+   #ifdef MPICF
+      extern MPI_File async_fh; // file handle for non-blocking MPI-IO write
+      extern MPI_Request async_request; // request for non-blocking MPI-IO write
+   #endif
+
    #ifdef MPICF
       extern MPI_Offset linear_offset; // offset for mpi-io collective routines for integer data (bytes)
       extern MPI_Offset buffer_offset; // offset for mpi-io collective routines for 3 vector double data (bytes)
@@ -110,7 +173,40 @@ namespace internal
    void legacy_cells();
    void legacy_cells_coords();
 
-   double write_data(std::string, const std::vector<double> &buffer);
+   double write_data(std::string, const std::vector<double> &buffer, const snapshot_t& snapshot);
+   double write_data_encoded(std::string filename, const std::vector<double> &buffer);
+   double spin_encoding_error();
+   void encode_spin_data(const std::vector<double>& buffer);
+   void pack_spin_header(const uint64_t num_atoms, const uint64_t num_bytes, char* header);
+   void update_encoded_data_size();
+   #ifdef MPICF
+      MPI_Offset write_encoded_header(MPI_File fh, const std::vector<double> &buffer, const MPI_Offset base_offset = 0);
+      MPI_Offset prepare_mpi_io_output(MPI_File fh, std::vector<double>& buffer, void*& data, int& data_size, MPI_Datatype& data_type);
+   #endif
+
+   void initialize_container();
+   double write_container(const std::vector<double>& buffer, const snapshot_t& snapshot);
+   #ifdef MPICF
+      void finish_container_record(MPI_File fh, const snapshot_t& snapshot);
+   #endif
+
+   //-------------------------------------------------------------------------
+   // Functions to pack and unpack little-endian integers in byte buffer
+   //-------------------------------------------------------------------------
+   inline void pack_uint(char* buffer, uint64_t value, const int num_bytes){
+      for(int b = 0; b < num_bytes; b++){
+         buffer[b] = char(value & 0xFF);
+         value >>= 8;
+      }
+   }
+
+   inline uint64_t unpack_uint(const char* buffer, const int num_bytes){
+      uint64_t value = 0;
+      for(int b = num_bytes-1; b >= 0; b--) value = (value << 8) | uint64_t((unsigned char)buffer[b]);
+      return value;
+   }
+   void start_async_output(std::string filename);
+   void wait_for_async_output();
    double write_coord_data(std::string filename, const std::vector<double>& buffer, const std::vector<int>& type_buffer, const std::vector<int>& category_buffer);
 
    void copy_data_to_buffer(const std::vector<double> &x, // vector data
@@ -19,6 +19,7 @@
 #include "vio.hpp"
 #include "vutil.hpp"
 #include "sim.hpp"
+#include "vmpi.hpp"
 
 // config headers
 #include "internal.hpp"
@@ -74,14 +75,18 @@ double write_data_binary(std::string filename, const std::vector<double> &buffer
 // Simple wrapper function to call output function for correct format
 //----------------------------------------------------------------------------------------------------
 //
-double write_data(std::string filename, const std::vector<double> &buffer){
+double write_data(std::string filename, const std::vector<double> &buffer, const snapshot_t& snapshot){
+
+   // append to container file
+   if(config::internal::container_output) return write_container(buffer, snapshot);
 
    double io_time = 0.0;
 
    switch (config::internal::format){
 
       case config::internal::binary:
-         io_time = write_data_binary(filename, buffer);
+         if(config::internal::spin_encoding != config::internal::full) io_time = write_data_encoded(filename, buffer);
+         else io_time = write_data_binary(filename, buffer);
          break;
 
       case config::internal::text:
@@ -174,5 +179,43 @@ double write_data_binary(std::string filename, const std::vector<double> &buffer
 
 
 
+#ifdef MPICF
+//----------------------------------------------------------------------------------------------------
+// Function to prepare spin data for collective mpi-io output, writing any headers on the root
+// process. Returns the file offset of local data and sets the data, size and type to be written.
+//----------------------------------------------------------------------------------------------------
+//
+MPI_Offset prepare_mpi_io_output(MPI_File fh, std::vector<double>& buffer, void*& data, int& data_size, MPI_Datatype& data_type){
+
+   // spin data follow record header in container
+   MPI_Offset base_offset = 0;
+   if(config::internal::container_output) base_offset = config::internal::container_end + config::internal::record_header_size;
+
+   MPI_Offset data_offset = 0;
+
+   if(config::internal::spin_encoding != config::internal::full){
+      data_offset = write_encoded_header(fh, buffer, base_offset);
+      data = &config::internal::encoded_buffer[0];
+      data_size = config::internal::encoded_buffer.size();
+      data_type = MPI_BYTE;
+      config::internal::container_payload_bytes = config::internal::encoded_file_bytes;
+   }
+   else{
+      // write number of atoms on root process
+      MPI_Status status;
+      if(vmpi::my_rank == 0) MPI_File_write_at(fh, base_offset, &total_output_atoms, 1, MPI_UINT64_T, &status);
+      // Calculate local byte offset since MPI-IO is simple and doesn't update the file handle pointer after I/O
+      data_offset = base_offset + config::internal::buffer_offset + sizeof(uint64_t);
+      data = &buffer[0];
+      data_size = buffer.size();
+      data_type = MPI_DOUBLE;
+      config::internal::container_payload_bytes = sizeof(uint64_t) + 3*sizeof(double)*total_output_atoms;
+   }
+
+   return data_offset;
+
+}
+#endif
+
 } // end of namespace internal
 } // end of namespace config
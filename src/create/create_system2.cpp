@@ -64,6 +64,9 @@
 #include "vmath.hpp"
 #include "vmpi.hpp"
 
+// Internal create header
+#include "internal.hpp"
+
 
 
 
@@ -216,6 +219,18 @@ int create(){
 	// Cut system to the correct type, species etc
 	cs::create_system_type(catom_array);
 
+	// Rebalance decomposition and create system again if required
+	#ifdef MPICF
+	if(vmpi::mpi_mode==0 && vmpi::load_balancing){
+		if(vmpi::balance_decomposition(catom_array,cs::system_dimensions)){
+			catom_array.clear();
+			cs::non_magnetic_atoms_array.clear();
+			cs::create_crystal_structure(catom_array);
+			cs::create_system_type(catom_array);
+		}
+	}
+	#endif
+
 	// Copy atoms for interprocessor communications
 	#ifdef MPICF
 	if(vmpi::mpi_mode==0){
@@ -260,6 +275,9 @@ int create(){
 			// Only generate system if I am it
 			if(i_am_it){
 
+				// Renumber atoms for memory locality if required
+				create::internal::renumber_atoms(catom_array,cneighbourlist);
+
 				zlog << zTs() << "Copying system data to optimised data structures on rank " << vmpi::my_rank << "..." << std::endl;
 				//std::cerr << zTs() << "Copying system data to optimised data structures on rank " << vmpi::my_rank << "..." << std::endl;
 				cs::set_atom_vars(catom_array,cneighbourlist);
@@ -275,6 +293,9 @@ int create(){
 	else{
 	#endif
 
+	// Renumber atoms for memory locality if required
+	create::internal::renumber_atoms(catom_array,cneighbourlist);
+
 	// Print informative message
 	std::cout << "Copying system data to optimised data structures." << std::endl;
 	zlog << zTs() << "Copying system data to optimised data structures." << std::endl;
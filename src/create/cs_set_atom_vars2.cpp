@@ -81,6 +81,7 @@ int set_atom_vars(std::vector<cs::catom_t> & catom_array, std::vector<std::vecto
    atoms::category_array.resize( atoms::num_atoms,0);
    atoms::grain_array.resize(    atoms::num_atoms,0);
    atoms::cell_array.resize(     atoms::num_atoms,0);
+   atoms::global_id_array.resize(atoms::num_atoms,0);
 
 	atoms::x_total_spin_field_array.resize(atoms::num_atoms,0.0);
 	atoms::y_total_spin_field_array.resize(atoms::num_atoms,0.0);
@@ -115,6 +116,14 @@ int set_atom_vars(std::vector<cs::catom_t> & catom_array, std::vector<std::vecto
 		//std::cout << atom << " grain: " << catom_array[atom].grain << std::endl;
 		atoms::grain_array[atom] = catom_array[atom].grain;
 
+		// set unique atom id from global unit cell position and unit cell atom id, wrapping
+		// periodic images of halo atoms back into the system
+		const int64_t ncells[3] = {cs::total_num_unit_cells[0], cs::total_num_unit_cells[1], cs::total_num_unit_cells[2]};
+		const int64_t scc[3] = {((catom_array[atom].scx % ncells[0]) + ncells[0]) % ncells[0],
+										((catom_array[atom].scy % ncells[1]) + ncells[1]) % ncells[1],
+										((catom_array[atom].scz % ncells[2]) + ncells[2]) % ncells[2]};
+		atoms::global_id_array[atom] = ((scc[2]*ncells[1] + scc[1])*ncells[0] + scc[0])*uint64_t(unit_cell.atom.size()) + uint64_t(catom_array[atom].uc_id);
+
 		// initialise atomic spin positions
       // Use a normalised gaussian for uniform distribution on a unit sphere
 		int mat=atoms::type_array[atom];
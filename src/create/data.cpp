@@ -22,6 +22,8 @@ namespace create{
    //---------------------------------------------------------------------------
    int num_total_atoms_non_filler = 0;
 
+   std::vector<int> renumbered_atom_array; // new atom number for each atom in generation order (empty if not renumbered)
+
       namespace internal{
 
          //----------------------------------------------------------------------------
@@ -52,6 +54,8 @@ namespace create{
 
          bool select_material_by_z_height = false;	// Toggle overwriting of material id by z-height
 
+         atom_ordering_t atom_ordering = generation; // ordering of atoms after neighbour list creation
+
       } // end of internal namespace
 
 } // end of create namespace
@@ -188,6 +188,35 @@ namespace create{
          create::internal::mixing_seed = mrs;
          return true;
       }
+      //--------------------------------------------------------------------
+      test="atom-ordering";
+      if(word==test){
+         // default, atoms are kept in generation order
+         test="generation";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::generation;
+            return true;
+         }
+         test="morton";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::morton;
+            return true;
+         }
+         test="hilbert";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::hilbert;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"generation\"" << std::endl;
+            std::cerr << "\t\"morton\"" << std::endl;
+            std::cerr << "\t\"hilbert\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
       /*std::string test="slonczewski-spin-polarization-unit-vector";
       if(word==test){
          std::vector<double> u(3);
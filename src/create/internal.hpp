@@ -123,6 +123,14 @@ namespace create{
 
       extern bool select_material_by_z_height;
 
+      // Enumerated list of available atom orderings
+      enum atom_ordering_t { generation = 0, // atoms in order of generation
+                             morton = 1, // atoms renumbered along Morton (z-order) curve
+                             hilbert = 2 // atoms renumbered along Hilbert curve
+      };
+
+      extern atom_ordering_t atom_ordering; // ordering of atoms after neighbour list creation
+
       //-----------------------------------------------------------------------------
       // Internal functions for create module
       //-----------------------------------------------------------------------------
@@ -141,6 +149,7 @@ namespace create{
       extern void truncated_octahedron(std::vector<double>& particle_origin, std::vector<cs::catom_t> & catom_array, const int grain);
 
       extern void voronoi_substructure(std::vector<cs::catom_t> & catom_array);
+      extern void renumber_atoms(std::vector<cs::catom_t> & catom_array, std::vector<std::vector <cs::neighbour_t> > & cneighbourlist);
 
       void voronoi_grain_rounding(std::vector <std::vector <double> > & grain_coord_array,
                                   std::vector <std::vector <std::vector <double> > > &  grain_vertices_array);
@@ -0,0 +1,189 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <stdint.h>
+
+// Vampire headers
+#include "create.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+namespace create{
+
+   namespace internal{
+
+      // number of bits per dimension used for space filling curve keys
+      const int sfc_bits = 21;
+
+      //-----------------------------------------------------------------------------
+      // Simple class for storing curve key and atom number for sorting
+      //-----------------------------------------------------------------------------
+      class sfc_atom_t{
+      public:
+         uint64_t key; // position along space filling curve
+         unsigned int uc_id; // unit cell atom id to order atoms within a unit cell
+         int atom; // atom number in generation order
+      };
+
+      bool compare_sfc_atom(const sfc_atom_t& first, const sfc_atom_t& second){
+         if(first.key != second.key) return first.key < second.key;
+         if(first.uc_id != second.uc_id) return first.uc_id < second.uc_id;
+         return first.atom < second.atom;
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to interleave bits of three coordinates, most significant first
+      //-----------------------------------------------------------------------------
+      uint64_t interleave_bits(const uint32_t X[3]){
+         uint64_t key = 0;
+         for(int bit = sfc_bits-1; bit >= 0; bit--){
+            for(int i = 0; i < 3; i++) key = (key << 1) | ((X[i] >> bit) & 1);
+         }
+         return key;
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to calculate Morton (z-order) key for a set of integer coordinates
+      //-----------------------------------------------------------------------------
+      uint64_t morton_key(const uint32_t x, const uint32_t y, const uint32_t z){
+         const uint32_t X[3] = {x, y, z};
+         return interleave_bits(X);
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to calculate Hilbert key for a set of integer coordinates, using
+      // the transpose algorithm of J. Skilling, AIP Conf. Proc. 707, 381 (2004)
+      //-----------------------------------------------------------------------------
+      uint64_t hilbert_key(const uint32_t x, const uint32_t y, const uint32_t z){
+
+         uint32_t X[3] = {x, y, z};
+         const uint32_t M = 1u << (sfc_bits-1);
+
+         // inverse undo excess work
+         for(uint32_t Q = M; Q > 1; Q >>= 1){
+            const uint32_t P = Q - 1;
+            for(int i = 0; i < 3; i++){
+               if(X[i] & Q) X[0] ^= P; // invert
+               else{ // exchange
+                  const uint32_t t = (X[0] ^ X[i]) & P;
+                  X[0] ^= t;
+                  X[i] ^= t;
+               }
+            }
+         }
+
+         // gray encode
+         for(int i = 1; i < 3; i++) X[i] ^= X[i-1];
+         uint32_t t = 0;
+         for(uint32_t Q = M; Q > 1; Q >>= 1){
+            if(X[2] & Q) t ^= Q - 1;
+         }
+         for(int i = 0; i < 3; i++) X[i] ^= t;
+
+         return interleave_bits(X);
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to renumber atoms along a space filling curve to improve the
+      // memory locality of neighbour interactions. Atoms are ordered by the unit
+      // cell they belong to and then by their id within the unit cell. For
+      // parallel simulations core, boundary and halo atoms are renumbered
+      // separately to preserve the ordering required by the halo swap.
+      //-----------------------------------------------------------------------------
+      void renumber_atoms(std::vector<cs::catom_t> & catom_array, std::vector<std::vector <cs::neighbour_t> > & cneighbourlist){
+
+         if(atom_ordering == generation) return;
+
+         const int num_atoms = catom_array.size();
+         if(num_atoms == 0) return;
+
+         zlog << zTs() << "Renumbering atoms along " << (atom_ordering == morton ? "Morton" : "Hilbert") << " curve." << std::endl;
+
+         // determine minimum unit cell coordinates to calculate positive offsets
+         int min_sc[3] = {catom_array[0].scx, catom_array[0].scy, catom_array[0].scz};
+         for(int atom = 0; atom < num_atoms; atom++){
+            min_sc[0] = std::min(min_sc[0], catom_array[atom].scx);
+            min_sc[1] = std::min(min_sc[1], catom_array[atom].scy);
+            min_sc[2] = std::min(min_sc[2], catom_array[atom].scz);
+         }
+
+         // calculate curve keys for all atoms
+         const uint32_t mask = (1u << sfc_bits) - 1;
+         std::vector<sfc_atom_t> sfc_atoms(num_atoms);
+         for(int atom = 0; atom < num_atoms; atom++){
+            const uint32_t x = uint32_t(catom_array[atom].scx - min_sc[0]) & mask;
+            const uint32_t y = uint32_t(catom_array[atom].scy - min_sc[1]) & mask;
+            const uint32_t z = uint32_t(catom_array[atom].scz - min_sc[2]) & mask;
+            sfc_atoms[atom].key = (atom_ordering == morton) ? morton_key(x, y, z) : hilbert_key(x, y, z);
+            sfc_atoms[atom].uc_id = catom_array[atom].uc_id;
+            sfc_atoms[atom].atom = atom;
+         }
+
+         // sort atoms within each range (core, boundary and halo atoms for parallel version)
+         #ifdef MPICF
+            const int range[4] = {0, vmpi::num_core_atoms, vmpi::num_core_atoms + vmpi::num_bdry_atoms, num_atoms};
+            const int num_ranges = 3;
+         #else
+            const int range[2] = {0, num_atoms};
+            const int num_ranges = 1;
+         #endif
+
+         for(int r = 0; r < num_ranges; r++){
+            std::sort(sfc_atoms.begin() + range[r], sfc_atoms.begin() + range[r+1], compare_sfc_atom);
+         }
+
+         // determine new atom number for each old atom
+         std::vector<int> new_atom_number(num_atoms);
+         for(int atom = 0; atom < num_atoms; atom++) new_atom_number[sfc_atoms[atom].atom] = atom;
+
+         // copy atoms and neighbour lists to new order with renumbered neighbours
+         std::vector<cs::catom_t> tmp_catom_array(num_atoms);
+         std::vector<std::vector <cs::neighbour_t> > tmp_cneighbourlist(num_atoms);
+
+         for(int atom = 0; atom < num_atoms; atom++){
+            const int old_atom = sfc_atoms[atom].atom;
+            tmp_catom_array[atom] = catom_array[old_atom];
+            tmp_cneighbourlist[atom].swap(cneighbourlist[old_atom]);
+            for(unsigned int nn = 0; nn < tmp_cneighbourlist[atom].size(); nn++){
+               tmp_cneighbourlist[atom][nn].nn = new_atom_number[tmp_cneighbourlist[atom][nn].nn];
+            }
+         }
+
+         catom_array.swap(tmp_catom_array);
+         cneighbourlist.swap(tmp_cneighbourlist);
+
+         // translate atom numbers for halo swap
+         #ifdef MPICF
+            for(unsigned int i = 0; i < vmpi::send_atom_translation_array.size(); i++){
+               vmpi::send_atom_translation_array[i] = new_atom_number[vmpi::send_atom_translation_array[i]];
+            }
+            for(unsigned int i = 0; i < vmpi::recv_atom_translation_array.size(); i++){
+               vmpi::recv_atom_translation_array[i] = new_atom_number[vmpi::recv_atom_translation_array[i]];
+            }
+            const int num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+         #else
+            const int num_local_atoms = num_atoms;
+         #endif
+
+         // save new atom numbers of local atoms to keep output in generation order
+         create::renumbered_atom_array.assign(new_atom_number.begin(), new_atom_number.begin() + num_local_atoms);
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of create namespace
@@ -52,6 +52,7 @@ namespace atoms{
 	std::vector <int> category_array(0);
 	std::vector <int> grain_array(0);
 	std::vector <int> cell_array(0);
+   std::vector <uint64_t> global_id_array(0); /// Decomposition independent atom id from unit cell position
 
 	std::vector <double> x_spin_array(0);
 	std::vector <double> y_spin_array(0);
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to update dipole fields only when the magnetisation of a
+      // cell has changed by more than update_tolerance times its saturation
+      // moment since the last update. With full tensor storage the fields are
+      // updated incrementally from the changed cells when few cells have
+      // changed. A full update is always made after update_rate time steps.
+      //
+      // The cell magnetisation is the same on all processors, so all
+      // processors make the same choice without further communication.
+      //
+      // Returns true if the dipole fields have changed.
+      //------------------------------------------------------------------------
+      bool adaptive_update_field(const uint64_t sim_time){
+
+         num_field_checks++;
+
+         // full update on first call or after update_rate time steps
+         if(update_mag_array_x.size() == 0 || sim_time - last_full_update_time >= uint64_t(dipole::update_rate)){
+
+            update_field();
+
+            update_mag_array_x = cells::mag_array_x;
+            update_mag_array_y = cells::mag_array_y;
+            update_mag_array_z = cells::mag_array_z;
+
+            last_full_update_time = sim_time;
+            num_full_updates++;
+
+            return true;
+
+         }
+
+         // find cells where the moment has changed by more than tolerance
+         std::vector<int> changed_cells;
+         int num_magnetic_cells = 0;
+
+         const double tolerance_sq = update_tolerance*update_tolerance;
+
+         for(int i = 0; i < cells_num_cells; i++){
+            if(cells_num_atoms_in_cell[i] > 0){
+
+               num_magnetic_cells++;
+
+               const double dmx = cells::mag_array_x[i] - update_mag_array_x[i];
+               const double dmy = cells::mag_array_y[i] - update_mag_array_y[i];
+               const double dmz = cells::mag_array_z[i] - update_mag_array_z[i];
+
+               // saturation moment of cell
+               const double ms = cells_pos_and_mom_array[4*i+3];
+
+               if(dmx*dmx + dmy*dmy + dmz*dmz > tolerance_sq*ms*ms) changed_cells.push_back(i);
+
+            }
+         }
+
+         if(changed_cells.size() == 0){
+            num_skipped_updates++;
+            return false;
+         }
+
+         // incremental update if tensor is stored and less than a quarter of cells have changed
+         if(full_tensor_storage() && 4*changed_cells.size() <= size_t(num_magnetic_cells)){
+
+            incremental_update_field(changed_cells);
+
+            num_incremental_updates++;
+
+         }
+         else{
+
+            update_field();
+
+            update_mag_array_x = cells::mag_array_x;
+            update_mag_array_y = cells::mag_array_y;
+            update_mag_array_z = cells::mag_array_z;
+
+            last_full_update_time = sim_time;
+            num_full_updates++;
+
+         }
+
+         return true;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to add the change in dipole field from the cells whose
+      // magnetisation has changed since the last update, using the stored
+      // tensor. Unchanged cells keep their contribution from the last update.
+      //------------------------------------------------------------------------
+      void incremental_update_field(const std::vector<int>& changed_cells){
+
+         // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
+         const double imuB = 1.0/9.27400915e-24;
+
+         const int num_changed = changed_cells.size();
+
+         // normalised change in moment of changed cells
+         std::vector<double> dmx(num_changed);
+         std::vector<double> dmy(num_changed);
+         std::vector<double> dmz(num_changed);
+
+         // index of cells in changed list (-1 if unchanged)
+         std::vector<int> changed_index(cells_num_cells, -1);
+
+         for(int c = 0; c < num_changed; c++){
+            const int j = changed_cells[c];
+            dmx[c] = (cells::mag_array_x[j] - update_mag_array_x[j])*imuB;
+            dmy[c] = (cells::mag_array_y[j] - update_mag_array_y[j])*imuB;
+            dmz[c] = (cells::mag_array_z[j] - update_mag_array_z[j])*imuB;
+            changed_index[j] = c;
+         }
+
+         // loop over local cells
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+
+            if(cells_num_atoms_in_cell[i] > 0){
+
+               double hx = 0.0;
+               double hy = 0.0;
+               double hz = 0.0;
+
+               for(int c = 0; c < num_changed; c++){
+                  const int j = changed_cells[c];
+                  hx += dmx[c]*rij_tensor_xx[lc][j] + dmy[c]*rij_tensor_xy[lc][j] + dmz[c]*rij_tensor_xz[lc][j];
+                  hy += dmx[c]*rij_tensor_xy[lc][j] + dmy[c]*rij_tensor_yy[lc][j] + dmz[c]*rij_tensor_yz[lc][j];
+                  hz += dmx[c]*rij_tensor_xz[lc][j] + dmy[c]*rij_tensor_yz[lc][j] + dmz[c]*rij_tensor_zz[lc][j];
+               }
+
+               // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30 (see update.cpp)
+               dipole::cells_field_array_x[i] += hx * 9.27400915e-01;
+               dipole::cells_field_array_y[i] += hy * 9.27400915e-01;
+               dipole::cells_field_array_z[i] += hz * 9.27400915e-01;
+
+               // Change in self demagnetisation if cell has changed
+               const int c = changed_index[i];
+               if(c >= 0){
+                  const double self_demag = 8.0*M_PI/(3.0*cells_volume_array[i]);
+                  hx -= 0.5*self_demag*dmx[c];
+                  hy -= 0.5*self_demag*dmy[c];
+                  hz -= 0.5*self_demag*dmz[c];
+               }
+
+               dipole::cells_mu0Hd_field_array_x[i] += hx * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_y[i] += hy * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_z[i] += hz * 9.27400915e-01;
+
+            }
+         }
+
+         // save magnetisation of changed cells
+         for(int c = 0; c < num_changed; c++){
+            const int j = changed_cells[c];
+            update_mag_array_x[j] = cells::mag_array_x[j];
+            update_mag_array_y[j] = cells::mag_array_y[j];
+            update_mag_array_z[j] = cells::mag_array_z[j];
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of dipole namespace
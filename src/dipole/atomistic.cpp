@@ -0,0 +1,443 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "material.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Atomistic dipole solver
+//
+// Dipole fields between atoms in macrocells within the cutoff range are
+// calculated from the exact atomistic dipole-dipole interaction, and the
+// field from more distant cells from the fft macrocell far field. The pair
+// tensors depend only on the displacement between atoms, which takes few
+// distinct values on a crystal lattice, and so each distinct tensor is stored
+// once with an index for each pair. In parallel, atoms in cells within the
+// cutoff range of another processor are exchanged at every update.
+//------------------------------------------------------------------------------
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to update atomic dipole fields from atomistic near field and
+      // fft far field. Requires far field from latest update of cell fields.
+      //------------------------------------------------------------------------
+      void update_atomistic_field(){
+
+         #ifdef MPICF
+            const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+         #else
+            const int num_local_atoms = dipole::internal::num_atoms;
+         #endif
+
+         const double imuB = 1.0/9.27400915e-24;
+
+         // moments of local and imported atoms in Bohr magnetons
+         std::vector<double> moment(3*atomistic_num_sources, 0.0);
+
+         for(int atom = 0; atom < num_local_atoms; atom++){
+            const int type = atom_type_array[atom];
+            if(mp::material[type].non_magnetic != 0) continue;
+            const double mu = mp::material[type].mu_s_SI*imuB;
+            moment[3*atom+0] = atoms::x_spin_array[atom]*mu;
+            moment[3*atom+1] = atoms::y_spin_array[atom]*mu;
+            moment[3*atom+2] = atoms::z_spin_array[atom]*mu;
+         }
+
+         #ifdef MPICF
+
+            // exchange moments of atoms in cells within cutoff range with neighbouring cpus only
+            const int num_partners = atomistic_partner_array.size();
+            std::vector<double> send_moment(3*atomistic_send_atom_array.size()+1, 0.0);
+            std::vector<MPI_Request> requests(2*num_partners);
+
+            for(int q = 0; q < num_partners; q++){
+               const int num_recv = atomistic_recv_start_index[q+1] - atomistic_recv_start_index[q];
+               double* recv_moment = &moment[0] + 3*(num_local_atoms + atomistic_recv_start_index[q]);
+               MPI_Irecv(recv_moment, 3*num_recv, MPI_DOUBLE, atomistic_partner_array[q], 73, MPI_COMM_WORLD, &requests[q]);
+            }
+
+            for(unsigned int n = 0; n < atomistic_send_atom_array.size(); n++){
+               const int atom = atomistic_send_atom_array[n];
+               for(int d = 0; d < 3; d++) send_moment[3*n+d] = moment[3*atom+d];
+            }
+
+            for(int q = 0; q < num_partners; q++){
+               const int num_send = atomistic_send_start_index[q+1] - atomistic_send_start_index[q];
+               MPI_Isend(&send_moment[3*atomistic_send_start_index[q]], 3*num_send, MPI_DOUBLE, atomistic_partner_array[q], 73, MPI_COMM_WORLD, &requests[num_partners+q]);
+            }
+
+            if(num_partners > 0) MPI_Waitall(2*num_partners, &requests[0], MPI_STATUSES_IGNORE);
+
+         #endif
+
+         const int num_targets = atomistic_target_array.size();
+
+         #pragma omp parallel for schedule(static)
+         for(int t = 0; t < num_targets; t++){
+
+            const int atom = atomistic_target_array[t];
+            const int cell = atom_cell_id_array[atom];
+
+            // far field from macrocells beyond the cutoff range
+            double h[3];
+            fft_far_field(cell, h);
+
+            // atomistic near field
+            for(int n = atomistic_pair_start_index[t]; n < atomistic_pair_start_index[t+1]; n++){
+               const double* m = &moment[3*atomistic_pair_source_array[n]];
+               const double* T = &atomistic_tensor_array[6*atomistic_pair_tensor_array[n]];
+               h[0] += T[0]*m[0] + T[1]*m[1] + T[2]*m[2];
+               h[1] += T[1]*m[0] + T[3]*m[1] + T[4]*m[2];
+               h[2] += T[2]*m[0] + T[4]*m[1] + T[5]*m[2];
+            }
+
+            // Self demagnetisation factor multiplying m(i)
+            const double self_demag = 8.0*M_PI/(3.0*cells_volume_array[cell]);
+            const double mx = cells::mag_array_x[cell]*imuB;
+            const double my = cells::mag_array_y[cell]*imuB;
+            const double mz = cells::mag_array_z[cell]*imuB;
+
+            // Multiply the B-field by mu_B * mu_0/(4*pi) /1e-30 (see update.cpp)
+            dipole::atom_dipolar_field_array_x[atom] = h[0]*9.27400915e-01;
+            dipole::atom_dipolar_field_array_y[atom] = h[1]*9.27400915e-01;
+            dipole::atom_dipolar_field_array_z[atom] = h[2]*9.27400915e-01;
+
+            dipole::atom_mu0demag_field_array_x[atom] = (h[0] - 0.5*self_demag*mx)*9.27400915e-01;
+            dipole::atom_mu0demag_field_array_y[atom] = (h[1] - 0.5*self_demag*my)*9.27400915e-01;
+            dipole::atom_mu0demag_field_array_z[atom] = (h[2] - 0.5*self_demag*mz)*9.27400915e-01;
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to initialise atomistic dipole solver, determining pairs of
+      // atoms in cells within the cutoff range and their dipole tensors
+      //------------------------------------------------------------------------
+      void initialize_atomistic_solver(std::vector<int>& atom_type_array,
+                                       std::vector<int>& atom_cell_id_array,
+                                       std::vector<double>& atom_coords_x,
+                                       std::vector<double>& atom_coords_y,
+                                       std::vector<double>& atom_coords_z){
+
+         zlog << zTs() << "Precalculating atomistic dipole tensors for atomistic solver... " << std::endl;
+         std::cout     << "Precalculating atomistic dipole tensors for atomistic solver"     << std::flush;
+
+         // instantiate timer
+         vutil::vtimer_t timer;
+
+         // start timer
+         timer.start();
+
+         #ifdef MPICF
+            const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+         #else
+            const int num_local_atoms = dipole::internal::num_atoms;
+         #endif
+
+         const int n[3] = {cells::num_cells_x, cells::num_cells_y, cells::num_cells_z};
+         const int range = int(floor(dipole::cutoff));
+         const double cutoff_sq = dipole::cutoff*dipole::cutoff;
+
+         // cell offsets within cutoff range
+         std::vector<int> offsets;
+         for(int dx = -range; dx <= range; dx++){
+            for(int dy = -range; dy <= range; dy++){
+               for(int dz = -range; dz <= range; dz++){
+                  if(double(dx*dx + dy*dy + dz*dz) > cutoff_sq) continue;
+                  offsets.push_back(dx);
+                  offsets.push_back(dy);
+                  offsets.push_back(dz);
+               }
+            }
+         }
+         const int num_offsets = offsets.size()/3;
+
+         //------------------------------------------------------
+         // Source atoms (local atoms and atoms from other cpus)
+         //------------------------------------------------------
+         std::vector<int> source_cell(atom_cell_id_array.begin(), atom_cell_id_array.begin() + num_local_atoms);
+         std::vector<double> source_coords(3*num_local_atoms);
+         for(int atom = 0; atom < num_local_atoms; atom++){
+            source_coords[3*atom+0] = atom_coords_x[atom];
+            source_coords[3*atom+1] = atom_coords_y[atom];
+            source_coords[3*atom+2] = atom_coords_z[atom];
+         }
+
+         #ifdef MPICF
+
+            // cells containing local atoms
+            std::vector<int> local_cell(cells_num_cells, 0);
+            for(int atom = 0; atom < num_local_atoms; atom++) local_cell[atom_cell_id_array[atom]] = 1;
+            std::vector<int> local_cell_array;
+            for(int i = 0; i < cells_num_cells; i++) if(local_cell[i] != 0) local_cell_array.push_back(i);
+            const int num_local_cells = local_cell_array.size();
+            local_cell_array.push_back(0); // pad to avoid empty buffer
+
+            // gather local cells of all cpus to determine the cpus owning each cell (once at setup)
+            std::vector<int> cell_counts(vmpi::num_processors, 0);
+            std::vector<int> cell_displacements(vmpi::num_processors, 0);
+            MPI_Allgather(&num_local_cells, 1, MPI_INT, &cell_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+            for(int p = 1; p < vmpi::num_processors; p++) cell_displacements[p] = cell_displacements[p-1] + cell_counts[p-1];
+            const int num_gathered = cell_displacements[vmpi::num_processors-1] + cell_counts[vmpi::num_processors-1];
+
+            std::vector<int> gathered_cell(num_gathered+1, 0);
+            MPI_Allgatherv(&local_cell_array[0], num_local_cells, MPI_INT, &gathered_cell[0], &cell_counts[0], &cell_displacements[0], MPI_INT, MPI_COMM_WORLD);
+
+            std::vector<int> owner_start_index(cells_num_cells+1, 0);
+            for(int g = 0; g < num_gathered; g++) owner_start_index[gathered_cell[g]+1]++;
+            for(int i = 0; i < cells_num_cells; i++) owner_start_index[i+1] += owner_start_index[i];
+            std::vector<int> owner_array(num_gathered);
+            std::vector<int> owner_count(cells_num_cells, 0);
+            for(int p = 0; p < vmpi::num_processors; p++){
+               for(int g = cell_displacements[p]; g < cell_displacements[p] + cell_counts[p]; g++){
+                  const int cell = gathered_cell[g];
+                  owner_array[owner_start_index[cell] + owner_count[cell]] = p;
+                  owner_count[cell]++;
+               }
+            }
+
+            // other cpus owning cells within cutoff range of each local cell. The
+            // relation is symmetric, so these cpus both need the atoms in the local
+            // cell and hold atoms in cells needed by it.
+            std::vector< std::vector<int> > cell_partners(cells_num_cells);
+            std::vector<int> is_partner(vmpi::num_processors, 0);
+            std::vector<int> marked(vmpi::num_processors, -1);
+            for(int l = 0; l < num_local_cells; l++){
+               const int i = local_cell_array[l];
+               const int ci[3] = {i/(n[1]*n[2]), (i/n[2])%n[1], i%n[2]};
+               for(int o = 0; o < num_offsets; o++){
+                  const int cj[3] = {ci[0]+offsets[3*o+0], ci[1]+offsets[3*o+1], ci[2]+offsets[3*o+2]};
+                  if(cj[0] < 0 || cj[0] >= n[0] || cj[1] < 0 || cj[1] >= n[1] || cj[2] < 0 || cj[2] >= n[2]) continue;
+                  const int j = (cj[0]*n[1] + cj[1])*n[2] + cj[2];
+                  for(int k = owner_start_index[j]; k < owner_start_index[j+1]; k++){
+                     const int p = owner_array[k];
+                     if(p == vmpi::my_rank || marked[p] == i) continue;
+                     marked[p] = i;
+                     is_partner[p] = 1;
+                     cell_partners[i].push_back(p);
+                  }
+               }
+            }
+
+            // list of local atoms to send to each partner cpu (in rank order)
+            atomistic_partner_array.clear();
+            for(int p = 0; p < vmpi::num_processors; p++) if(is_partner[p] != 0) atomistic_partner_array.push_back(p);
+            const int num_partners = atomistic_partner_array.size();
+
+            std::vector<int> partner_index(vmpi::num_processors, -1);
+            for(int q = 0; q < num_partners; q++) partner_index[atomistic_partner_array[q]] = q;
+
+            std::vector< std::vector<int> > send_atoms(num_partners);
+            for(int atom = 0; atom < num_local_atoms; atom++){
+               const std::vector<int>& partners = cell_partners[atom_cell_id_array[atom]];
+               for(unsigned int k = 0; k < partners.size(); k++) send_atoms[partner_index[partners[k]]].push_back(atom);
+            }
+
+            atomistic_send_start_index.assign(1, 0);
+            atomistic_send_atom_array.clear();
+            for(int q = 0; q < num_partners; q++){
+               atomistic_send_atom_array.insert(atomistic_send_atom_array.end(), send_atoms[q].begin(), send_atoms[q].end());
+               atomistic_send_start_index.push_back(atomistic_send_atom_array.size());
+            }
+            const int num_send = atomistic_send_atom_array.size();
+
+            // exchange number of atoms with partner cpus
+            std::vector<int> num_recv_atoms(num_partners+1, 0);
+            std::vector<int> num_send_atoms(num_partners+1, 0);
+            std::vector<MPI_Request> requests(2*num_partners);
+            for(int q = 0; q < num_partners; q++){
+               num_send_atoms[q] = atomistic_send_start_index[q+1] - atomistic_send_start_index[q];
+               MPI_Irecv(&num_recv_atoms[q], 1, MPI_INT, atomistic_partner_array[q], 70, MPI_COMM_WORLD, &requests[q]);
+               MPI_Isend(&num_send_atoms[q], 1, MPI_INT, atomistic_partner_array[q], 70, MPI_COMM_WORLD, &requests[num_partners+q]);
+            }
+            if(num_partners > 0) MPI_Waitall(2*num_partners, &requests[0], MPI_STATUSES_IGNORE);
+
+            atomistic_recv_start_index.assign(num_partners+1, 0);
+            for(int q = 0; q < num_partners; q++) atomistic_recv_start_index[q+1] = atomistic_recv_start_index[q] + num_recv_atoms[q];
+            const int num_recv = atomistic_recv_start_index[num_partners];
+
+            // exchange cell and coordinates of atoms with partner cpus
+            std::vector<int> send_cell(num_send+1, 0);
+            std::vector<double> send_coords(3*num_send+1, 0.0);
+            for(int e = 0; e < num_send; e++){
+               const int atom = atomistic_send_atom_array[e];
+               send_cell[e] = atom_cell_id_array[atom];
+               send_coords[3*e+0] = atom_coords_x[atom];
+               send_coords[3*e+1] = atom_coords_y[atom];
+               send_coords[3*e+2] = atom_coords_z[atom];
+            }
+
+            std::vector<int> recv_cell(num_recv+1, 0);
+            std::vector<double> recv_coords(3*num_recv+1, 0.0);
+            requests.resize(4*num_partners);
+            for(int q = 0; q < num_partners; q++){
+               const int p = atomistic_partner_array[q];
+               const int rs = atomistic_recv_start_index[q];
+               const int ss = atomistic_send_start_index[q];
+               MPI_Irecv(&recv_cell[rs], num_recv_atoms[q], MPI_INT, p, 71, MPI_COMM_WORLD, &requests[4*q+0]);
+               MPI_Irecv(&recv_coords[3*rs], 3*num_recv_atoms[q], MPI_DOUBLE, p, 72, MPI_COMM_WORLD, &requests[4*q+1]);
+               MPI_Isend(&send_cell[ss], num_send_atoms[q], MPI_INT, p, 71, MPI_COMM_WORLD, &requests[4*q+2]);
+               MPI_Isend(&send_coords[3*ss], 3*num_send_atoms[q], MPI_DOUBLE, p, 72, MPI_COMM_WORLD, &requests[4*q+3]);
+            }
+            if(num_partners > 0) MPI_Waitall(4*num_partners, &requests[0], MPI_STATUSES_IGNORE);
+
+            // imported atoms follow local atoms as sources
+            for(int r = 0; r < num_recv; r++){
+               source_cell.push_back(recv_cell[r]);
+               for(int d = 0; d < 3; d++) source_coords.push_back(recv_coords[3*r+d]);
+            }
+
+         #endif
+
+         atomistic_num_sources = source_cell.size();
+
+         // list of source atoms in each cell
+         std::vector<int> cell_start_index(cells_num_cells+1, 0);
+         for(int s = 0; s < atomistic_num_sources; s++) cell_start_index[source_cell[s]+1]++;
+         for(int i = 0; i < cells_num_cells; i++) cell_start_index[i+1] += cell_start_index[i];
+         std::vector<int> cell_source_array(atomistic_num_sources);
+         std::vector<int> cell_count(cells_num_cells, 0);
+         for(int s = 0; s < atomistic_num_sources; s++){
+            const int cell = source_cell[s];
+            cell_source_array[cell_start_index[cell] + cell_count[cell]] = s;
+            cell_count[cell]++;
+         }
+
+         //------------------------------------------------------
+         // Determine atom pairs and distinct pair tensors
+         //------------------------------------------------------
+         atomistic_target_array.clear();
+         atomistic_pair_start_index.assign(1, 0);
+         atomistic_pair_source_array.clear();
+         atomistic_pair_tensor_array.clear();
+         atomistic_tensor_array.clear();
+
+         // map from displacement (in units of 1e-6 Angstroms) to tensor index
+         std::map<std::vector<long long>, int> tensor_map;
+         std::vector<long long> key(3);
+
+         for(int atom = 0; atom < num_local_atoms; atom++){
+
+            // print out progress to screen
+            if(fmod(ceil(atom),ceil(num_local_atoms)/10.0) == 0) std::cout << "." << std::flush;
+
+            const int cell = atom_cell_id_array[atom];
+            if(cells_num_atoms_in_cell[cell] == 0 || mp::material[atom_type_array[atom]].non_magnetic != 0) continue;
+
+            atomistic_target_array.push_back(atom);
+
+            const int ci[3] = {cell/(n[1]*n[2]), (cell/n[2])%n[1], cell%n[2]};
+
+            for(int o = 0; o < num_offsets; o++){
+
+               const int cj[3] = {ci[0]+offsets[3*o+0], ci[1]+offsets[3*o+1], ci[2]+offsets[3*o+2]};
+               if(cj[0] < 0 || cj[0] >= n[0] || cj[1] < 0 || cj[1] >= n[1] || cj[2] < 0 || cj[2] >= n[2]) continue;
+               const int j = (cj[0]*n[1] + cj[1])*n[2] + cj[2];
+
+               for(int c = cell_start_index[j]; c < cell_start_index[j+1]; c++){
+
+                  const int s = cell_source_array[c];
+                  if(s == atom) continue;
+
+                  const double rx = source_coords[3*s+0] - atom_coords_x[atom];
+                  const double ry = source_coords[3*s+1] - atom_coords_y[atom];
+                  const double rz = source_coords[3*s+2] - atom_coords_z[atom];
+
+                  key[0] = llround(rx*1.0e6);
+                  key[1] = llround(ry*1.0e6);
+                  key[2] = llround(rz*1.0e6);
+
+                  std::map<std::vector<long long>, int>::iterator it = tensor_map.find(key);
+                  int tensor_index = 0;
+
+                  if(it == tensor_map.end()){
+
+                     const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                     // define unitarian distance vectors
+                     const double ex = rx*rij;
+                     const double ey = ry*rij;
+                     const double ez = rz*rij;
+
+                     const double rij3 = (rij*rij*rij); // Angstroms
+
+                     tensor_index = atomistic_tensor_array.size()/6;
+                     tensor_map[key] = tensor_index;
+
+                     atomistic_tensor_array.push_back((3.0*ex*ex - 1.0)*rij3);
+                     atomistic_tensor_array.push_back( 3.0*ex*ey       *rij3);
+                     atomistic_tensor_array.push_back( 3.0*ex*ez       *rij3);
+                     atomistic_tensor_array.push_back((3.0*ey*ey - 1.0)*rij3);
+                     atomistic_tensor_array.push_back( 3.0*ey*ez       *rij3);
+                     atomistic_tensor_array.push_back((3.0*ez*ez - 1.0)*rij3);
+
+                  }
+                  else tensor_index = it->second;
+
+                  atomistic_pair_source_array.push_back(s);
+                  atomistic_pair_tensor_array.push_back(tensor_index);
+
+               }
+            }
+
+            atomistic_pair_start_index.push_back(atomistic_pair_source_array.size());
+
+         }
+
+         // hold parallel calculation until all processors have completed the dipole calculation
+         vmpi::barrier();
+
+         // stop timer
+         timer.stop();
+
+         std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
+         zlog << zTs() << "Precalculation of atomistic dipole tensors complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
+
+         const double num_pairs = atomistic_pair_source_array.size();
+         const double num_tensors = atomistic_tensor_array.size()/6;
+         const double memory = (num_pairs*2.0*4.0 + num_tensors*6.0*8.0 + double(atomistic_target_array.size())*2.0*4.0)/1.0e6;
+
+         zlog << zTs() << "Atomistic dipole solver uses " << num_pairs << " atom pairs with " << num_tensors << " distinct tensors requiring "
+              << memory << " MB of RAM compared to " << num_pairs*6.0*8.0/1.0e6 << " MB for storing all pair tensors" << std::endl;
+         std::cout << "Atomistic dipole solver requires " << memory << " MB of RAM for " << num_pairs << " atom pairs" << std::endl;
+
+         #ifdef MPICF
+            zlog << zTs() << "Number of atoms exchanged for atomistic dipole solver with " << atomistic_partner_array.size() << " neighbouring processors: "
+                 << atomistic_send_atom_array.size() << " sent, " << atomistic_recv_start_index.back() << " received" << std::endl;
+         #endif
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
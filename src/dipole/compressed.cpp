@@ -0,0 +1,344 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to add field from explicitly stored tensors of a local cell
+      //------------------------------------------------------------------------
+      void add_explicit_tensor_field(const int lc, const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz, double h[3]){
+
+         for(int n = explicit_tensor_start_index[lc]; n < explicit_tensor_start_index[lc+1]; n++){
+            const int j = explicit_tensor_cell_array[n];
+            const double* t = &explicit_tensor_array[6*n];
+            h[0] += t[0]*mx[j] + t[1]*my[j] + t[2]*mz[j];
+            h[1] += t[1]*mx[j] + t[3]*my[j] + t[4]*mz[j];
+            h[2] += t[2]*mx[j] + t[4]*my[j] + t[5]*mz[j];
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the dipole tensor T.m for all local cells from
+      // normalised cell moments m (all cells) with compressed tensors. Far
+      // field interactions between regular cells are summed from the
+      // displacement table, with a contiguous inner loop along z.
+      //------------------------------------------------------------------------
+      void compressed_tensor_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                                   std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         const int n[3] = {cells::num_cells_x, cells::num_cells_y, cells::num_cells_z};
+         const int nd[3] = {2*n[0]-1, 2*n[1]-1, 2*n[2]-1};
+
+         // moments of regular cells, for which the displacement table is used
+         std::vector<double> rmx(cells_num_cells, 0.0);
+         std::vector<double> rmy(cells_num_cells, 0.0);
+         std::vector<double> rmz(cells_num_cells, 0.0);
+         for(int j = 0; j < cells_num_cells; j++){
+            if(regular_cell_array[j]){
+               rmx[j] = mx[j];
+               rmy[j] = my[j];
+               rmz[j] = mz[j];
+            }
+         }
+
+         #pragma omp parallel for schedule(static)
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+            double h[3] = {0.0, 0.0, 0.0};
+
+            if(cells_num_atoms_in_cell[i] > 0){
+
+               if(regular_cell_array[i]){
+
+                  const int ci[3] = {i/(n[1]*n[2]), (i/n[2])%n[1], i%n[2]};
+
+                  for(int jx = 0; jx < n[0]; jx++){
+                     for(int jy = 0; jy < n[1]; jy++){
+
+                        // displacement table row for cells (jx, jy, 0 .. nz-1)
+                        const int t = ((jx - ci[0] + n[0]-1)*nd[1] + (jy - ci[1] + n[1]-1))*nd[2] + (n[2]-1 - ci[2]);
+                        const int j0 = (jx*n[1] + jy)*n[2];
+
+                        const double* txx = &displacement_tensor_xx[t];
+                        const double* txy = &displacement_tensor_xy[t];
+                        const double* txz = &displacement_tensor_xz[t];
+                        const double* tyy = &displacement_tensor_yy[t];
+                        const double* tyz = &displacement_tensor_yz[t];
+                        const double* tzz = &displacement_tensor_zz[t];
+
+                        const double* mxj = &rmx[j0];
+                        const double* myj = &rmy[j0];
+                        const double* mzj = &rmz[j0];
+
+                        double sx = 0.0;
+                        double sy = 0.0;
+                        double sz = 0.0;
+
+                        #pragma omp simd reduction(+:sx,sy,sz)
+                        for(int jz = 0; jz < n[2]; jz++){
+                           sx += txx[jz]*mxj[jz] + txy[jz]*myj[jz] + txz[jz]*mzj[jz];
+                           sy += txy[jz]*mxj[jz] + tyy[jz]*myj[jz] + tyz[jz]*mzj[jz];
+                           sz += txz[jz]*mxj[jz] + tyz[jz]*myj[jz] + tzz[jz]*mzj[jz];
+                        }
+
+                        h[0] += sx;
+                        h[1] += sy;
+                        h[2] += sz;
+
+                     }
+                  }
+               }
+
+               add_explicit_tensor_field(lc, mx, my, mz, h);
+
+            }
+
+            hx[lc] = h[0];
+            hy[lc] = h[1];
+            hz[lc] = h[2];
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to initialise compressed storage of dipole tensors.
+      //
+      // Cells whose centre of mass has the same offset from the cell origin
+      // as a full cell are regular, and the bare macrocell tensor between two
+      // regular cells depends only on their displacement on the macrocell
+      // grid. These far field tensors are stored once per displacement. Near
+      // field tensors and tensors involving irregular (partially filled)
+      // cells are calculated with the tensor method and stored explicitly for
+      // each pair. The fields are identical to the full tensor storage.
+      //------------------------------------------------------------------------
+      void initialize_compressed_tensors(const double cells_macro_cell_size,
+                                         std::vector <int>& cells_num_atoms_in_cell,
+                                         std::vector<double>& cells_pos_and_mom_array,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+
+         zlog << zTs() << "Precalculating compressed rij matrix for dipole calculation using tensor solver... " << std::endl;
+         std::cout     << "Precalculating compressed rij matrix for dipole calculation using tensor solver"     << std::flush;
+
+         // instantiate timer
+         vutil::vtimer_t timer;
+
+         // start timer
+         timer.start();
+
+         const int n[3] = {cells::num_cells_x, cells::num_cells_y, cells::num_cells_z};
+         const int nd[3] = {2*n[0]-1, 2*n[1]-1, 2*n[2]-1};
+         const double cs = cells_macro_cell_size;
+
+         // pairs closer than the cutoff (with tolerance for rounding of the
+         // centre of mass distance) are always stored explicitly
+         const double near_sq = (dipole::cutoff + 1.0e-6)*(dipole::cutoff + 1.0e-6);
+
+         //------------------------------------------------------
+         // Determine regular cells
+         //------------------------------------------------------
+
+         // reference offset from cell with largest number of atoms
+         int ref = -1;
+         for(int i = 0; i < cells_num_cells; i++){
+            if(cells_num_atoms_in_cell[i] > 0 && (ref < 0 || cells_num_atoms_in_cell[i] > cells_num_atoms_in_cell[ref])) ref = i;
+         }
+
+         regular_cell_array.assign(cells_num_cells, 0);
+         int num_regular_cells = 0;
+
+         if(ref >= 0){
+
+            const int cr[3] = {ref/(n[1]*n[2]), (ref/n[2])%n[1], ref%n[2]};
+            double ref_offset[3];
+            for(int d = 0; d < 3; d++) ref_offset[d] = cells_pos_and_mom_array[4*ref+d] - double(cr[d])*cs;
+
+            for(int i = 0; i < cells_num_cells; i++){
+               if(cells_num_atoms_in_cell[i] == 0) continue;
+               const int ci[3] = {i/(n[1]*n[2]), (i/n[2])%n[1], i%n[2]};
+               bool regular = true;
+               for(int d = 0; d < 3; d++){
+                  const double offset = cells_pos_and_mom_array[4*i+d] - double(ci[d])*cs;
+                  if(fabs(offset - ref_offset[d]) > 1.0e-6) regular = false;
+               }
+               if(regular){
+                  regular_cell_array[i] = 1;
+                  num_regular_cells++;
+               }
+            }
+         }
+
+         //------------------------------------------------------
+         // Calculate far field tensors for each displacement
+         //------------------------------------------------------
+         const int num_displacements = nd[0]*nd[1]*nd[2];
+
+         displacement_tensor_xx.assign(num_displacements, 0.0);
+         displacement_tensor_xy.assign(num_displacements, 0.0);
+         displacement_tensor_xz.assign(num_displacements, 0.0);
+         displacement_tensor_yy.assign(num_displacements, 0.0);
+         displacement_tensor_yz.assign(num_displacements, 0.0);
+         displacement_tensor_zz.assign(num_displacements, 0.0);
+
+         for(int a = 0; a < nd[0]; a++){
+            for(int b = 0; b < nd[1]; b++){
+               for(int c = 0; c < nd[2]; c++){
+
+                  const int d[3] = {a - (n[0]-1), b - (n[1]-1), c - (n[2]-1)};
+                  if(double(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) <= near_sq) continue;
+
+                  const double rx = double(d[0])*cs;
+                  const double ry = double(d[1])*cs;
+                  const double rz = double(d[2])*cs;
+
+                  const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                  // define unitarian distance vectors
+                  const double ex = rx*rij;
+                  const double ey = ry*rij;
+                  const double ez = rz*rij;
+
+                  const double rij3 = (rij*rij*rij); // Angstroms
+
+                  const int index = (a*nd[1] + b)*nd[2] + c;
+
+                  displacement_tensor_xx[index] = ((3.0*ex*ex - 1.0)*rij3);
+                  displacement_tensor_xy[index] = ( 3.0*ex*ey      )*rij3 ;
+                  displacement_tensor_xz[index] = ( 3.0*ex*ez      )*rij3 ;
+
+                  displacement_tensor_yy[index] = ((3.0*ey*ey - 1.0)*rij3);
+                  displacement_tensor_yz[index] = ( 3.0*ey*ez      )*rij3 ;
+                  displacement_tensor_zz[index] = ((3.0*ez*ez - 1.0)*rij3);
+
+               }
+            }
+         }
+
+         //------------------------------------------------------
+         // Calculate explicit tensors for local cells
+         //------------------------------------------------------
+
+         // use first row of tensor arrays as workspace
+         rij_tensor_xx.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_zz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+
+         explicit_tensor_start_index.assign(cells_num_local_cells+1, 0);
+         explicit_tensor_cell_array.clear();
+         explicit_tensor_array.clear();
+
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            // print out progress to screen
+            if(fmod(ceil(lc),ceil(cells_num_local_cells)/10.0) == 0) std::cout << "." << std::flush;
+
+            explicit_tensor_start_index[lc] = explicit_tensor_cell_array.size();
+
+            const int i = cells::cell_id_array[lc];
+            if(cells_num_atoms_in_cell[i] == 0) continue;
+
+            const int ci[3] = {i/(n[1]*n[2]), (i/n[2])%n[1], i%n[2]};
+
+            for(int j = 0; j < cells_num_cells; j++){
+
+               if(cells_num_atoms_in_cell[j] == 0) continue;
+
+               const int dx = j/(n[1]*n[2]) - ci[0];
+               const int dy = (j/n[2])%n[1] - ci[1];
+               const int dz = j%n[2] - ci[2];
+
+               const bool near = double(dx*dx + dy*dy + dz*dz) <= near_sq;
+               if(regular_cell_array[i] && regular_cell_array[j] && !near) continue;
+
+               if(i == j) compute_intra_tensor(i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+               else compute_inter_tensor(cells_macro_cell_size, i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+               explicit_tensor_cell_array.push_back(j);
+               explicit_tensor_array.push_back(rij_tensor_xx[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_xy[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_xz[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_yy[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_yz[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_zz[0][j]);
+
+            }
+         }
+
+         explicit_tensor_start_index[cells_num_local_cells] = explicit_tensor_cell_array.size();
+
+         // hold parallel calculation until all processors have completed the dipole calculation
+         vmpi::barrier();
+
+         // stop timer
+         timer.stop();
+
+         std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
+         zlog << zTs() << "Precalculation of compressed rij matrix for dipole calculation complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
+
+         //------------------------------------------------------
+         // Report memory use
+         //------------------------------------------------------
+         const double table_memory = 6.0*8.0*double(num_displacements)/1.0e6;
+         const double explicit_memory = double(explicit_tensor_cell_array.size())*(6.0*8.0 + 4.0)/1.0e6;
+         const double full_memory = 6.0*8.0*double(cells_num_local_cells)*double(cells_num_cells)/1.0e6;
+
+         zlog << zTs() << "Number of regular cells for compressed dipole tensors: " << num_regular_cells << std::endl;
+         zlog << zTs() << "Compressed dipole tensors require " << table_memory + explicit_memory << " MB of RAM (" << table_memory << " MB for "
+              << num_displacements << " cell displacements and " << explicit_memory << " MB for " << explicit_tensor_cell_array.size()
+              << " explicit cell pairs) compared to " << full_memory << " MB for full storage" << std::endl;
+         std::cout << "Compressed dipole tensors require " << table_memory + explicit_memory << " MB of RAM compared to " << full_memory << " MB for full storage" << std::endl;
+
+         // compare with full tensor storage for a sample of cells
+         compare_with_tensor_solver(cells_macro_cell_size, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+         // release workspace
+         rij_tensor_xx.clear();
+         rij_tensor_xy.clear();
+         rij_tensor_xz.clear();
+         rij_tensor_yy.clear();
+         rij_tensor_yz.clear();
+         rij_tensor_zz.clear();
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
@@ -9,6 +9,7 @@
 //
 
 // C++ standard library headers
+#include <complex>
 
 // Vampire headers
 #include "dipole.hpp"
@@ -57,6 +58,17 @@ namespace dipole{
 
       int update_time=-1; /// last update time
 
+      // variables for adaptive field updates
+      double update_tolerance = 0.0; /// maximum change in cell moment between updates (0 = fixed update rate)
+      uint64_t last_full_update_time = 0; /// time of last full field update
+      std::vector < double > update_mag_array_x; /// cell magnetisation used for last field update
+      std::vector < double > update_mag_array_y;
+      std::vector < double > update_mag_array_z;
+      uint64_t num_field_checks = 0; /// number of time steps with adaptive field check
+      uint64_t num_full_updates = 0; /// number of full field updates
+      uint64_t num_incremental_updates = 0; /// number of incremental field updates
+      uint64_t num_skipped_updates = 0; /// number of skipped field updates
+
       // solver to be used for dipole method
       dipole::internal::solver_t solver = dipole::internal::tensor; // default is tensor method
 
@@ -83,6 +95,61 @@ namespace dipole{
       std::vector<double> cells_pos_and_mom_array;
       std::vector < int > proc_cell_index_array1D;
 
+      // variables for fft solver
+      int fft_num_cells[3] = {0, 0, 0}; /// number of macrocells in x,y,z
+      int fft_grid_size[3] = {0, 0, 0}; /// size of zero padded fft grid in x,y,z
+      std::vector < std::vector < std::complex<double> > > fft_twiddle_array; /// fft twiddle factors for x,y,z
+      std::vector < double > fft_kernel_xx; /// fourier transform of far field dipole tensor
+      std::vector < double > fft_kernel_xy;
+      std::vector < double > fft_kernel_xz;
+      std::vector < double > fft_kernel_yy;
+      std::vector < double > fft_kernel_yz;
+      std::vector < double > fft_kernel_zz;
+      std::vector < std::complex<double> > fft_mx_array; /// fourier transformed cell magnetisation and field
+      std::vector < std::complex<double> > fft_my_array;
+      std::vector < std::complex<double> > fft_mz_array;
+
+      // variables for compressed tensor storage
+      bool compressed_tensors = false; /// flag to store tensors by cell displacement
+      std::vector < double > displacement_tensor_xx; /// bare macrocell tensor for each cell displacement
+      std::vector < double > displacement_tensor_xy;
+      std::vector < double > displacement_tensor_xz;
+      std::vector < double > displacement_tensor_yy;
+      std::vector < double > displacement_tensor_yz;
+      std::vector < double > displacement_tensor_zz;
+      std::vector < int > regular_cell_array; /// flag for cells with regular centre of mass offset
+
+      // variables for hierarchical solver
+      double hierarchical_opening_angle = 0.5; /// maximum ratio of node size to separation for multipole interactions
+      int hierarchical_num_levels = 0; /// number of levels in octree
+      std::vector < int > hierarchical_node_cell_array; /// cell id of leaf nodes (-1 for other nodes)
+      std::vector < int > hierarchical_node_parent_array; /// parent of each node (-1 for root)
+      std::vector < int > hierarchical_node_child_start_index; /// start index of children for each node
+      std::vector < int > hierarchical_node_child_array; /// children of each node
+      std::vector < int > hierarchical_node_local_array; /// flag for nodes containing local cells
+      std::vector < double > hierarchical_node_centre_array; /// centre of each node (3 components)
+      std::vector < double > hierarchical_node_radius_array; /// radius enclosing all cells in each node
+      std::vector < int > hierarchical_cell_node_array; /// leaf node of each cell
+      std::vector < int > hierarchical_interaction_start_index; /// start index of multipole interactions for each node
+      std::vector < int > hierarchical_interaction_array; /// source node of each multipole interaction
+
+      // variables for atomistic solver
+      int atomistic_num_sources = 0; /// number of local and imported atoms
+      std::vector < int > atomistic_target_array; /// local atoms with atomistic near field
+      std::vector < int > atomistic_pair_start_index; /// start index of atom pairs for each target atom
+      std::vector < int > atomistic_pair_source_array; /// source atom of each pair
+      std::vector < int > atomistic_pair_tensor_array; /// tensor index of each pair
+      std::vector < double > atomistic_tensor_array; /// distinct pair tensors (6 components)
+      std::vector < int > atomistic_partner_array; /// neighbouring processors exchanging atoms
+      std::vector < int > atomistic_send_start_index; /// start index of sent atoms for each partner processor
+      std::vector < int > atomistic_send_atom_array; /// local atoms sent to partner processors
+      std::vector < int > atomistic_recv_start_index; /// start index of received atoms for each partner processor
+
+      // explicitly stored tensors for near field and irregular cell pairs (fft, compressed tensors and hierarchical)
+      std::vector < int > explicit_tensor_start_index; /// start index of explicit tensors for each local cell
+      std::vector < int > explicit_tensor_cell_array; /// interacting cell for each explicit tensor
+      std::vector < double > explicit_tensor_array; /// explicit tensors (6 components)
+
       //------------------------------------------------------------------------
       // Shared functions inside dipole module
       //------------------------------------------------------------------------
@@ -0,0 +1,557 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to calculate size of fft grid in one dimension, the smallest
+      // power of two which holds all cell separations without aliasing
+      //------------------------------------------------------------------------
+      int fft_padded_size(const int n){
+         int size = 1;
+         while(size < 2*n-1) size *= 2;
+         return size;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate twiddle factors exp(-2 pi i k/n) for an fft of
+      // length n
+      //------------------------------------------------------------------------
+      std::vector < std::complex<double> > fft_twiddle_factors(const int n){
+         std::vector < std::complex<double> > twiddle(std::max(n/2,1));
+         for(int k = 0; k < n/2; k++) twiddle[k] = std::complex<double>(cos(2.0*M_PI*double(k)/double(n)), -sin(2.0*M_PI*double(k)/double(n)));
+         return twiddle;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to convert index along padded fft grid dimension to a cell
+      // separation. Returns false for indices only used for zero padding.
+      //------------------------------------------------------------------------
+      bool fft_separation(const int index, const int n, const int size, int& separation){
+         if(index < n){
+            separation = index;
+            return true;
+         }
+         if(index > size - n){
+            separation = index - size;
+            return true;
+         }
+         return false;
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate index in fft grid from global cell id
+      //------------------------------------------------------------------------
+      inline int fft_index(const int cell){
+         const int ny = fft_num_cells[1];
+         const int nz = fft_num_cells[2];
+         const int x = cell/(ny*nz);
+         const int y = (cell/nz)%ny;
+         const int z = cell%nz;
+         return (x*fft_grid_size[1] + y)*fft_grid_size[2] + z;
+      }
+
+      //------------------------------------------------------------------------
+      // In place radix-2 fast Fourier transform of length n (power of two)
+      //------------------------------------------------------------------------
+      void fft_1d(std::complex<double>* data, const int n, const std::vector < std::complex<double> >& twiddle, const bool inverse){
+
+         // bit reversal permutation
+         for(int i = 1, j = 0; i < n; i++){
+            int bit = n >> 1;
+            for(; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if(i < j) std::swap(data[i], data[j]);
+         }
+
+         // sign of imaginary part of twiddle factors
+         const double sign = inverse ? -1.0 : 1.0;
+
+         // butterflies (complex products written out to avoid slow library calls)
+         for(int len = 2; len <= n; len <<= 1){
+            const int half = len/2;
+            const int step = n/len;
+            for(int i = 0; i < n; i += len){
+               for(int k = 0; k < half; k++){
+                  const double wr = twiddle[k*step].real();
+                  const double wi = sign*twiddle[k*step].imag();
+                  const double dr = data[i+k+half].real();
+                  const double di = data[i+k+half].imag();
+                  const std::complex<double> v(dr*wr - di*wi, dr*wi + di*wr);
+                  data[i+k+half] = data[i+k] - v;
+                  data[i+k] += v;
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to perform 3D fft on fft grid. For pruned transforms only the
+      // region holding the macrocells is non-zero on input (forward) or needed
+      // on output (inverse), and lines outside this region are skipped.
+      //------------------------------------------------------------------------
+      void fft_3d(std::vector < std::complex<double> >& data, const bool inverse, const bool pruned){
+
+         const int N[3] = {fft_grid_size[0], fft_grid_size[1], fft_grid_size[2]};
+         const int nx = pruned ? fft_num_cells[0] : N[0];
+         const int ny = pruned ? fft_num_cells[1] : N[1];
+
+         // passes are performed in order z,y,x for forward and x,y,z for inverse transforms
+         for(int pass = 0; pass < 3; pass++){
+
+            const int axis = inverse ? pass : 2-pass;
+
+            #pragma omp parallel
+            {
+
+               std::vector < std::complex<double> > line(N[axis]);
+
+               // contiguous lines along z
+               if(axis == 2){
+                  #pragma omp for schedule(static)
+                  for(int xy = 0; xy < nx*ny; xy++){
+                     const int x = xy/ny;
+                     const int y = xy%ny;
+                     fft_1d(&data[(x*N[1] + y)*N[2]], N[2], fft_twiddle_array[2], inverse);
+                  }
+               }
+               // strided lines along y
+               else if(axis == 1){
+                  #pragma omp for schedule(static)
+                  for(int xz = 0; xz < nx*N[2]; xz++){
+                     const int start = (xz/N[2])*N[1]*N[2] + xz%N[2];
+                     for(int y = 0; y < N[1]; y++) line[y] = data[start + y*N[2]];
+                     fft_1d(&line[0], N[1], fft_twiddle_array[1], inverse);
+                     for(int y = 0; y < N[1]; y++) data[start + y*N[2]] = line[y];
+                  }
+               }
+               // strided lines along x
+               else{
+                  #pragma omp for schedule(static)
+                  for(int yz = 0; yz < N[1]*N[2]; yz++){
+                     for(int x = 0; x < N[0]; x++) line[x] = data[x*N[1]*N[2] + yz];
+                     fft_1d(&line[0], N[0], fft_twiddle_array[0], inverse);
+                     for(int x = 0; x < N[0]; x++) data[x*N[1]*N[2] + yz] = line[x];
+                  }
+               }
+
+            } // end of omp parallel region
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the dipole tensor T.m for all local cells from
+      // normalised cell moments m (all cells). Long range interactions are
+      // calculated by convolution with the bare macrocell tensor and short
+      // range interactions from the explicitly stored near field tensors.
+      //------------------------------------------------------------------------
+      void fft_convolution(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                           std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         const int num_fft = fft_grid_size[0]*fft_grid_size[1]*fft_grid_size[2];
+
+         // copy cell moments to fft grid
+         fft_mx_array.assign(num_fft, std::complex<double>(0.0, 0.0));
+         fft_my_array.assign(num_fft, std::complex<double>(0.0, 0.0));
+         fft_mz_array.assign(num_fft, std::complex<double>(0.0, 0.0));
+
+         for(int i = 0; i < cells_num_cells; i++){
+            if(cells_num_atoms_in_cell[i] > 0){
+               const int index = fft_index(i);
+               fft_mx_array[index] = mx[i];
+               fft_my_array[index] = my[i];
+               fft_mz_array[index] = mz[i];
+            }
+         }
+
+         fft_3d(fft_mx_array, false, true);
+         fft_3d(fft_my_array, false, true);
+         fft_3d(fft_mz_array, false, true);
+
+         // multiply by tensor in reciprocal space
+         #pragma omp parallel for schedule(static)
+         for(int k = 0; k < num_fft; k++){
+            const std::complex<double> fmx = fft_mx_array[k];
+            const std::complex<double> fmy = fft_my_array[k];
+            const std::complex<double> fmz = fft_mz_array[k];
+            fft_mx_array[k] = fft_kernel_xx[k]*fmx + fft_kernel_xy[k]*fmy + fft_kernel_xz[k]*fmz;
+            fft_my_array[k] = fft_kernel_xy[k]*fmx + fft_kernel_yy[k]*fmy + fft_kernel_yz[k]*fmz;
+            fft_mz_array[k] = fft_kernel_xz[k]*fmx + fft_kernel_yz[k]*fmy + fft_kernel_zz[k]*fmz;
+         }
+
+         fft_3d(fft_mx_array, true, true);
+         fft_3d(fft_my_array, true, true);
+         fft_3d(fft_mz_array, true, true);
+
+         const double inv_num_fft = 1.0/double(num_fft);
+
+         // extract far field for local cells and add near field contributions
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+            const int index = fft_index(i);
+
+            double h[3] = {fft_mx_array[index].real()*inv_num_fft, fft_my_array[index].real()*inv_num_fft, fft_mz_array[index].real()*inv_num_fft};
+
+            add_explicit_tensor_field(lc, mx, my, mz, h);
+
+            hx[lc] = h[0];
+            hy[lc] = h[1];
+            hz[lc] = h[2];
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to return the far field of a cell from the last fft
+      // convolution, excluding interactions within the cutoff range
+      //------------------------------------------------------------------------
+      void fft_far_field(const int cell, double h[3]){
+
+         const double inv_num_fft = 1.0/double(fft_grid_size[0]*fft_grid_size[1]*fft_grid_size[2]);
+         const int index = fft_index(cell);
+
+         h[0] = fft_mx_array[index].real()*inv_num_fft;
+         h[1] = fft_my_array[index].real()*inv_num_fft;
+         h[2] = fft_mz_array[index].real()*inv_num_fft;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to initialise fft dipole solver.
+      //
+      // Interactions between cells within the cutoff range are calculated with
+      // the tensor method from the atomistic coordinates and stored for each
+      // local cell. Longer range interactions use the bare macrocell tensor,
+      // which depends only on the separation of cells on the regular macrocell
+      // grid, and are calculated as a convolution using zero padded fast
+      // Fourier transforms. The memory cost is O(N) and the update cost
+      // O(N log N) in the number of cells.
+      //------------------------------------------------------------------------
+      void initialize_fft_solver(int cells_num_cells, /// number of macrocells
+                                 int cells_num_local_cells, /// number of local macrocells
+                                 const double cells_macro_cell_size,
+                                 std::vector <int>& cells_local_cell_array,
+                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                 std::vector <int>& cells_num_atoms_in_cell_global, /// number of atoms in each cell
+                                 std::vector < std::vector <int> >& cells_index_atoms_array,
+                                 std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                 std::vector<int>& atom_type_array,
+                                 std::vector<int>& atom_cell_id_array,
+                                 std::vector<double>& atom_coords_x, //atomic coordinates
+                                 std::vector<double>& atom_coords_y,
+                                 std::vector<double>& atom_coords_z){
+
+         //------------------------------------------------------
+         // Collate atom coordinates for local cells
+         //------------------------------------------------------
+         #ifdef MPICF
+
+            const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+
+            std::vector<double> atom_pos_x(num_local_atoms,0.0);
+            std::vector<double> atom_pos_y(num_local_atoms,0.0);
+            std::vector<double> atom_pos_z(num_local_atoms,0.0);
+
+            for(int atom=0; atom<num_local_atoms; atom++){
+               atom_pos_x[atom]=atom_coords_x[atom];
+               atom_pos_y[atom]=atom_coords_y[atom];
+               atom_pos_z[atom]=atom_coords_z[atom];
+            }
+
+            for(int lc=0; lc<cells_num_cells; lc++){
+               // resize arrays
+               cells_atom_in_cell_coords_array_x[lc].resize(cells_num_atoms_in_cell[lc]);
+               cells_atom_in_cell_coords_array_y[lc].resize(cells_num_atoms_in_cell[lc]);
+               cells_atom_in_cell_coords_array_z[lc].resize(cells_num_atoms_in_cell[lc]);
+               cells_index_atoms_array[lc].resize(cells_num_atoms_in_cell[lc]);
+            }
+
+            // Exchange cells data
+            dipole::internal::send_recv_cells_data(dipole::internal::proc_cell_index_array1D,
+                                                   cells_atom_in_cell_coords_array_x,
+                                                   cells_atom_in_cell_coords_array_y,
+                                                   cells_atom_in_cell_coords_array_z,
+                                                   cells_index_atoms_array,
+                                                   cells_pos_and_mom_array,
+                                                   cells_num_atoms_in_cell,
+                                                   cells::cell_id_array,
+                                                   cells_local_cell_array,
+                                                   cells_num_local_cells,
+                                                   cells_num_cells);
+
+            // Exchange atoms data
+            dipole::internal::send_recv_atoms_data(dipole::internal::proc_cell_index_array1D,
+                                                   cells::cell_id_array,
+                                                   cells_local_cell_array,
+                                                   atom_pos_x,
+                                                   atom_pos_y,
+                                                   atom_pos_z,
+                                                   atom_type_array, // atomic moments (from dipole;:internal::atom_type_array)
+                                                   cells_atom_in_cell_coords_array_x,
+                                                   cells_atom_in_cell_coords_array_y,
+                                                   cells_atom_in_cell_coords_array_z,
+                                                   cells_index_atoms_array,
+                                                   cells_pos_and_mom_array,
+                                                   cells_num_atoms_in_cell,
+                                                   cells_num_local_cells,
+                                                   cells_num_cells,
+                                                   cells_macro_cell_size);
+
+            // Reorder data structure
+            dipole::internal::sort_data(dipole::internal::proc_cell_index_array1D,
+                                        cells::cell_id_array,
+                                        cells_atom_in_cell_coords_array_x,
+                                        cells_atom_in_cell_coords_array_y,
+                                        cells_atom_in_cell_coords_array_z,
+                                        cells_index_atoms_array,
+                                        cells_pos_and_mom_array,
+                                        cells_num_atoms_in_cell,
+                                        cells_num_local_cells,
+                                        cells_num_cells);
+
+            // After transferring the data across cores, assign value cells_num_atoms_in_cell[] from cells_num_atoms_in_cell_global[]
+            for(unsigned int i=0; i<cells_num_atoms_in_cell_global.size(); i++){
+               if(cells_num_atoms_in_cell_global[i]>0 && cells_num_atoms_in_cell[i]==0){
+                  cells_num_atoms_in_cell[i] = cells_num_atoms_in_cell_global[i];
+               }
+            }
+
+            // Clear memory
+            cells_num_atoms_in_cell_global.clear();
+
+            // Clear atom_pos_x,y,z
+            atom_pos_x.clear();
+            atom_pos_y.clear();
+            atom_pos_z.clear();
+
+         #else
+
+            // all cell data is already local in serial
+            (void)cells_local_cell_array;
+            (void)cells_num_atoms_in_cell_global;
+            (void)cells_index_atoms_array;
+            (void)cells_pos_and_mom_array;
+
+         #endif
+
+         // Assign updated value of cells_num_atoms_in_cell to dipole::dipole_cells_num_atoms_in_cell. It is needed to print the config file.
+         dipole::dipole_cells_num_atoms_in_cell=cells_num_atoms_in_cell;
+
+         zlog << zTs() << "Precalculating dipole tensors for dipole calculation using fft solver... " << std::endl;
+         std::cout     << "Precalculating dipole tensors for dipole calculation using fft solver"     << std::flush;
+
+         // instantiate timer
+         vutil::vtimer_t timer;
+
+         // start timer
+         timer.start();
+
+         //------------------------------------------------------
+         // Determine fft grid size
+         //------------------------------------------------------
+         fft_num_cells[0] = cells::num_cells_x;
+         fft_num_cells[1] = cells::num_cells_y;
+         fft_num_cells[2] = cells::num_cells_z;
+
+         fft_twiddle_array.resize(3);
+         for(int d = 0; d < 3; d++){
+            fft_grid_size[d] = fft_padded_size(fft_num_cells[d]);
+            fft_twiddle_array[d] = fft_twiddle_factors(fft_grid_size[d]);
+         }
+
+         const int num_fft = fft_grid_size[0]*fft_grid_size[1]*fft_grid_size[2];
+
+         zlog << zTs() << "FFT grid size for dipole calculation: " << fft_grid_size[0] << " x " << fft_grid_size[1] << " x " << fft_grid_size[2]
+              << " requiring " << double(num_fft)*(6.0*8.0 + 3.0*16.0)/1.0e6 << " MB of RAM" << std::endl;
+
+         //------------------------------------------------------
+         // Calculate fourier transform of far field tensor
+         //------------------------------------------------------
+         std::vector<double>* kernel[6] = {&fft_kernel_xx, &fft_kernel_xy, &fft_kernel_xz, &fft_kernel_yy, &fft_kernel_yz, &fft_kernel_zz};
+         std::vector < std::complex<double> > kernel_data(num_fft);
+
+         const double cutoff_sq = dipole::cutoff*dipole::cutoff;
+
+         for(int component = 0; component < 6; component++){
+
+            std::cout << "." << std::flush;
+
+            kernel_data.assign(num_fft, std::complex<double>(0.0, 0.0));
+
+            for(int a = 0; a < fft_grid_size[0]; a++){
+               for(int b = 0; b < fft_grid_size[1]; b++){
+                  for(int c = 0; c < fft_grid_size[2]; c++){
+
+                     int d[3];
+                     if(!fft_separation(a, fft_num_cells[0], fft_grid_size[0], d[0])) continue;
+                     if(!fft_separation(b, fft_num_cells[1], fft_grid_size[1], d[1])) continue;
+                     if(!fft_separation(c, fft_num_cells[2], fft_grid_size[2], d[2])) continue;
+
+                     // cells within cutoff are included in near field
+                     if(double(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) <= cutoff_sq) continue;
+
+                     const double rx = double(d[0])*cells_macro_cell_size;
+                     const double ry = double(d[1])*cells_macro_cell_size;
+                     const double rz = double(d[2])*cells_macro_cell_size;
+
+                     const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                     // define unitarian distance vectors
+                     const double ex = rx*rij;
+                     const double ey = ry*rij;
+                     const double ez = rz*rij;
+
+                     const double rij3 = (rij*rij*rij); // Angstroms
+
+                     const double t[6] = {(3.0*ex*ex - 1.0)*rij3, 3.0*ex*ey*rij3, 3.0*ex*ez*rij3,
+                                          (3.0*ey*ey - 1.0)*rij3, 3.0*ey*ez*rij3, (3.0*ez*ez - 1.0)*rij3};
+
+                     kernel_data[(a*fft_grid_size[1] + b)*fft_grid_size[2] + c] = t[component];
+
+                  }
+               }
+            }
+
+            fft_3d(kernel_data, false, false);
+
+            // tensor is symmetric in the separation and so the transform is real
+            kernel[component]->resize(num_fft);
+            for(int k = 0; k < num_fft; k++) (*kernel[component])[k] = kernel_data[k].real();
+
+         }
+
+         kernel_data.clear();
+
+         //------------------------------------------------------
+         // Calculate near field tensors for local cells
+         //------------------------------------------------------
+
+         // use first row of tensor arrays as workspace
+         rij_tensor_xx.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_zz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+
+         const int range = int(floor(dipole::cutoff));
+         const int* n = fft_num_cells;
+
+         explicit_tensor_start_index.assign(cells_num_local_cells+1, 0);
+         explicit_tensor_cell_array.clear();
+         explicit_tensor_array.clear();
+
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            explicit_tensor_start_index[lc] = explicit_tensor_cell_array.size();
+
+            const int i = cells::cell_id_array[lc];
+            if(cells_num_atoms_in_cell[i] == 0) continue;
+
+            const int ci[3] = {i/(n[1]*n[2]), (i/n[2])%n[1], i%n[2]};
+
+            for(int dx = -range; dx <= range; dx++){
+               for(int dy = -range; dy <= range; dy++){
+                  for(int dz = -range; dz <= range; dz++){
+
+                     if(double(dx*dx + dy*dy + dz*dz) > cutoff_sq) continue;
+
+                     const int cj[3] = {ci[0]+dx, ci[1]+dy, ci[2]+dz};
+                     if(cj[0] < 0 || cj[0] >= n[0] || cj[1] < 0 || cj[1] >= n[1] || cj[2] < 0 || cj[2] >= n[2]) continue;
+
+                     const int j = (cj[0]*n[1] + cj[1])*n[2] + cj[2];
+                     if(cells_num_atoms_in_cell[j] == 0) continue;
+
+                     if(i == j) compute_intra_tensor(i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+                     else compute_inter_tensor(cells_macro_cell_size, i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+                     explicit_tensor_cell_array.push_back(j);
+                     explicit_tensor_array.push_back(rij_tensor_xx[0][j]);
+                     explicit_tensor_array.push_back(rij_tensor_xy[0][j]);
+                     explicit_tensor_array.push_back(rij_tensor_xz[0][j]);
+                     explicit_tensor_array.push_back(rij_tensor_yy[0][j]);
+                     explicit_tensor_array.push_back(rij_tensor_yz[0][j]);
+                     explicit_tensor_array.push_back(rij_tensor_zz[0][j]);
+
+                  }
+               }
+            }
+         }
+
+         explicit_tensor_start_index[cells_num_local_cells] = explicit_tensor_cell_array.size();
+
+         zlog << zTs() << "Number of near field cell interactions for fft dipole solver: " << explicit_tensor_cell_array.size() << std::endl;
+
+         // hold parallel calculation until all processors have completed the dipole calculation
+         vmpi::barrier();
+
+         // stop timer
+         timer.stop();
+
+         std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
+         zlog << zTs() << "Precalculation of dipole tensors for fft solver complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
+
+         // calculate atomistic near field tensors
+         if(dipole::internal::solver == dipole::internal::atomistic) initialize_atomistic_solver(atom_type_array, atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z);
+
+         // compare with tensor solver for a sample of cells
+         compare_with_tensor_solver(cells_macro_cell_size, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+         // release workspace
+         rij_tensor_xx.clear();
+         rij_tensor_xy.clear();
+         rij_tensor_xz.clear();
+         rij_tensor_yy.clear();
+         rij_tensor_yz.clear();
+         rij_tensor_zz.clear();
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
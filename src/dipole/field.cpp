@@ -42,7 +42,21 @@ namespace dipole{
 		if(dipole::internal::update_time != sim_time){
 
 			// Check if update required
-		   if(sim_time%dipole::update_rate == 0){
+		   bool update = false;
+
+			// adaptive update when cell magnetisation has changed by more than tolerance
+			if(dipole::internal::update_tolerance > 0.0){
+
+			   dipole::internal::update_time = sim_time;
+
+			   // update cell magnetisations
+			   cells::mag();
+
+			   // recalculate dipole fields if required
+			   update = dipole::internal::adaptive_update_field(sim_time);
+
+			}
+		   else if(sim_time%dipole::update_rate == 0){
 
 			   //if updated record last time at update
 			   dipole::internal::update_time = sim_time;
@@ -65,6 +79,12 @@ namespace dipole{
 			   // recalculate dipole fields
             dipole::internal::update_field();
 
+            update = true;
+
+         }
+
+         if(update){
+
 			   // For MPI version, only add local atoms
 			   #ifdef MPICF
 				   const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
@@ -93,11 +113,40 @@ namespace dipole{
 
    	         }
 			   }
-		   } // End of check for update rate
+
+            // replace near field with explicit atomistic dipole sum
+            if(dipole::internal::solver == dipole::internal::atomistic) dipole::internal::update_atomistic_field();
+
+		   } // End of check for update
 		} // end of check for update time
 
       return;
 
    }
 
+   //-----------------------------------------------------------------------------
+   // Function to output statistics of adaptive field updates
+   //-----------------------------------------------------------------------------
+   void output_update_statistics(){
+
+      if(!dipole::activated || dipole::internal::update_tolerance <= 0.0) return;
+
+      const double checks = double(dipole::internal::num_field_checks);
+      if(checks < 1.0) return;
+
+      std::cout << "Adaptive dipole field update statistics:" << std::endl;
+      std::cout << "\tTotal checks: " << dipole::internal::num_field_checks << std::endl;
+      std::cout << "\t" << 100.0*double(dipole::internal::num_full_updates)/checks        << "% Full updates" << std::endl;
+      std::cout << "\t" << 100.0*double(dipole::internal::num_incremental_updates)/checks << "% Incremental updates" << std::endl;
+      std::cout << "\t" << 100.0*double(dipole::internal::num_skipped_updates)/checks     << "% Skipped updates" << std::endl;
+      zlog << zTs() << "Adaptive dipole field update statistics:" << std::endl;
+      zlog << zTs() << "\tTotal checks: " << dipole::internal::num_field_checks << std::endl;
+      zlog << zTs() << "\tFull updates: " << dipole::internal::num_full_updates << std::endl;
+      zlog << zTs() << "\tIncremental updates: " << dipole::internal::num_incremental_updates << std::endl;
+      zlog << zTs() << "\tSkipped updates: " << dipole::internal::num_skipped_updates << std::endl;
+
+      return;
+
+   }
+
 } // end of dipole namespace
@@ -0,0 +1,567 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+// Hierarchical (fast multipole) dipole solver
+//
+// The non-empty macrocells are grouped into an octree, with each node
+// containing the cells of a 2 x 2 x 2 block of nodes on the level below. The
+// far field of each node is described by a multipole expansion of the cell
+// moments up to second order about the node centre, which is converted into
+// a local expansion (field and its first and second derivatives) about the
+// centre of well separated target nodes, and then passed down the tree to the
+// cells. Nodes are well separated when the sum of their radii is less than
+// the opening angle times their separation and all cell pairs are beyond the
+// cutoff range. Interactions between cells within the cutoff range use the
+// explicitly calculated tensors of the tensor solver. Leaves are single cells
+// centred on the cell centre of mass, so interactions between well separated
+// cells are identical to the tensor solver, and the accuracy of the remaining
+// interactions is controlled by the opening angle.
+//
+// Multipole and local expansions are stored as 39 values for each node:
+//    0 -  2  M0[k]      = sum m[k]                 L0[i]
+//    3 - 11  M1[k][a]   = sum m[k] r[a]            L1[i][a]
+//   12 - 38  M2[k][a][b] = sum m[k] r[a] r[b]      L2[i][a][b]
+// where the field at offset r from the node centre is
+//    h[i] = L0[i] + L1[i][a] r[a] + L2[i][a][b] r[a] r[b]
+//------------------------------------------------------------------------------
+namespace dipole{
+
+   namespace internal{
+
+      const int num_expansion_terms = 39;
+
+      //------------------------------------------------------------------------
+      // Function to translate multipole expansion of a child node by s to its
+      // parent node and add to the parent multipole expansion
+      //------------------------------------------------------------------------
+      void hierarchical_m2m(const double s[3], const double* M, double* P){
+
+         const double* M0 = &M[0];
+         const double* M1 = &M[3];
+         const double* M2 = &M[12];
+
+         for(int k = 0; k < 3; k++){
+            P[k] += M0[k];
+            for(int a = 0; a < 3; a++){
+               P[3+3*k+a] += M1[3*k+a] + M0[k]*s[a];
+               for(int b = 0; b < 3; b++){
+                  P[12+9*k+3*a+b] += M2[9*k+3*a+b] + M1[3*k+a]*s[b] + s[a]*M1[3*k+b] + M0[k]*s[a]*s[b];
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to convert multipole expansion M of a source node into a
+      // local expansion about a target node at separation R = target - source,
+      // and add to the target local expansion L. Leaf sources have only the
+      // zeroth order moment, and only the field is needed for leaf targets.
+      //------------------------------------------------------------------------
+      void hierarchical_m2l(const double R[3], const double* M, double* L, const bool source_leaf, const bool target_leaf){
+
+         const double r1 = 1.0/sqrt(R[0]*R[0] + R[1]*R[1] + R[2]*R[2]);
+         const double r2 = r1*r1;
+         const double r3 = r2*r1;
+         const double r5 = r3*r2;
+
+         const double d[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+
+         const double* M0 = &M[0];
+         const double* M1 = &M[3];
+         const double* M2 = &M[12];
+
+         // second derivative of 1/r (bare dipole tensor)
+         double D2[3][3];
+         for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++) D2[i][j] = 3.0*R[i]*R[j]*r5 - d[i][j]*r3;
+         }
+
+         for(int i = 0; i < 3; i++){
+            for(int k = 0; k < 3; k++) L[i] += D2[i][k]*M0[k];
+         }
+
+         // interactions between cells are exact
+         if(source_leaf && target_leaf) return;
+
+         const double r7 = r5*r2;
+         const double r9 = r7*r2;
+
+         // third and fourth derivatives of 1/r
+         double D3[3][3][3];
+         double D4[3][3][3][3];
+
+         for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+               for(int k = 0; k < 3; k++){
+                  D3[i][j][k] = -15.0*R[i]*R[j]*R[k]*r7 + 3.0*(R[i]*d[j][k] + R[j]*d[i][k] + R[k]*d[i][j])*r5;
+                  for(int l = 0; l < 3; l++){
+                     D4[i][j][k][l] = 105.0*R[i]*R[j]*R[k]*R[l]*r9
+                                    - 15.0*(R[i]*R[j]*d[k][l] + R[i]*R[k]*d[j][l] + R[i]*R[l]*d[j][k] +
+                                            R[j]*R[k]*d[i][l] + R[j]*R[l]*d[i][k] + R[k]*R[l]*d[i][j])*r7
+                                    + 3.0*(d[i][j]*d[k][l] + d[i][k]*d[j][l] + d[i][l]*d[j][k])*r5;
+                  }
+               }
+            }
+         }
+
+         // field from higher order moments of source
+         if(!source_leaf){
+            for(int i = 0; i < 3; i++){
+               for(int k = 0; k < 3; k++){
+                  for(int a = 0; a < 3; a++){
+                     L[i] -= D3[i][k][a]*M1[3*k+a];
+                     for(int b = 0; b < 3; b++) L[i] += 0.5*D4[i][k][a][b]*M2[9*k+3*a+b];
+                  }
+               }
+            }
+         }
+
+         if(target_leaf) return;
+
+         // field derivatives
+         for(int i = 0; i < 3; i++){
+            for(int k = 0; k < 3; k++){
+               for(int a = 0; a < 3; a++){
+                  L[3+3*i+a] += D3[i][k][a]*M0[k];
+                  for(int b = 0; b < 3; b++){
+                     if(!source_leaf) L[3+3*i+a] -= D4[i][k][a][b]*M1[3*k+b];
+                     L[12+9*i+3*a+b] += 0.5*D4[i][k][a][b]*M0[k];
+                  }
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to translate local expansion of a parent node by e to its
+      // child node and add to the child local expansion
+      //------------------------------------------------------------------------
+      void hierarchical_l2l(const double e[3], const double* P, double* L){
+
+         const double* P0 = &P[0];
+         const double* P1 = &P[3];
+         const double* P2 = &P[12];
+
+         for(int i = 0; i < 3; i++){
+            L[i] += P0[i];
+            for(int a = 0; a < 3; a++){
+               L[i] += P1[3*i+a]*e[a];
+               L[3+3*i+a] += P1[3*i+a];
+               for(int b = 0; b < 3; b++){
+                  L[i] += P2[9*i+3*a+b]*e[a]*e[b];
+                  L[3+3*i+a] += 2.0*P2[9*i+3*a+b]*e[b];
+                  L[12+9*i+3*a+b] += P2[9*i+3*a+b];
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to determine interactions between target node a and source
+      // node b, recursively splitting nodes which are not well separated.
+      // Only target nodes containing local cells are considered.
+      //------------------------------------------------------------------------
+      void hierarchical_interactions(const int a, const int b, const double cells_macro_cell_size,
+                                     const std::vector<int>& cell_local_array,
+                                     std::vector < std::vector <int> >& node_interactions,
+                                     std::vector < std::vector <int> >& near_cells){
+
+         const double* ca = &hierarchical_node_centre_array[3*a];
+         const double* cb = &hierarchical_node_centre_array[3*b];
+         const double ra = hierarchical_node_radius_array[a];
+         const double rb = hierarchical_node_radius_array[b];
+
+         const double dx = ca[0] - cb[0];
+         const double dy = ca[1] - cb[1];
+         const double dz = ca[2] - cb[2];
+         const double rab = sqrt(dx*dx + dy*dy + dz*dz);
+
+         // well separated nodes interact through multipole expansion
+         if((rab - ra - rb)/cells_macro_cell_size > dipole::cutoff + 1.0e-6 && ra + rb <= hierarchical_opening_angle*rab){
+            node_interactions[a].push_back(b);
+            return;
+         }
+
+         const int cell_a = hierarchical_node_cell_array[a];
+         const int cell_b = hierarchical_node_cell_array[b];
+
+         // cells within cutoff range interact through explicit tensor
+         if(cell_a >= 0 && cell_b >= 0){
+            near_cells[cell_local_array[cell_a]].push_back(cell_b);
+            return;
+         }
+
+         // otherwise split the larger node
+         if(cell_a >= 0 || (cell_b < 0 && rb > ra)){
+            for(int c = hierarchical_node_child_start_index[b]; c < hierarchical_node_child_start_index[b+1]; c++){
+               hierarchical_interactions(a, hierarchical_node_child_array[c], cells_macro_cell_size, cell_local_array, node_interactions, near_cells);
+            }
+         }
+         else{
+            for(int c = hierarchical_node_child_start_index[a]; c < hierarchical_node_child_start_index[a+1]; c++){
+               const int child = hierarchical_node_child_array[c];
+               if(hierarchical_node_local_array[child]) hierarchical_interactions(child, b, cells_macro_cell_size, cell_local_array, node_interactions, near_cells);
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the dipole tensor T.m for all local cells from
+      // normalised cell moments m (all cells) with the hierarchical solver
+      //------------------------------------------------------------------------
+      void hierarchical_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                              std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         const int num_nodes = hierarchical_node_cell_array.size();
+         const int nt = num_expansion_terms;
+
+         std::vector<double> multipole(nt*num_nodes, 0.0);
+         std::vector<double> local(nt*num_nodes, 0.0);
+
+         // upward pass, children are always stored before their parents
+         for(int node = 0; node < num_nodes; node++){
+
+            const int cell = hierarchical_node_cell_array[node];
+            if(cell >= 0){
+               multipole[nt*node+0] = mx[cell];
+               multipole[nt*node+1] = my[cell];
+               multipole[nt*node+2] = mz[cell];
+            }
+
+            const int parent = hierarchical_node_parent_array[node];
+            if(parent >= 0){
+               const double s[3] = {hierarchical_node_centre_array[3*node+0] - hierarchical_node_centre_array[3*parent+0],
+                                    hierarchical_node_centre_array[3*node+1] - hierarchical_node_centre_array[3*parent+1],
+                                    hierarchical_node_centre_array[3*node+2] - hierarchical_node_centre_array[3*parent+2]};
+               hierarchical_m2m(s, &multipole[nt*node], &multipole[nt*parent]);
+            }
+         }
+
+         // multipole to local expansions for well separated nodes
+         #pragma omp parallel for schedule(dynamic)
+         for(int node = 0; node < num_nodes; node++){
+            for(int n = hierarchical_interaction_start_index[node]; n < hierarchical_interaction_start_index[node+1]; n++){
+               const int source = hierarchical_interaction_array[n];
+               const double R[3] = {hierarchical_node_centre_array[3*node+0] - hierarchical_node_centre_array[3*source+0],
+                                    hierarchical_node_centre_array[3*node+1] - hierarchical_node_centre_array[3*source+1],
+                                    hierarchical_node_centre_array[3*node+2] - hierarchical_node_centre_array[3*source+2]};
+               hierarchical_m2l(R, &multipole[nt*source], &local[nt*node], hierarchical_node_cell_array[source] >= 0, hierarchical_node_cell_array[node] >= 0);
+            }
+         }
+
+         // downward pass for nodes containing local cells
+         for(int node = num_nodes-1; node >= 0; node--){
+            const int parent = hierarchical_node_parent_array[node];
+            if(parent >= 0 && hierarchical_node_local_array[node]){
+               const double e[3] = {hierarchical_node_centre_array[3*node+0] - hierarchical_node_centre_array[3*parent+0],
+                                    hierarchical_node_centre_array[3*node+1] - hierarchical_node_centre_array[3*parent+1],
+                                    hierarchical_node_centre_array[3*node+2] - hierarchical_node_centre_array[3*parent+2]};
+               hierarchical_l2l(e, &local[nt*parent], &local[nt*node]);
+            }
+         }
+
+         // field at cell centre of mass and near field contributions
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+            double h[3] = {0.0, 0.0, 0.0};
+
+            if(cells_num_atoms_in_cell[i] > 0){
+
+               const int node = hierarchical_cell_node_array[i];
+               h[0] = local[nt*node+0];
+               h[1] = local[nt*node+1];
+               h[2] = local[nt*node+2];
+
+               add_explicit_tensor_field(lc, mx, my, mz, h);
+
+            }
+
+            hx[lc] = h[0];
+            hy[lc] = h[1];
+            hz[lc] = h[2];
+
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to initialise hierarchical solver, building the octree of
+      // macrocells and interaction lists and calculating near field tensors
+      //------------------------------------------------------------------------
+      void initialize_hierarchical_solver(const double cells_macro_cell_size,
+                                          std::vector <int>& cells_num_atoms_in_cell,
+                                          std::vector<double>& cells_pos_and_mom_array,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+
+         zlog << zTs() << "Precalculating dipole tensors for dipole calculation using hierarchical solver... " << std::endl;
+         std::cout     << "Precalculating dipole tensors for dipole calculation using hierarchical solver"     << std::flush;
+
+         // instantiate timer
+         vutil::vtimer_t timer;
+
+         // start timer
+         timer.start();
+
+         //------------------------------------------------------
+         // Build octree of non-empty cells
+         //------------------------------------------------------
+         const int n[3] = {cells::num_cells_x, cells::num_cells_y, cells::num_cells_z};
+
+         hierarchical_node_cell_array.clear();
+         hierarchical_node_parent_array.clear();
+         hierarchical_node_centre_array.clear();
+         hierarchical_node_radius_array.clear();
+         hierarchical_cell_node_array.assign(cells_num_cells, -1);
+
+         std::vector<double> weight; // number of atoms in each node
+         std::vector<int> key; // position of each node on its level
+
+         // leaf nodes for each cell centred on centre of mass
+         for(int i = 0; i < cells_num_cells; i++){
+            if(cells_num_atoms_in_cell[i] == 0) continue;
+            hierarchical_cell_node_array[i] = hierarchical_node_cell_array.size();
+            hierarchical_node_cell_array.push_back(i);
+            hierarchical_node_parent_array.push_back(-1);
+            hierarchical_node_centre_array.push_back(cells_pos_and_mom_array[4*i+0]);
+            hierarchical_node_centre_array.push_back(cells_pos_and_mom_array[4*i+1]);
+            hierarchical_node_centre_array.push_back(cells_pos_and_mom_array[4*i+2]);
+            hierarchical_node_radius_array.push_back(0.0);
+            weight.push_back(double(cells_num_atoms_in_cell[i]));
+            key.push_back(i);
+         }
+
+         int level_start = 0;
+         int level_end = hierarchical_node_cell_array.size();
+         int size[3] = {n[0], n[1], n[2]};
+         hierarchical_num_levels = 1;
+
+         while(level_end - level_start > 1){
+
+            const int parent_size[3] = {(size[0]+1)/2, (size[1]+1)/2, (size[2]+1)/2};
+            std::vector<int> parent_node(parent_size[0]*parent_size[1]*parent_size[2], -1);
+
+            for(int node = level_start; node < level_end; node++){
+
+               const int x = key[node]/(size[1]*size[2]);
+               const int y = (key[node]/size[2])%size[1];
+               const int z = key[node]%size[2];
+               const int parent_key = ((x/2)*parent_size[1] + y/2)*parent_size[2] + z/2;
+
+               if(parent_node[parent_key] < 0){
+                  parent_node[parent_key] = hierarchical_node_cell_array.size();
+                  hierarchical_node_cell_array.push_back(-1);
+                  hierarchical_node_parent_array.push_back(-1);
+                  for(int d = 0; d < 3; d++) hierarchical_node_centre_array.push_back(0.0);
+                  hierarchical_node_radius_array.push_back(0.0);
+                  weight.push_back(0.0);
+                  key.push_back(parent_key);
+               }
+
+               const int parent = parent_node[parent_key];
+               hierarchical_node_parent_array[node] = parent;
+               weight[parent] += weight[node];
+               for(int d = 0; d < 3; d++) hierarchical_node_centre_array[3*parent+d] += weight[node]*hierarchical_node_centre_array[3*node+d];
+
+            }
+
+            const int num_nodes = hierarchical_node_cell_array.size();
+
+            for(int node = level_end; node < num_nodes; node++){
+               for(int d = 0; d < 3; d++) hierarchical_node_centre_array[3*node+d] /= weight[node];
+            }
+
+            // radius of sphere enclosing all children
+            for(int node = level_start; node < level_end; node++){
+               const int parent = hierarchical_node_parent_array[node];
+               const double dx = hierarchical_node_centre_array[3*node+0] - hierarchical_node_centre_array[3*parent+0];
+               const double dy = hierarchical_node_centre_array[3*node+1] - hierarchical_node_centre_array[3*parent+1];
+               const double dz = hierarchical_node_centre_array[3*node+2] - hierarchical_node_centre_array[3*parent+2];
+               const double r = sqrt(dx*dx + dy*dy + dz*dz) + hierarchical_node_radius_array[node];
+               hierarchical_node_radius_array[parent] = std::max(hierarchical_node_radius_array[parent], r);
+            }
+
+            for(int d = 0; d < 3; d++) size[d] = parent_size[d];
+            level_start = level_end;
+            level_end = num_nodes;
+            hierarchical_num_levels++;
+
+         }
+
+         const int num_nodes = hierarchical_node_cell_array.size();
+
+         // child lists for each node
+         hierarchical_node_child_start_index.assign(num_nodes+1, 0);
+         for(int node = 0; node < num_nodes; node++){
+            const int parent = hierarchical_node_parent_array[node];
+            if(parent >= 0) hierarchical_node_child_start_index[parent+1]++;
+         }
+         for(int node = 0; node < num_nodes; node++) hierarchical_node_child_start_index[node+1] += hierarchical_node_child_start_index[node];
+         hierarchical_node_child_array.assign(hierarchical_node_child_start_index[num_nodes], 0);
+         std::vector<int> num_children(num_nodes, 0);
+         for(int node = 0; node < num_nodes; node++){
+            const int parent = hierarchical_node_parent_array[node];
+            if(parent >= 0){
+               hierarchical_node_child_array[hierarchical_node_child_start_index[parent] + num_children[parent]] = node;
+               num_children[parent]++;
+            }
+         }
+
+         // flag nodes containing local cells
+         std::vector<int> cell_local_array(cells_num_cells, -1);
+         hierarchical_node_local_array.assign(num_nodes, 0);
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+            const int i = cells::cell_id_array[lc];
+            cell_local_array[i] = lc;
+            for(int node = hierarchical_cell_node_array[i]; node >= 0; node = hierarchical_node_parent_array[node]){
+               hierarchical_node_local_array[node] = 1;
+            }
+         }
+
+         std::cout << "." << std::flush;
+
+         //------------------------------------------------------
+         // Determine interaction lists from root node
+         //------------------------------------------------------
+         std::vector < std::vector <int> > node_interactions(num_nodes);
+         std::vector < std::vector <int> > near_cells(cells_num_local_cells);
+
+         if(num_nodes > 0 && hierarchical_node_local_array[num_nodes-1]){
+            hierarchical_interactions(num_nodes-1, num_nodes-1, cells_macro_cell_size, cell_local_array, node_interactions, near_cells);
+         }
+
+         hierarchical_interaction_start_index.assign(num_nodes+1, 0);
+         hierarchical_interaction_array.clear();
+         for(int node = 0; node < num_nodes; node++){
+            hierarchical_interaction_array.insert(hierarchical_interaction_array.end(), node_interactions[node].begin(), node_interactions[node].end());
+            hierarchical_interaction_start_index[node+1] = hierarchical_interaction_array.size();
+         }
+         node_interactions.clear();
+
+         std::cout << "." << std::flush;
+
+         //------------------------------------------------------
+         // Calculate near field tensors for local cells
+         //------------------------------------------------------
+
+         // use first row of tensor arrays as workspace
+         rij_tensor_xx.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_xz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yy.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_yz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+         rij_tensor_zz.assign(1, std::vector<double>(cells_num_cells, 0.0));
+
+         explicit_tensor_start_index.assign(cells_num_local_cells+1, 0);
+         explicit_tensor_cell_array.clear();
+         explicit_tensor_array.clear();
+
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            // print out progress to screen
+            if(fmod(ceil(lc),ceil(cells_num_local_cells)/10.0) == 0) std::cout << "." << std::flush;
+
+            explicit_tensor_start_index[lc] = explicit_tensor_cell_array.size();
+
+            const int i = cells::cell_id_array[lc];
+            std::sort(near_cells[lc].begin(), near_cells[lc].end());
+
+            for(unsigned int n = 0; n < near_cells[lc].size(); n++){
+
+               const int j = near_cells[lc][n];
+
+               if(i == j) compute_intra_tensor(i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+               else compute_inter_tensor(cells_macro_cell_size, i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+               explicit_tensor_cell_array.push_back(j);
+               explicit_tensor_array.push_back(rij_tensor_xx[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_xy[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_xz[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_yy[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_yz[0][j]);
+               explicit_tensor_array.push_back(rij_tensor_zz[0][j]);
+
+            }
+
+            near_cells[lc].clear();
+
+         }
+
+         explicit_tensor_start_index[cells_num_local_cells] = explicit_tensor_cell_array.size();
+
+         // hold parallel calculation until all processors have completed the dipole calculation
+         vmpi::barrier();
+
+         // stop timer
+         timer.stop();
+
+         std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
+         zlog << zTs() << "Precalculation of dipole tensors for hierarchical solver complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
+
+         const double memory = (double(num_nodes)*(2.0*num_expansion_terms*8.0 + 3.0*8.0 + 8.0 + 5.0*4.0) +
+                                double(hierarchical_interaction_array.size())*4.0 +
+                                double(explicit_tensor_cell_array.size())*(6.0*8.0 + 4.0))/1.0e6;
+
+         zlog << zTs() << "Hierarchical dipole solver uses " << hierarchical_num_levels << " levels with " << num_nodes << " nodes, "
+              << hierarchical_interaction_array.size() << " multipole interactions and " << explicit_tensor_cell_array.size()
+              << " near field cell interactions requiring " << memory << " MB of RAM" << std::endl;
+
+         // compare with tensor solver for a sample of cells
+         compare_with_tensor_solver(cells_macro_cell_size, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+         // release workspace
+         rij_tensor_xx.clear();
+         rij_tensor_xy.clear();
+         rij_tensor_xz.clear();
+         rij_tensor_yy.clear();
+         rij_tensor_yz.clear();
+         rij_tensor_zz.clear();
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
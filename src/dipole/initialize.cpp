@@ -66,6 +66,9 @@ namespace dipole{
       std::cout << "Initialising dipole field calculation" << std::endl;
 		zlog << zTs() << "Initialising dipole field calculation" << std::endl;
 
+      // compressed storage is only used by the tensor solver
+      if(dipole::internal::solver != dipole::internal::tensor) dipole::internal::compressed_tensors = false;
+
       // allocate memory for rij matrix
       dipole::internal::allocate_memory(cells_num_local_cells, cells_num_cells);
 
@@ -89,12 +92,14 @@ namespace dipole{
 		// Starting calculation of dipolar field
 		//-------------------------------------------------------------------------------------
 
-      // Check memory requirements and print to screen
-      zlog << zTs() << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
-      std::cout     << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+      // Check memory requirements and print to screen (memory for other solvers is reported during initialisation)
+      if(dipole::internal::full_tensor_storage()){
+         zlog << zTs() << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         std::cout     << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
 
-      zlog << zTs() << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
-      std::cout << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         zlog << zTs() << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         std::cout << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+      }
 
       zlog << zTs() << "Number of local cells for dipole calculation = " << dipole::internal::cells_num_local_cells << std::endl;
       zlog << zTs() << "Number of total cells for dipole calculation = " << dipole::internal::cells_num_cells << std::endl;
@@ -111,13 +116,24 @@ namespace dipole{
                                                        dipole::internal::atom_type_array, dipole::internal::atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z, dipole::internal::num_atoms);
             break;
 
+         // hierarchical solver shares the cell data and near field tensors of the tensor solver
          case dipole::internal::tensor:
+         case dipole::internal::hierarchical:
             dipole::internal::initialize_tensor_solver(cells_num_atoms_in_unit_cell, dipole::internal::cells_num_cells, dipole::internal::cells_num_local_cells, cells_macro_cell_size, dipole::internal::cells_local_cell_array,
                                                        dipole::internal::cells_num_atoms_in_cell, cells_num_atoms_in_cell_global, cells_index_atoms_array, dipole::internal::cells_volume_array, dipole::internal::cells_pos_and_mom_array,
                                                        cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z,
                                                        dipole::internal::atom_type_array, dipole::internal::atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z, dipole::internal::num_atoms);
             break;
 
+         // atomistic solver uses the fft solver for the far field
+         case dipole::internal::fft:
+         case dipole::internal::atomistic:
+            dipole::internal::initialize_fft_solver(dipole::internal::cells_num_cells, dipole::internal::cells_num_local_cells, cells_macro_cell_size, dipole::internal::cells_local_cell_array,
+                                                    dipole::internal::cells_num_atoms_in_cell, cells_num_atoms_in_cell_global, cells_index_atoms_array, dipole::internal::cells_pos_and_mom_array,
+                                                    cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z,
+                                                    dipole::internal::atom_type_array, dipole::internal::atom_cell_id_array, atom_coords_x, atom_coords_y, atom_coords_z);
+            break;
+
       }
 
       // Set initialised flag
@@ -158,8 +174,11 @@ namespace dipole{
       std::vector<double> N_tensor_array(6*dipole::internal::cells_num_cells,0.0);
 
 
+      // Solvers which do not store the full tensor calculate the sum from the tensor field
+      if(!dipole::internal::full_tensor_storage()) dipole::internal::calculate_demag_tensor(N_tensor_array);
+
       // Every cpus print to check dipolar matrix inter term
-      for(int lc=0; lc<dipole::internal::cells_num_local_cells; lc++){
+      for(int lc=0; lc<int(dipole::internal::rij_tensor_xx.size()); lc++){
 
          // get id of cell
          int i = cells::cell_id_array[lc];
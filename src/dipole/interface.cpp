@@ -47,11 +47,57 @@ namespace dipole{
             dipole::activated=true;
             return true;
          }
+         test="fft";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::fft;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
+         test="hierarchical";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::hierarchical;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
+         test="atomistic";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::atomistic;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
             std::cerr << "\t\"macrocell\"" << std::endl;
             std::cerr << "\t\"tensor\"" << std::endl;
+            std::cerr << "\t\"fft\"" << std::endl;
+            std::cerr << "\t\"hierarchical\"" << std::endl;
+            std::cerr << "\t\"atomistic\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //-------------------------------------------------------------------
+      test="tensor-storage";
+      if(word==test){
+         test="full";
+         if(value == test){
+            dipole::internal::compressed_tensors = false;
+            return true;
+         }
+         test="compressed";
+         if(value == test){
+            dipole::internal::compressed_tensors = true;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"full\"" << std::endl;
+            std::cerr << "\t\"compressed\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
          }
@@ -65,6 +111,14 @@ namespace dipole{
          return true;
       }
       //-------------------------------------------------------------------
+      test="field-update-tolerance";
+      if(word==test){
+         double tol=atof(value.c_str());
+         vin::check_for_valid_value(tol, word, line, prefix, unit, "",  0.0, 1.0,"input","0.0 - 1.0");
+         dipole::internal::update_tolerance=tol;
+         return true;
+      }
+      //-------------------------------------------------------------------
       test="cutoff-radius";
       if(word==test){
          double dpur=atof(value.c_str());
@@ -72,6 +126,14 @@ namespace dipole{
          dipole::cutoff=dpur;
          return true;
       }
+      //-------------------------------------------------------------------
+      test="hierarchical-opening-angle";
+      if(word==test){
+         double theta=atof(value.c_str());
+         vin::check_for_valid_value(theta, word, line, prefix, unit, "",  0.0, 1.0,"input","0.0 - 1.0");
+         dipole::internal::hierarchical_opening_angle=theta;
+         return true;
+      }
       //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
@@ -18,6 +18,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <complex>
 #include <vector>
 
 // Vampire headers
@@ -42,16 +43,28 @@ namespace dipole{
       // enumerated list of different dipole solvers
       enum solver_t{
          macrocell    = 0, // original bare macrocell method (cheap but inaccurate)
-         tensor       = 1 // new macrocell with tensor including local corrections
-         //multipole    = 2, // bare macrocell but with multipole expansion
-         //hierarchical = 3, // new macrocell with tensor including local corrections and nearfield multipole
-         //exact        = 4, // atomistic dipole dipole (too slow for anything over 1000 atoms)
+         tensor       = 1, // new macrocell with tensor including local corrections
+         fft          = 2, // fft convolution of bare macrocell far field with tensor local corrections
+         //multipole    = 3, // bare macrocell but with multipole expansion
+         hierarchical = 4, // new macrocell with tensor including local corrections and far field multipole
+         atomistic    = 5 // atomistic dipole dipole within cutoff range with fft far field
       };
 
       extern solver_t solver;
 
       extern int update_time; /// last update time
 
+      // variables for adaptive field updates
+      extern double update_tolerance; /// maximum change in cell moment between updates (0 = fixed update rate)
+      extern uint64_t last_full_update_time; /// time of last full field update
+      extern std::vector < double > update_mag_array_x; /// cell magnetisation used for last field update
+      extern std::vector < double > update_mag_array_y;
+      extern std::vector < double > update_mag_array_z;
+      extern uint64_t num_field_checks; /// number of time steps with adaptive field check
+      extern uint64_t num_full_updates; /// number of full field updates
+      extern uint64_t num_incremental_updates; /// number of incremental field updates
+      extern uint64_t num_skipped_updates; /// number of skipped field updates
+
       extern const double prefactor; // 1e-7/1e30
 
       extern std::vector <std::vector < double > > rij_tensor_xx;
@@ -75,12 +88,70 @@ namespace dipole{
       extern std::vector<double> cells_pos_and_mom_array;
       extern std::vector < int > proc_cell_index_array1D;
 
+      // variables for fft solver
+      extern int fft_num_cells[3]; /// number of macrocells in x,y,z
+      extern int fft_grid_size[3]; /// size of zero padded fft grid in x,y,z
+      extern std::vector < std::vector < std::complex<double> > > fft_twiddle_array; /// fft twiddle factors for x,y,z
+      extern std::vector < double > fft_kernel_xx; /// fourier transform of far field dipole tensor
+      extern std::vector < double > fft_kernel_xy;
+      extern std::vector < double > fft_kernel_xz;
+      extern std::vector < double > fft_kernel_yy;
+      extern std::vector < double > fft_kernel_yz;
+      extern std::vector < double > fft_kernel_zz;
+      extern std::vector < std::complex<double> > fft_mx_array; /// fourier transformed cell magnetisation and field
+      extern std::vector < std::complex<double> > fft_my_array;
+      extern std::vector < std::complex<double> > fft_mz_array;
+
+      // variables for compressed tensor storage
+      extern bool compressed_tensors; /// flag to store tensors by cell displacement
+      extern std::vector < double > displacement_tensor_xx; /// bare macrocell tensor for each cell displacement
+      extern std::vector < double > displacement_tensor_xy;
+      extern std::vector < double > displacement_tensor_xz;
+      extern std::vector < double > displacement_tensor_yy;
+      extern std::vector < double > displacement_tensor_yz;
+      extern std::vector < double > displacement_tensor_zz;
+      extern std::vector < int > regular_cell_array; /// flag for cells with regular centre of mass offset
+
+      // variables for hierarchical solver
+      extern double hierarchical_opening_angle; /// maximum ratio of node size to separation for multipole interactions
+      extern int hierarchical_num_levels; /// number of levels in octree
+      extern std::vector < int > hierarchical_node_cell_array; /// cell id of leaf nodes (-1 for other nodes)
+      extern std::vector < int > hierarchical_node_parent_array; /// parent of each node (-1 for root)
+      extern std::vector < int > hierarchical_node_child_start_index; /// start index of children for each node
+      extern std::vector < int > hierarchical_node_child_array; /// children of each node
+      extern std::vector < int > hierarchical_node_local_array; /// flag for nodes containing local cells
+      extern std::vector < double > hierarchical_node_centre_array; /// centre of each node (3 components)
+      extern std::vector < double > hierarchical_node_radius_array; /// radius enclosing all cells in each node
+      extern std::vector < int > hierarchical_cell_node_array; /// leaf node of each cell
+      extern std::vector < int > hierarchical_interaction_start_index; /// start index of multipole interactions for each node
+      extern std::vector < int > hierarchical_interaction_array; /// source node of each multipole interaction
+
+      // variables for atomistic solver
+      extern int atomistic_num_sources; /// number of local and imported atoms
+      extern std::vector < int > atomistic_target_array; /// local atoms with atomistic near field
+      extern std::vector < int > atomistic_pair_start_index; /// start index of atom pairs for each target atom
+      extern std::vector < int > atomistic_pair_source_array; /// source atom of each pair
+      extern std::vector < int > atomistic_pair_tensor_array; /// tensor index of each pair
+      extern std::vector < double > atomistic_tensor_array; /// distinct pair tensors (6 components)
+      extern std::vector < int > atomistic_partner_array; /// neighbouring processors exchanging atoms
+      extern std::vector < int > atomistic_send_start_index; /// start index of sent atoms for each partner processor
+      extern std::vector < int > atomistic_send_atom_array; /// local atoms sent to partner processors
+      extern std::vector < int > atomistic_recv_start_index; /// start index of received atoms for each partner processor
+
+      // explicitly stored tensors for near field and irregular cell pairs (fft, compressed tensors and hierarchical)
+      extern std::vector < int > explicit_tensor_start_index; /// start index of explicit tensors for each local cell
+      extern std::vector < int > explicit_tensor_cell_array; /// interacting cell for each explicit tensor
+      extern std::vector < double > explicit_tensor_array; /// explicit tensors (6 components)
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
       //void write_macrocell_data();
       extern void update_field();
 
+      bool adaptive_update_field(const uint64_t sim_time);
+      void incremental_update_field(const std::vector<int>& changed_cells);
+
       void allocate_memory(const int cells_num_local_cells, const int cells_num_cells);
 
       void initialize_tensor_solver(const int cells_num_atoms_in_unit_cell,
@@ -141,6 +212,73 @@ namespace dipole{
                                        std::vector<double>& atom_coords_z,
                                        int num_atoms);
 
+      void initialize_fft_solver(int cells_num_cells, /// number of macrocells
+                                 int cells_num_local_cells, /// number of local macrocells
+                                 const double cells_macro_cell_size,
+                                 std::vector <int>& cells_local_cell_array,
+                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                 std::vector <int>& cells_num_atoms_in_cell_global, /// number of atoms in each cell
+                                 std::vector < std::vector <int> >& cells_index_atoms_array,
+                                 std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                 std::vector<int>& atom_type_array,
+                                 std::vector<int>& atom_cell_id_array,
+                                 std::vector<double>& atom_coords_x, //atomic coordinates
+                                 std::vector<double>& atom_coords_y,
+                                 std::vector<double>& atom_coords_z);
+
+      void fft_convolution(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                           std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz);
+
+      void fft_far_field(const int cell, double h[3]);
+
+      void initialize_atomistic_solver(std::vector<int>& atom_type_array,
+                                       std::vector<int>& atom_cell_id_array,
+                                       std::vector<double>& atom_coords_x,
+                                       std::vector<double>& atom_coords_y,
+                                       std::vector<double>& atom_coords_z);
+
+      void update_atomistic_field();
+
+      void initialize_compressed_tensors(const double cells_macro_cell_size,
+                                         std::vector <int>& cells_num_atoms_in_cell,
+                                         std::vector<double>& cells_pos_and_mom_array,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+
+      void compressed_tensor_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                                   std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz);
+
+      void initialize_hierarchical_solver(const double cells_macro_cell_size,
+                                          std::vector <int>& cells_num_atoms_in_cell,
+                                          std::vector<double>& cells_pos_and_mom_array,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+
+      void hierarchical_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                              std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz);
+
+      void add_explicit_tensor_field(const int lc, const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz, double h[3]);
+
+      void calculate_tensor_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                                  std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz);
+
+      void update_cell_fields();
+
+      bool full_tensor_storage();
+
+      void calculate_demag_tensor(std::vector<double>& N_tensor_array);
+
+      void compare_with_tensor_solver(const double cells_macro_cell_size,
+                                      std::vector <int>& cells_num_atoms_in_cell,
+                                      std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                      std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                      std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+
       //-----------------------------------------------------------------------------
       // Function to send receive cells data to other cpus
       //-----------------------------------------------------------------------------
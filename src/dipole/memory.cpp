@@ -25,35 +25,40 @@ namespace dipole{
       //-----------------------------------------------------------------
       void allocate_memory(const int cells_num_local_cells, const int cells_num_cells){
 
-         // reserve memory for inter cell arrays
-         dipole::internal::rij_tensor_xx.reserve(cells_num_local_cells);
-         dipole::internal::rij_tensor_xy.reserve(cells_num_local_cells);
-         dipole::internal::rij_tensor_xz.reserve(cells_num_local_cells);
-         dipole::internal::rij_tensor_yy.reserve(cells_num_local_cells);
-         dipole::internal::rij_tensor_yz.reserve(cells_num_local_cells);
-         dipole::internal::rij_tensor_zz.reserve(cells_num_local_cells);
+         // only the macrocell and tensor solvers with full storage need the full matrix
+         if(dipole::internal::solver == dipole::internal::macrocell || (dipole::internal::solver == dipole::internal::tensor && !dipole::internal::compressed_tensors)){
 
+            // reserve memory for inter cell arrays
+            dipole::internal::rij_tensor_xx.reserve(cells_num_local_cells);
+            dipole::internal::rij_tensor_xy.reserve(cells_num_local_cells);
+            dipole::internal::rij_tensor_xz.reserve(cells_num_local_cells);
+            dipole::internal::rij_tensor_yy.reserve(cells_num_local_cells);
+            dipole::internal::rij_tensor_yz.reserve(cells_num_local_cells);
+            dipole::internal::rij_tensor_zz.reserve(cells_num_local_cells);
 
-         // allocate arrays to store data [nloccell x ncells]
-         for(int lc=0; lc<cells_num_local_cells; lc++){
 
-            dipole::internal::rij_tensor_xx.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_xx[lc].resize(cells_num_cells,0.0);
+            // allocate arrays to store data [nloccell x ncells]
+            for(int lc=0; lc<cells_num_local_cells; lc++){
 
-            dipole::internal::rij_tensor_xy.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_xy[lc].resize(cells_num_cells,0.0);
+               dipole::internal::rij_tensor_xx.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_xx[lc].resize(cells_num_cells,0.0);
 
-            dipole::internal::rij_tensor_xz.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_xz[lc].resize(cells_num_cells,0.0);
+               dipole::internal::rij_tensor_xy.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_xy[lc].resize(cells_num_cells,0.0);
 
-            dipole::internal::rij_tensor_yy.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_yy[lc].resize(cells_num_cells,0.0);
+               dipole::internal::rij_tensor_xz.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_xz[lc].resize(cells_num_cells,0.0);
 
-            dipole::internal::rij_tensor_yz.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_yz[lc].resize(cells_num_cells,0.0);
+               dipole::internal::rij_tensor_yy.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_yy[lc].resize(cells_num_cells,0.0);
+
+               dipole::internal::rij_tensor_yz.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_yz[lc].resize(cells_num_cells,0.0);
+
+               dipole::internal::rij_tensor_zz.push_back(std::vector<double>());
+               dipole::internal::rij_tensor_zz[lc].resize(cells_num_cells,0.0);
+            }
 
-            dipole::internal::rij_tensor_zz.push_back(std::vector<double>());
-            dipole::internal::rij_tensor_zz[lc].resize(cells_num_cells,0.0);
          }
 
          // resize B-field cells array
@@ -9,6 +9,7 @@
 //
 
 // C++ standard library headers
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -30,6 +31,80 @@ namespace dipole{
 
    namespace internal{
 
+      //------------------------------------------------------------------------
+      // Function to compare fields from fft, hierarchical or compressed tensor
+      // solver with the full tensor solver for a sample of local cells, using
+      // the current cell magnetisation. The tensors are calculated one cell at a time
+      // using the first row of the rij tensor arrays as workspace.
+      //------------------------------------------------------------------------
+      void compare_with_tensor_solver(const double cells_macro_cell_size,
+                                          std::vector <int>& cells_num_atoms_in_cell,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                          std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+
+         const int num_samples = std::min(cells_num_local_cells, 10);
+
+         // update cell magnetisations
+         cells::mag();
+
+         const double imuB = 1.0/9.27400915e-24;
+         std::vector<double> mx(cells_num_cells, 0.0);
+         std::vector<double> my(cells_num_cells, 0.0);
+         std::vector<double> mz(cells_num_cells, 0.0);
+         for(int i = 0; i < cells_num_cells; i++){
+            mx[i] = cells::mag_array_x[i]*imuB;
+            my[i] = cells::mag_array_y[i]*imuB;
+            mz[i] = cells::mag_array_z[i]*imuB;
+         }
+
+         std::vector<double> hx(cells_num_local_cells, 0.0);
+         std::vector<double> hy(cells_num_local_cells, 0.0);
+         std::vector<double> hz(cells_num_local_cells, 0.0);
+
+         calculate_tensor_field(mx, my, mz, hx, hy, hz);
+
+         int num_compared = 0;
+         double max_error = 0.0;
+         double sum_sq_error = 0.0;
+
+         for(int s = 0; s < num_samples; s++){
+
+            const int lc = (s*cells_num_local_cells)/num_samples;
+            const int i = cells::cell_id_array[lc];
+            if(cells_num_atoms_in_cell[i] == 0) continue;
+
+            // calculate field with tensor solver
+            double h[3] = {0.0, 0.0, 0.0};
+            for(int j = 0; j < cells_num_cells; j++){
+               if(cells_num_atoms_in_cell[j] == 0) continue;
+               if(i == j) compute_intra_tensor(i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+               else compute_inter_tensor(cells_macro_cell_size, i, j, 0, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+               h[0] += rij_tensor_xx[0][j]*mx[j] + rij_tensor_xy[0][j]*my[j] + rij_tensor_xz[0][j]*mz[j];
+               h[1] += rij_tensor_xy[0][j]*mx[j] + rij_tensor_yy[0][j]*my[j] + rij_tensor_yz[0][j]*mz[j];
+               h[2] += rij_tensor_xz[0][j]*mx[j] + rij_tensor_yz[0][j]*my[j] + rij_tensor_zz[0][j]*mz[j];
+            }
+
+            const double dh[3] = {hx[lc] - h[0], hy[lc] - h[1], hz[lc] - h[2]};
+            const double norm = sqrt(h[0]*h[0] + h[1]*h[1] + h[2]*h[2]);
+            if(norm > 0.0){
+               const double error = sqrt(dh[0]*dh[0] + dh[1]*dh[1] + dh[2]*dh[2])/norm;
+               max_error = std::max(max_error, error);
+               sum_sq_error += error*error;
+               num_compared++;
+            }
+
+         }
+
+         if(num_compared > 0){
+            zlog << zTs() << "Relative difference between fast and full tensor solver dipole fields for " << num_compared << " sampled cells: maximum "
+                 << max_error << ", rms " << sqrt(sum_sq_error/double(num_compared)) << std::endl;
+         }
+
+         return;
+
+      }
+
       //------------------------------------------------------------------------
       // Function to initialise dipole tensors with default scheme.
       //
@@ -146,6 +221,20 @@ namespace dipole{
          // Assign updated value of cells_num_atoms_in_cell to dipole::dipole_cells_num_atoms_in_cell. It is needed to print the config file. The actual value cells::num_atoms_in_cell is not changed instead
          dipole::dipole_cells_num_atoms_in_cell=cells_num_atoms_in_cell;
 
+         // hierarchical solver calculates only near field tensors
+         if(dipole::internal::solver == dipole::internal::hierarchical){
+            initialize_hierarchical_solver(cells_macro_cell_size, cells_num_atoms_in_cell, cells_pos_and_mom_array,
+                                           cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+            return;
+         }
+
+         // store tensors by cell displacement if compressed storage is enabled
+         if(dipole::internal::compressed_tensors){
+            initialize_compressed_tensors(cells_macro_cell_size, cells_num_atoms_in_cell, cells_pos_and_mom_array,
+                                          cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+            return;
+         }
+
          // calculate matrix prefactors
          zlog << zTs() << "Precalculating rij matrix for dipole calculation using tensor solver... " << std::endl;
          std::cout     << "Precalculating rij matrix for dipole calculation using tensor solver"     << std::flush;
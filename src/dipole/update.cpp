@@ -44,6 +44,12 @@ namespace dipole{
 			terminaltextcolor(WHITE);
 		}
 
+      // solvers without full tensor storage calculate fields for all cells together
+      if(!dipole::internal::full_tensor_storage()){
+         dipole::internal::update_cell_fields();
+         return;
+      }
+
       // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
       const double imuB = 1.0/9.27400915e-24;
 
@@ -103,4 +109,128 @@ namespace dipole{
      		}
     	}
 	} // end of dipole::internal::update_field() function
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to determine if the selected solver stores the full cell
+      // tensor (rij_tensor) for each local cell
+      //------------------------------------------------------------------------
+      bool full_tensor_storage(){
+         return solver == macrocell || (solver == tensor && !compressed_tensors);
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the dipole tensor T.m for all local cells from
+      // normalised cell moments m for solvers without full tensor storage
+      //------------------------------------------------------------------------
+      void calculate_tensor_field(const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                                  std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         if(solver == fft || solver == atomistic) fft_convolution(mx, my, mz, hx, hy, hz);
+         else if(solver == hierarchical) hierarchical_field(mx, my, mz, hx, hy, hz);
+         else compressed_tensor_field(mx, my, mz, hx, hy, hz);
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to update dipole fields for solvers which calculate the
+      // tensor field for all local cells together
+      //------------------------------------------------------------------------
+      void update_cell_fields(){
+
+         // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
+         const double imuB = 1.0/9.27400915e-24;
+
+         // Normalise cell magnetisation by the Bohr magneton
+         std::vector<double> mx(cells_num_cells, 0.0);
+         std::vector<double> my(cells_num_cells, 0.0);
+         std::vector<double> mz(cells_num_cells, 0.0);
+
+         for(int i = 0; i < cells_num_cells; i++){
+            mx[i] = cells::mag_array_x[i]*imuB;
+            my[i] = cells::mag_array_y[i]*imuB;
+            mz[i] = cells::mag_array_z[i]*imuB;
+         }
+
+         // calculate dipole tensor contributions for local cells
+         std::vector<double> hx(cells_num_local_cells, 0.0);
+         std::vector<double> hy(cells_num_local_cells, 0.0);
+         std::vector<double> hz(cells_num_local_cells, 0.0);
+
+         calculate_tensor_field(mx, my, mz, hx, hy, hz);
+
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+
+            if(cells_num_atoms_in_cell[i] > 0){
+
+               // Self demagnetisation factor multiplying m(i)
+               const double self_demag = 8.0*M_PI/(3.0*cells_volume_array[i]);
+
+               // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30 (see update.cpp)
+               dipole::cells_field_array_x[i] = hx[lc] * 9.27400915e-01;
+               dipole::cells_field_array_y[i] = hy[lc] * 9.27400915e-01;
+               dipole::cells_field_array_z[i] = hz[lc] * 9.27400915e-01;
+
+               // Add self demag to Hdemag
+               dipole::cells_mu0Hd_field_array_x[i] = (hx[lc] - 0.5*self_demag*mx[i]) * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_y[i] = (hy[lc] - 0.5*self_demag*my[i]) * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_z[i] = (hz[lc] - 0.5*self_demag*mz[i]) * 9.27400915e-01;
+
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate the demagnetisation tensor sum N_i N_j T_ij for
+      // each local cell from the tensor field of the number of atoms in each
+      // cell, for solvers which do not store the full tensor
+      //------------------------------------------------------------------------
+      void calculate_demag_tensor(std::vector<double>& N_tensor_array){
+
+         std::vector<double> num(cells_num_cells, 0.0);
+         std::vector<double> zero(cells_num_cells, 0.0);
+         for(int i = 0; i < cells_num_cells; i++) num[i] = double(cells_num_atoms_in_cell[i]);
+
+         std::vector<double> hx(cells_num_local_cells, 0.0);
+         std::vector<double> hy(cells_num_local_cells, 0.0);
+         std::vector<double> hz(cells_num_local_cells, 0.0);
+
+         // xx, xy and xz components
+         calculate_tensor_field(num, zero, zero, hx, hy, hz);
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+            const int i = cells::cell_id_array[lc];
+            N_tensor_array[6*i+0] = num[i]*hx[lc];
+            N_tensor_array[6*i+1] = num[i]*hy[lc];
+            N_tensor_array[6*i+2] = num[i]*hz[lc];
+         }
+
+         // yy and yz components
+         calculate_tensor_field(zero, num, zero, hx, hy, hz);
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+            const int i = cells::cell_id_array[lc];
+            N_tensor_array[6*i+3] = num[i]*hy[lc];
+            N_tensor_array[6*i+4] = num[i]*hz[lc];
+         }
+
+         // zz component
+         calculate_tensor_field(zero, zero, num, hx, hy, hz);
+         for(int lc = 0; lc < cells_num_local_cells; lc++){
+            const int i = cells::cell_id_array[lc];
+            N_tensor_array[6*i+5] = num[i]*hz[lc];
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
 } // end of dipole namespace
@@ -39,6 +39,11 @@ namespace exchange{
 
       bool use_material_exchange_constants = true; // flag to enable material exchange parameters
 
+      bool use_specialised_kernels = true; // flag to enable fixed neighbour count exchange kernels
+      int fixed_num_neighbours = 0; // number of neighbours per atom for specialised kernels (0 if not used)
+      int num_fixed_neighbour_atoms = 0; // number of atoms which can use specialised kernels
+      bool per_pair_exchange_constants = false; // flag specifying exchange list is indexed by neighbour number
+
    } // end of internal namespace
 
 } // end of exchange namespace
@@ -139,4 +139,106 @@ namespace exchange{
 
    }
 
+   //---------------------------------------------------------------------------
+   // Calculate exchange field acting on a single spin from its neighbours. The
+   // exchange energy of the spin is linear in its direction, E = -H.S, and so
+   // energy differences for trial moves follow from a single field evaluation.
+   // Interactions of an atom with its own periodic image (small periodic
+   // systems) are quadratic in the spin and are excluded from the field;
+   // returns true if any are present.
+   //---------------------------------------------------------------------------
+   bool single_spin_field(const int atom, double& hx, double& hy, double& hz){
+
+      const int start = atoms::neighbour_list_start_index[atom];
+      const int end = atoms::neighbour_list_end_index[atom]+1;
+
+      bool self_image = false;
+
+      // select calculation based on exchange type
+      switch(internal::exchange_type){
+
+         case internal::isotropic:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               if(natom == atom){ self_image = true; continue; }
+               const double Jij = atoms::i_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij;
+               hx += Jij * atoms::x_spin_array[natom];
+               hy += Jij * atoms::y_spin_array[natom];
+               hz += Jij * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case internal::vectorial:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               if(natom == atom){ self_image = true; continue; }
+               const int iid = atoms::neighbour_interaction_type_array[nn];
+               hx += atoms::v_exchange_list[iid].Jij[0] * atoms::x_spin_array[natom];
+               hy += atoms::v_exchange_list[iid].Jij[1] * atoms::y_spin_array[natom];
+               hz += atoms::v_exchange_list[iid].Jij[2] * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case internal::tensorial:
+            for(int nn = start; nn < end; ++nn){
+               const int natom = atoms::neighbour_list_array[nn];
+               if(natom == atom){ self_image = true; continue; }
+               const int iid = atoms::neighbour_interaction_type_array[nn];
+               const double S[3] = {atoms::x_spin_array[natom], atoms::y_spin_array[natom], atoms::z_spin_array[natom]};
+               hx += atoms::t_exchange_list[iid].Jij[0][0] * S[0] + atoms::t_exchange_list[iid].Jij[0][1] * S[1] + atoms::t_exchange_list[iid].Jij[0][2] * S[2];
+               hy += atoms::t_exchange_list[iid].Jij[1][0] * S[0] + atoms::t_exchange_list[iid].Jij[1][1] * S[1] + atoms::t_exchange_list[iid].Jij[1][2] * S[2];
+               hz += atoms::t_exchange_list[iid].Jij[2][0] * S[0] + atoms::t_exchange_list[iid].Jij[2][1] * S[1] + atoms::t_exchange_list[iid].Jij[2][2] * S[2];
+            }
+            break;
+
+      }
+
+      return self_image;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Calculate change in exchange energy of interactions of a spin with its own
+   // periodic images, -S.J.S, for a trial move from old_spin to new_spin
+   //---------------------------------------------------------------------------
+   double self_image_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]){
+
+      double energy = 0.0;
+
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+
+         if(atoms::neighbour_list_array[nn] != atom) continue;
+         const int iid = atoms::neighbour_interaction_type_array[nn];
+
+         switch(internal::exchange_type){
+
+            case internal::isotropic:{
+               const double Jij = atoms::i_exchange_list[iid].Jij;
+               energy -= Jij * (new_spin[0]*new_spin[0] + new_spin[1]*new_spin[1] + new_spin[2]*new_spin[2] -
+                                old_spin[0]*old_spin[0] - old_spin[1]*old_spin[1] - old_spin[2]*old_spin[2]);
+               break;
+            }
+
+            case internal::vectorial:
+               for(int i = 0; i < 3; i++){
+                  energy -= atoms::v_exchange_list[iid].Jij[i] * (new_spin[i]*new_spin[i] - old_spin[i]*old_spin[i]);
+               }
+               break;
+
+            case internal::tensorial:
+               for(int i = 0; i < 3; i++){
+                  for(int j = 0; j < 3; j++){
+                     energy -= atoms::t_exchange_list[iid].Jij[i][j] * (new_spin[i]*new_spin[j] - old_spin[i]*old_spin[j]);
+                  }
+               }
+               break;
+
+         }
+
+      }
+
+      return energy;
+
+   }
+
 } // end of exchange namespace
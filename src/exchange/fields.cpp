@@ -41,12 +41,21 @@ namespace exchange{
                std::vector<double>& field_array_y,
                std::vector<double>& field_array_z){
 
+      // Use fixed neighbour count kernels for regular systems if available
+      if(internal::fixed_num_neighbours > 0 && end_index <= internal::num_fixed_neighbour_atoms){
+         internal::specialised_fields(start_index, end_index, neighbour_list_array, neighbour_interaction_type_array,
+                                      i_exchange_list, v_exchange_list, t_exchange_list,
+                                      spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z);
+         return;
+      }
+
    	// Use appropriate function for exchange calculation
    	switch(internal::exchange_type){
 
    		case internal::isotropic:
 
             // loop over all atoms
+   			#pragma omp parallel for schedule(static)
    			for(int atom = start_index; atom < end_index; ++atom){
 
                // temporary variables (registers) to calculate intermediate sum
@@ -80,6 +89,7 @@ namespace exchange{
    		case internal::vectorial: // vector
 
             // loop over all atoms
+            #pragma omp parallel for schedule(static)
             for(int atom = start_index; atom < end_index; ++atom){
 
                // temporary variables (registers) to calculate intermediate sum
@@ -117,6 +127,7 @@ namespace exchange{
    		case internal::tensorial: // tensor
 
             // loop over all atoms
+            #pragma omp parallel for schedule(static)
             for(int atom = start_index; atom < end_index; ++atom){
 
                // temporary variables (registers) to calculate intermediate sum
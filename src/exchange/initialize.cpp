@@ -95,6 +95,9 @@ namespace exchange{
       // Calculate Dzyaloshinskii-Moriya interactions (must be done after exchange unrolling)
       exchange::internal::calculate_dmi(cneighbourlist);
 
+      // Check for fixed number of neighbours for specialised kernels (must be done after dmi calculation)
+      exchange::internal::initialize_specialised_kernels();
+
       return;
 
    }
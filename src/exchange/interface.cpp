@@ -42,6 +42,34 @@ namespace exchange{
           return true;
       }
       //--------------------------------------------------------------------
+      test="specialised-kernels";
+      if(word==test){
+         test="";
+         if(value==test){
+            internal::use_specialised_kernels = true;
+            return true;
+         }
+         // default
+         test="true";
+         if(value==test){
+            internal::use_specialised_kernels = true;
+            return true;
+         }
+         test="false";
+         if(value==test){
+            internal::use_specialised_kernels = false;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"true\"" << std::endl;
+            std::cerr << "\t\"false\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
+      //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
       return false;
@@ -76,12 +76,26 @@ namespace exchange{
 
       extern bool use_material_exchange_constants; // flag to enable material exchange parameters
 
+      extern bool use_specialised_kernels; // flag to enable fixed neighbour count exchange kernels
+      extern int fixed_num_neighbours; // number of neighbours per atom for specialised kernels (0 if not used)
+      extern int num_fixed_neighbour_atoms; // number of atoms which can use specialised kernels
+      extern bool per_pair_exchange_constants; // flag specifying exchange list is indexed by neighbour number
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
       void calculate_dmi(std::vector<std::vector <cs::neighbour_t> >& cneighbourlist);
       void unroll_exchange_interactions();
       void unroll_normalised_exchange_interactions();
+      void initialize_specialised_kernels();
+      void specialised_fields(const int start_index, const int end_index,
+                              const std::vector<int>& neighbour_list_array,
+                              const std::vector<int>& neighbour_interaction_type_array,
+                              const std::vector <zval_t>& i_exchange_list,
+                              const std::vector <zvec_t>& v_exchange_list,
+                              const std::vector <zten_t>& t_exchange_list,
+                              const std::vector<double>& spin_array_x, const std::vector<double>& spin_array_y, const std::vector<double>& spin_array_z,
+                              std::vector<double>& field_array_x, std::vector<double>& field_array_y, std::vector<double>& field_array_z);
 
    } // end of internal namespace
 
@@ -0,0 +1,262 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "atoms.hpp" // for exchange list type defs
+#include "exchange.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   namespace internal{
+
+      //-----------------------------------------------------------------------------
+      // Functions to add the exchange field from a single neighbour
+      //-----------------------------------------------------------------------------
+      inline void add_neighbour_field(const zval_t& J, const double sx, const double sy, const double sz,
+                                      double& hx, double& hy, double& hz){
+         hx += J.Jij * sx;
+         hy += J.Jij * sy;
+         hz += J.Jij * sz;
+      }
+
+      inline void add_neighbour_field(const zvec_t& J, const double sx, const double sy, const double sz,
+                                      double& hx, double& hy, double& hz){
+         hx += J.Jij[0] * sx;
+         hy += J.Jij[1] * sy;
+         hz += J.Jij[2] * sz;
+      }
+
+      inline void add_neighbour_field(const zten_t& J, const double sx, const double sy, const double sz,
+                                      double& hx, double& hy, double& hz){
+         hx += ( J.Jij[0][0] * sx + J.Jij[0][1] * sy + J.Jij[0][2] * sz);
+         hy += ( J.Jij[1][0] * sx + J.Jij[1][1] * sy + J.Jij[1][2] * sz);
+         hz += ( J.Jij[2][0] * sx + J.Jij[2][1] * sy + J.Jij[2][2] * sz);
+      }
+
+      //-----------------------------------------------------------------------------
+      // Exchange field kernel for exactly N neighbours per atom. The neighbour
+      // loop has a compile time trip count and is unrolled by the compiler, and
+      // the start and end index arrays are not needed. If the exchange list is
+      // indexed by neighbour number (per_pair) the exchange constants are read
+      // in the same order as the neighbour list, avoiding the interaction type
+      // look up.
+      //-----------------------------------------------------------------------------
+      template <int N, bool per_pair, class T>
+      void fixed_neighbour_fields(const int start_index, const int end_index,
+                                  const std::vector<int>& neighbour_list_array,
+                                  const std::vector<int>& neighbour_interaction_type_array,
+                                  const std::vector<T>& exchange_list,
+                                  const std::vector<double>& spin_array_x, const std::vector<double>& spin_array_y, const std::vector<double>& spin_array_z,
+                                  std::vector<double>& field_array_x, std::vector<double>& field_array_y, std::vector<double>& field_array_z){
+
+         // loop over all atoms
+         #pragma omp parallel for schedule(static)
+         for(int atom = start_index; atom < end_index; ++atom){
+
+            // temporary variables (registers) to calculate intermediate sum
+            double hx = 0.0;
+            double hy = 0.0;
+            double hz = 0.0;
+
+            // neighbours for each atom are stored contiguously with stride N
+            const int start = N*atom;
+
+            // loop over all neighbours
+            for(int nn = 0; nn < N; ++nn){
+
+               const int natom = neighbour_list_array[start+nn]; // get neighbouring atom number
+               const int iid = per_pair ? start+nn : neighbour_interaction_type_array[start+nn]; // interaction id
+
+               add_neighbour_field(exchange_list[iid], spin_array_x[natom], spin_array_y[natom], spin_array_z[natom], hx, hy, hz);
+
+            }
+
+            field_array_x[atom] += hx; // save total field to field array
+            field_array_y[atom] += hy;
+            field_array_z[atom] += hz;
+
+         }
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to select kernel for the number of neighbours in the system
+      //-----------------------------------------------------------------------------
+      template <bool per_pair, class T>
+      void select_fixed_neighbour_kernel(const int start_index, const int end_index,
+                                         const std::vector<int>& nl, // neighbour list array
+                                         const std::vector<int>& it, // neighbour interaction type array
+                                         const std::vector<T>& el, // exchange list
+                                         const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                                         std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         switch(fixed_num_neighbours){
+            case 6: // simple cubic and rocksalt nearest neighbours
+               fixed_neighbour_fields<6, per_pair>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+               break;
+            case 8: // body centred cubic nearest neighbours
+               fixed_neighbour_fields<8, per_pair>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+               break;
+            case 12: // face centred cubic and hexagonal close packed nearest neighbours
+               fixed_neighbour_fields<12, per_pair>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+               break;
+            case 14: // body centred cubic next nearest neighbours
+               fixed_neighbour_fields<14, per_pair>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+               break;
+            case 18: // simple cubic and face centred cubic next nearest neighbours
+               fixed_neighbour_fields<18, per_pair>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+               break;
+         }
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to select kernel for the storage of the exchange list
+      //-----------------------------------------------------------------------------
+      template <class T>
+      void select_exchange_list_kernel(const int start_index, const int end_index,
+                                       const std::vector<int>& nl, // neighbour list array
+                                       const std::vector<int>& it, // neighbour interaction type array
+                                       const std::vector<T>& el, // exchange list
+                                       const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                                       std::vector<double>& hx, std::vector<double>& hy, std::vector<double>& hz){
+
+         if(per_pair_exchange_constants) select_fixed_neighbour_kernel<true>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+         else select_fixed_neighbour_kernel<false>(start_index, end_index, nl, it, el, sx, sy, sz, hx, hy, hz);
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to determine if a kernel exists for a number of neighbours
+      //-----------------------------------------------------------------------------
+      bool is_supported_neighbour_count(const int num_neighbours){
+         switch(num_neighbours){
+            case 6:
+            case 8:
+            case 12:
+            case 14:
+            case 18:
+               return true;
+            default:
+               return false;
+         }
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to calculate exchange fields using fixed neighbour count kernels
+      //-----------------------------------------------------------------------------
+      void specialised_fields(const int start_index, const int end_index,
+                              const std::vector<int>& neighbour_list_array,
+                              const std::vector<int>& neighbour_interaction_type_array,
+                              const std::vector <zval_t>& i_exchange_list,
+                              const std::vector <zvec_t>& v_exchange_list,
+                              const std::vector <zten_t>& t_exchange_list,
+                              const std::vector<double>& spin_array_x, const std::vector<double>& spin_array_y, const std::vector<double>& spin_array_z,
+                              std::vector<double>& field_array_x, std::vector<double>& field_array_y, std::vector<double>& field_array_z){
+
+         switch(exchange_type){
+
+            case isotropic:
+               select_exchange_list_kernel(start_index, end_index, neighbour_list_array, neighbour_interaction_type_array, i_exchange_list,
+                                           spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z);
+               break;
+
+            case vectorial:
+               select_exchange_list_kernel(start_index, end_index, neighbour_list_array, neighbour_interaction_type_array, v_exchange_list,
+                                           spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z);
+               break;
+
+            case tensorial:
+               select_exchange_list_kernel(start_index, end_index, neighbour_list_array, neighbour_interaction_type_array, t_exchange_list,
+                                           spin_array_x, spin_array_y, spin_array_z, field_array_x, field_array_y, field_array_z);
+               break;
+
+         }
+
+         return;
+
+      }
+
+      //-----------------------------------------------------------------------------
+      // Function to check if every atom has the same number of neighbours, so
+      // that specialised kernels can be used. Irregular systems (surfaces,
+      // vacancies, non-periodic boundaries) use the generic kernels.
+      //-----------------------------------------------------------------------------
+      void initialize_specialised_kernels(){
+
+         fixed_num_neighbours = 0;
+         num_fixed_neighbour_atoms = 0;
+         per_pair_exchange_constants = false;
+
+         if(use_specialised_kernels == false) return;
+
+         // Determine number of local atoms for which fields are calculated
+         #ifdef MPICF
+            const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+         #else
+            const int num_local_atoms = atoms::num_atoms;
+         #endif
+
+         if(num_local_atoms == 0) return;
+
+         // Check for supported number of neighbours
+         const int num_neighbours = atoms::neighbour_list_end_index[0] - atoms::neighbour_list_start_index[0] + 1;
+         if(is_supported_neighbour_count(num_neighbours) == false){
+            zlog << zTs() << "No specialised exchange kernel for " << num_neighbours << " neighbours, using generic exchange calculation." << std::endl;
+            return;
+         }
+
+         // Check for same number of neighbours for all local atoms with contiguous storage
+         for(int atom = 0; atom < num_local_atoms; ++atom){
+            const int start = atoms::neighbour_list_start_index[atom];
+            const int end   = atoms::neighbour_list_end_index[atom]+1;
+            if(start != num_neighbours*atom || end - start != num_neighbours){
+               zlog << zTs() << "Number of neighbours varies between atoms, using generic exchange calculation." << std::endl;
+               return;
+            }
+         }
+
+         // Check if exchange list is indexed by neighbour number (normalised exchange)
+         per_pair_exchange_constants = true;
+         const int num_interactions = num_neighbours*num_local_atoms;
+         for(int nn = 0; nn < num_interactions; ++nn){
+            if(atoms::neighbour_interaction_type_array[nn] != nn){
+               per_pair_exchange_constants = false;
+               break;
+            }
+         }
+
+         fixed_num_neighbours = num_neighbours;
+         num_fixed_neighbour_atoms = num_local_atoms;
+
+         zlog << zTs() << "Using specialised exchange kernel for " << fixed_num_neighbours << " neighbours per atom";
+         if(per_pair_exchange_constants) zlog << " with exchange constants stored per neighbour." << std::endl;
+         else zlog << " with exchange constants stored per interaction type." << std::endl;
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
+} // end of exchange namespace
@@ -12,6 +12,7 @@
 #include <algorithm>
 
 // Vampire headers
+#include "atoms.hpp"
 #include "ltmp.hpp"
 #include "random.hpp"
 
@@ -33,9 +34,16 @@ namespace ltmp{
       const int num_local_atoms = ltmp::internal::num_local_atoms;
 
       // Initialise thermal field random numbers
-      generate (ltmp::internal::x_field_array.begin(),ltmp::internal::x_field_array.begin()+num_local_atoms, mtrandom::gaussian);
-      generate (ltmp::internal::y_field_array.begin(),ltmp::internal::y_field_array.begin()+num_local_atoms, mtrandom::gaussian);
-      generate (ltmp::internal::z_field_array.begin(),ltmp::internal::z_field_array.begin()+num_local_atoms, mtrandom::gaussian);
+      if(mtrandom::counter_based){
+         mtrandom::gaussian_block(mtrandom::ltmp_stream, atoms::global_id_array,
+                                  ltmp::internal::x_field_array, ltmp::internal::y_field_array, ltmp::internal::z_field_array,
+                                  0, num_local_atoms);
+      }
+      else{
+         mtrandom::gaussian_array(ltmp::internal::x_field_array, 0, num_local_atoms);
+         mtrandom::gaussian_array(ltmp::internal::y_field_array, 0, num_local_atoms);
+         mtrandom::gaussian_array(ltmp::internal::z_field_array, 0, num_local_atoms);
+      }
 
       // check for temperature rescaling
       if(ltmp::internal::temperature_rescaling){
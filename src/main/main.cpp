@@ -26,6 +26,7 @@
 #include <vector>
 #include <sstream>
 
+#include "config.hpp"
 #include "create.hpp"
 #include "errors.hpp"
 #include "info.hpp"
@@ -127,6 +128,9 @@ int main(int argc, char* argv[]){
    // Simulate system
    sim::run();
 
+   // Complete outstanding data output
+   config::finalize();
+
    // Finalise MPI
    #ifdef MPICF
       vmpi::finalise();
@@ -33,6 +33,7 @@
 #include <cmath>
 
 int calculate_spin_fields(const int,const int);
+int calculate_core_spin_fields(const int,const int);
 int calculate_external_fields(const int,const int);
 int set_LLG();
 
@@ -72,27 +73,18 @@ int LLG_Heun_mpi(){
 		//----------------------------------------
 		vmpi::mpi_init_halo_swap();
 
-		//----------------------------------------
-		// Store initial spin positions (all)
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			x_initial_spin_array[atom] = atoms::x_spin_array[atom];
-			y_initial_spin_array[atom] = atoms::y_spin_array[atom];
-			z_initial_spin_array[atom] = atoms::z_spin_array[atom];
-			}
-
 		//----------------------------------------
 		// Calculate fields (core)
 		//----------------------------------------
 
-		calculate_spin_fields(pre_comm_si,pre_comm_ei);
+		calculate_core_spin_fields(pre_comm_si,pre_comm_ei);
 		calculate_external_fields(pre_comm_si,pre_comm_ei);
 
 		//----------------------------------------
 		// Calculate Euler Step (Core)
 		//----------------------------------------
 
+		#pragma omp parallel for private(xyz,S_new,mod_S) schedule(static)
 		for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
 
 			const int imaterial=atoms::type_array[atom];
@@ -149,6 +141,7 @@ int LLG_Heun_mpi(){
 		// Calculate Euler Step (boundary)
 		//----------------------------------------
 
+		#pragma omp parallel for private(xyz,S_new,mod_S) schedule(static)
 		for(int atom=post_comm_si;atom<post_comm_ei;atom++){
 
 			const int imaterial=atoms::type_array[atom];
@@ -189,14 +182,12 @@ int LLG_Heun_mpi(){
 			z_spin_storage_array[atom]=S_new[2];
 		}
 
-		//----------------------------------------
-		// Copy new spins to spin array (all)
-		//----------------------------------------
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			atoms::x_spin_array[atom]=x_spin_storage_array[atom];
-			atoms::y_spin_array[atom]=y_spin_storage_array[atom];
-			atoms::z_spin_array[atom]=z_spin_storage_array[atom];
-		}
+		//----------------------------------------------------------------
+		// Swap new spins into spin array (all), storage keeps initial spins
+		//----------------------------------------------------------------
+		atoms::x_spin_array.swap(x_spin_storage_array);
+		atoms::y_spin_array.swap(y_spin_storage_array);
+		atoms::z_spin_array.swap(z_spin_storage_array);
 
 		//------------------------------------------
 		// Initiate second halo swap
@@ -207,34 +198,7 @@ int LLG_Heun_mpi(){
 		// Recalculate spin dependent fields (core)
 		//------------------------------------------
 
-		calculate_spin_fields(pre_comm_si,pre_comm_ei);
-
-		//----------------------------------------
-		// Calculate Heun Gradients (core)
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
-
-			const int imaterial=atoms::type_array[atom];;
-			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
-			const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
-
-			// Store local spin in Sand local field in H
-			const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
-			const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
-										atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
-										atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
-
-			// Calculate Delta S
-			xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
-			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
-			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
-
-			// Store dS in heun array
-			x_heun_array[atom]=xyz[0];
-			y_heun_array[atom]=xyz[1];
-			z_heun_array[atom]=xyz[2];
-		}
+		calculate_core_spin_fields(pre_comm_si,pre_comm_ei);
 
 		//------------------------------------------
 		// Complete second halo swap
@@ -248,10 +212,11 @@ int LLG_Heun_mpi(){
 		calculate_spin_fields(post_comm_si,post_comm_ei);
 
 		//----------------------------------------
-		// Calculate Heun Gradients (boundary)
+		// Calculate Heun Gradients and Step (all)
 		//----------------------------------------
 
-		for(int atom=post_comm_si;atom<post_comm_ei;atom++){
+		#pragma omp parallel for private(xyz,S_new,mod_S) schedule(static)
+		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
 
 			const int imaterial=atoms::type_array[atom];;
 			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
@@ -268,20 +233,10 @@ int LLG_Heun_mpi(){
 			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-			// Store dS in heun array
-			x_heun_array[atom]=xyz[0];
-			y_heun_array[atom]=xyz[1];
-			z_heun_array[atom]=xyz[2];
-		}
-
-		//----------------------------------------
-		// Calculate Heun Step
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			S_new[0]=x_initial_spin_array[atom]+material_parameters::half_dt*(x_euler_array[atom]+x_heun_array[atom]);
-			S_new[1]=y_initial_spin_array[atom]+material_parameters::half_dt*(y_euler_array[atom]+y_heun_array[atom]);
-			S_new[2]=z_initial_spin_array[atom]+material_parameters::half_dt*(z_euler_array[atom]+z_heun_array[atom]);
+			// Calculate Heun Step from initial spin
+			S_new[0]=x_spin_storage_array[atom]+material_parameters::half_dt*(x_euler_array[atom]+xyz[0]);
+			S_new[1]=y_spin_storage_array[atom]+material_parameters::half_dt*(y_euler_array[atom]+xyz[1]);
+			S_new[2]=z_spin_storage_array[atom]+material_parameters::half_dt*(z_euler_array[atom]+xyz[2]);
 
 			// Normalise Spin Length
 			mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
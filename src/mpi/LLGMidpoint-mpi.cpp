@@ -35,6 +35,7 @@
 #include <cmath>
 
 int calculate_spin_fields(const int,const int);
+int calculate_core_spin_fields(const int,const int);
 int calculate_external_fields(const int,const int);
 int set_LLG();
 
@@ -60,6 +61,7 @@ int LLG_Midpoint_mpi(){
 	vmpi::mpi_init_halo_swap();
 
 	// Store initial spin positions (all)
+	#pragma omp parallel for schedule(static)
 	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
 		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
 		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
@@ -67,10 +69,11 @@ int LLG_Midpoint_mpi(){
 		}
 
 	// Calculate fields (core)
-	calculate_spin_fields(pre_comm_si,pre_comm_ei);
+	calculate_core_spin_fields(pre_comm_si,pre_comm_ei);
 	calculate_external_fields(pre_comm_si,pre_comm_ei);
 
 	// Calculate Predictor Step (Core)
+	#pragma omp parallel for schedule(static)
 	for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
 
 		const int imaterial=atoms::type_array[atom];
@@ -110,6 +113,7 @@ int LLG_Midpoint_mpi(){
 	calculate_external_fields(post_comm_si,post_comm_ei);
 
 	// Calculate Predictor Step (boundary)
+	#pragma omp parallel for schedule(static)
 	for(int atom=post_comm_si;atom<post_comm_ei;atom++){
 
 		const int imaterial=atoms::type_array[atom];
@@ -141,6 +145,7 @@ int LLG_Midpoint_mpi(){
 	}
 
 	// Copy new spins to spin array (all)
+	#pragma omp parallel for schedule(static)
 	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
 		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
 		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
@@ -151,9 +156,10 @@ int LLG_Midpoint_mpi(){
 	vmpi::mpi_init_halo_swap();
 
 	// Recalculate spin dependent fields (core)
-	calculate_spin_fields(pre_comm_si,pre_comm_ei);
+	calculate_core_spin_fields(pre_comm_si,pre_comm_ei);
 
 	// Calculate Corrector Step (core)
+	#pragma omp parallel for schedule(static)
 	for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
 
 		const int imaterial=atoms::type_array[atom];
@@ -191,6 +197,7 @@ int LLG_Midpoint_mpi(){
 	calculate_spin_fields(post_comm_si,post_comm_ei);
 
 	// Calculate Corrector Step (boundary)
+	#pragma omp parallel for schedule(static)
 	for(int atom=post_comm_si;atom<post_comm_ei;atom++){
 
 		const int imaterial=atoms::type_array[atom];
@@ -222,6 +229,7 @@ int LLG_Midpoint_mpi(){
 	}
 
 	// Copy new spins to spin array (all)
+	#pragma omp parallel for schedule(static)
 	for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
 		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
 		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
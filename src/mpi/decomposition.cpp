@@ -34,6 +34,51 @@ namespace vmpi{
    // Forward function declaration
    dim_t decompose(int id, int num_blocks, dim_t dimensions, std::string segment_name, std::string segment_type);
 
+   //------------------------------------------------------------------------------
+   // Function to determine the number of processors per shared memory node.
+   //
+   // The node decomposition assumes that processors on each node have
+   // consecutive ranks and that all nodes except the last have the same number
+   // of processors. If this is not the case, 1 is returned and the system is
+   // decomposed per processor.
+   //------------------------------------------------------------------------------
+   unsigned int processors_per_node(){
+
+      int ppn = 1;
+
+      #ifdef MPICF
+
+         // split processors into shared memory nodes
+         MPI_Comm node_comm;
+         MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, vmpi::my_rank, MPI_INFO_NULL, &node_comm);
+
+         int node_rank = 0;
+         int node_size = 1;
+         MPI_Comm_rank(node_comm, &node_rank);
+         MPI_Comm_size(node_comm, &node_size);
+         MPI_Comm_free(&node_comm);
+
+         // maximum node size
+         MPI_Allreduce(&node_size, &ppn, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+         // check node layout is consistent with node decomposition
+         int consistent = (vmpi::my_rank/ppn == (vmpi::my_rank - node_rank)/ppn && node_rank == vmpi::my_rank%ppn) ? 1 : 0;
+         MPI_Allreduce(MPI_IN_PLACE, &consistent, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+         if(consistent == 1){
+            zlog << zTs() << "Detected " << ppn << " processors per shared memory node for decomposition" << std::endl;
+         }
+         else{
+            zlog << zTs() << "Warning: processors are not numbered consecutively on shared memory nodes - using decomposition per processor" << std::endl;
+            ppn = 1;
+         }
+
+      #endif
+
+      return ppn;
+
+   }
+
    //------------------------------------------------------------------------------
    // Function to subdivide system into cubic blocks with topology awareness
    //------------------------------------------------------------------------------
@@ -53,6 +98,9 @@ namespace vmpi{
       // declare local range
       dim_t local_dimensions;
 
+      // determine number of processors per node if requested
+      if(vmpi::ppn == 0) vmpi::ppn = processors_per_node();
+
       // If no node topology required, decompose per processor
       if(vmpi::ppn == 1){
 
@@ -0,0 +1,285 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Vampire headers
+#include "create.hpp"
+#include "errors.hpp"
+#include "vmpi.hpp"
+#include "vio.hpp"
+
+namespace vmpi{
+
+   // maximum number of bins in each direction for weight histogram
+   const int max_bins = 64;
+
+   //------------------------------------------------------------------------------
+   // Function to recursively bisect a block of bins between processors so that
+   // the total weight of each part is proportional to its number of processors
+   //------------------------------------------------------------------------------
+   bool bisect(const std::vector<double>& weight, const int nb[3], const double bin_size[3],
+               int lo[3], int hi[3], int first_cpu, int num_cpus, std::vector<int>& block_array){
+
+      // single processor takes whole block
+      if(num_cpus == 1){
+         for(int d = 0; d < 3; d++){
+            block_array[6*first_cpu+d]   = lo[d];
+            block_array[6*first_cpu+3+d] = hi[d];
+         }
+         return true;
+      }
+
+      // cut along longest direction which can be divided
+      int axis = -1;
+      double length = 0.0;
+      for(int d = 0; d < 3; d++){
+         const double l = double(hi[d]-lo[d])*bin_size[d];
+         if(hi[d]-lo[d] > 1 && l > length){
+            axis = d;
+            length = l;
+         }
+      }
+
+      // block cannot be divided further
+      if(axis < 0) return false;
+
+      // calculate weight of each slice along axis
+      std::vector<double> slice(hi[axis]-lo[axis], 0.0);
+      for(int i = lo[0]; i < hi[0]; i++){
+         for(int j = lo[1]; j < hi[1]; j++){
+            for(int k = lo[2]; k < hi[2]; k++){
+               const int s[3] = {i, j, k};
+               slice[s[axis]-lo[axis]] += weight[(i*nb[1]+j)*nb[2]+k];
+            }
+         }
+      }
+
+      double total = 0.0;
+      for(unsigned int s = 0; s < slice.size(); s++) total += slice[s];
+
+      // split processors and find cut closest to proportional weight
+      const int num_cpus_lower = num_cpus/2;
+      const double fraction = double(num_cpus_lower)/double(num_cpus);
+
+      int cut = lo[axis] + (hi[axis]-lo[axis])/2; // halve volume if block is empty
+      if(total > 0.0){
+         const double target = total*fraction;
+         double sum = 0.0;
+         double best = total;
+         for(int s = 1; s < hi[axis]-lo[axis]; s++){
+            sum += slice[s-1];
+            if(fabs(sum-target) < best){
+               best = fabs(sum-target);
+               cut = lo[axis] + s;
+            }
+         }
+      }
+
+      // recursively divide lower and upper blocks
+      int lower_hi[3] = {hi[0], hi[1], hi[2]};
+      int upper_lo[3] = {lo[0], lo[1], lo[2]};
+      lower_hi[axis] = cut;
+      upper_lo[axis] = cut;
+
+      if(!bisect(weight, nb, bin_size, lo, lower_hi, first_cpu, num_cpus_lower, block_array)) return false;
+      if(!bisect(weight, nb, bin_size, upper_lo, hi, first_cpu+num_cpus_lower, num_cpus-num_cpus_lower, block_array)) return false;
+
+      return true;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to calibrate the cost of an atom relative to one exchange
+   // interaction from the MPI-load-weights file written by a previous run with
+   // output:mpi-timings. The compute time of each processor is fitted by least
+   // squares to a cost per atom and a cost per interaction. Returns the weight
+   // set in the input file if the timings cannot separate the two costs, for
+   // example when all processors have the same ratio of interactions to atoms.
+   //------------------------------------------------------------------------------
+   double calibrate_atom_weight(){
+
+      double atom_weight = vmpi::load_balancing_atom_weight;
+
+      #ifdef MPICF
+
+         if(vmpi::my_rank == 0){
+
+            std::ifstream ifile(vmpi::load_balancing_timings_file.c_str());
+
+            if(!ifile.is_open()){
+               terminaltextcolor(RED);
+               std::cerr << "Error: Unable to open MPI timings file " << vmpi::load_balancing_timings_file << " for load balancing. Exiting." << std::endl;
+               terminaltextcolor(WHITE);
+               zlog << zTs() << "Error: Unable to open MPI timings file " << vmpi::load_balancing_timings_file << " for load balancing. Exiting." << std::endl;
+               err::vexit();
+            }
+
+            // sums for normal equations of time = a*atoms + b*interactions
+            double saa = 0.0, sab = 0.0, sbb = 0.0, sat = 0.0, sbt = 0.0;
+            int num_ranks = 0;
+
+            std::string line;
+            while(std::getline(ifile, line)){
+               if(line.empty() || line[0] == '#') continue;
+               std::istringstream iss(line);
+               int rank;
+               double num_atoms, num_interactions, time;
+               if(!(iss >> rank >> num_atoms >> num_interactions >> time)) continue;
+               saa += num_atoms*num_atoms;
+               sab += num_atoms*num_interactions;
+               sbb += num_interactions*num_interactions;
+               sat += num_atoms*time;
+               sbt += num_interactions*time;
+               num_ranks++;
+            }
+            ifile.close();
+
+            const double det = saa*sbb - sab*sab;
+            const double cost_atom        = det > 0.0 ? (sat*sbb - sbt*sab)/det : 0.0;
+            const double cost_interaction = det > 0.0 ? (saa*sbt - sab*sat)/det : 0.0;
+
+            // require well conditioned fit with positive costs
+            if(num_ranks > 1 && det > 1.0e-9*saa*sbb && cost_atom > 0.0 && cost_interaction > 0.0){
+               atom_weight = cost_atom/cost_interaction;
+               zlog << zTs() << "Calibrated load balancing atom weight from " << num_ranks << " processors in " << vmpi::load_balancing_timings_file << ": " << atom_weight << std::endl;
+            }
+            else{
+               zlog << zTs() << "Warning: timings in " << vmpi::load_balancing_timings_file << " cannot separate atom and interaction costs - using load balancing atom weight " << atom_weight << std::endl;
+            }
+
+         }
+
+         MPI_Bcast(&atom_weight, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+      #endif
+
+      return atom_weight;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to rebalance the geometric decomposition using the atoms created
+   // with the initial decomposition.
+   //
+   // Each atom is weighted by a constant cost plus its number of exchange
+   // interactions, and the weights are collected on a global grid of bins.
+   // The constant is set by sim:mpi-load-balancing-atom-weight, or calibrated
+   // from measured compute times of a previous run.
+   // The system is then divided by recursive bisection along the longest
+   // direction so that all processors have the same total weight. Returns
+   // true if the decomposition has changed and the system must be created
+   // again. The decomposition is only balanced at startup and does not change
+   // during the simulation.
+   //------------------------------------------------------------------------------
+   bool balance_decomposition(std::vector<cs::catom_t>& catom_array, double system_size[3]){
+
+      #ifdef MPICF
+
+         // relative cost of integrating an atom compared to one exchange interaction
+         const double atom_weight = vmpi::load_balancing_timings_file.empty() ? vmpi::load_balancing_atom_weight : calibrate_atom_weight();
+
+         // number of exchange interactions for each atom in unit cell
+         std::vector<double> num_interactions(cs::unit_cell.atom.size(), 0.0);
+         for(unsigned int itr = 0; itr < cs::unit_cell.interaction.size(); itr++){
+            num_interactions[cs::unit_cell.interaction[itr].i] += 1.0;
+         }
+
+         // determine bins (no smaller than unit cell)
+         int nb[3];
+         double bin_size[3];
+         for(int d = 0; d < 3; d++){
+            nb[d] = std::max(1, std::min(max_bins, int(cs::total_num_unit_cells[d])));
+            bin_size[d] = system_size[d]/double(nb[d]);
+         }
+
+         // calculate local weights
+         std::vector<double> weight(nb[0]*nb[1]*nb[2], 0.0);
+         double local_weight = 0.0;
+
+         for(unsigned int atom = 0; atom < catom_array.size(); atom++){
+            const int i = std::min(nb[0]-1, std::max(0, int(catom_array[atom].x/bin_size[0])));
+            const int j = std::min(nb[1]-1, std::max(0, int(catom_array[atom].y/bin_size[1])));
+            const int k = std::min(nb[2]-1, std::max(0, int(catom_array[atom].z/bin_size[2])));
+            const double w = atom_weight + num_interactions[catom_array[atom].uc_id];
+            weight[(i*nb[1]+j)*nb[2]+k] += w;
+            local_weight += w;
+         }
+
+         MPI_Allreduce(MPI_IN_PLACE, &weight[0], weight.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+         // calculate imbalance of initial decomposition
+         double max_weight = 0.0;
+         double total_weight = 0.0;
+         MPI_Allreduce(&local_weight, &max_weight, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+         MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+         const double initial_imbalance = max_weight*double(vmpi::num_processors)/total_weight;
+
+         // divide bins between processors (same on all processors)
+         std::vector<int> block_array(6*vmpi::num_processors, 0);
+         int lo[3] = {0, 0, 0};
+         int hi[3] = {nb[0], nb[1], nb[2]};
+
+         if(!bisect(weight, nb, bin_size, lo, hi, 0, vmpi::num_processors, block_array)){
+            zlog << zTs() << "Warning: system too small to rebalance decomposition for " << vmpi::num_processors << " processors - using equal volume decomposition" << std::endl;
+            return false;
+         }
+
+         // calculate imbalance of new decomposition
+         std::vector<double> block_weight(vmpi::num_processors, 0.0);
+         for(int p = 0; p < vmpi::num_processors; p++){
+            for(int i = block_array[6*p+0]; i < block_array[6*p+3]; i++){
+               for(int j = block_array[6*p+1]; j < block_array[6*p+4]; j++){
+                  for(int k = block_array[6*p+2]; k < block_array[6*p+5]; k++){
+                     block_weight[p] += weight[(i*nb[1]+j)*nb[2]+k];
+                  }
+               }
+            }
+         }
+         const double balanced_imbalance = *std::max_element(block_weight.begin(), block_weight.end())*double(vmpi::num_processors)/total_weight;
+
+         zlog << zTs() << "Load imbalance (maximum/average weight) of equal volume decomposition: " << initial_imbalance << std::endl;
+         zlog << zTs() << "Load imbalance (maximum/average weight) of balanced decomposition: " << balanced_imbalance << std::endl;
+
+         // keep original decomposition if no improvement
+         if(balanced_imbalance >= initial_imbalance) return false;
+
+         // set local dimensions, with outer boundaries equal to system size
+         for(int d = 0; d < 3; d++){
+            const int bmin = block_array[6*vmpi::my_rank+d];
+            const int bmax = block_array[6*vmpi::my_rank+3+d];
+            vmpi::min_dimensions[d] = bmin == 0     ? 0.0            : double(bmin)*bin_size[d];
+            vmpi::max_dimensions[d] = bmax == nb[d] ? system_size[d] : double(bmax)*bin_size[d];
+         }
+
+         if(vmpi::my_rank == 0){
+            std::cout << "Rebalanced decomposition with load imbalance " << balanced_imbalance << " (equal volume " << initial_imbalance << ")" << std::endl;
+         }
+
+         return true;
+
+      #else
+
+         // decomposition is unchanged for a single processor
+         (void)catom_array;
+         (void)system_size;
+
+         return false;
+
+      #endif
+
+   }
+
+} // end of namespace vmpi
@@ -42,6 +42,67 @@
 
 namespace vmpi{
 
+//-----------------------------------------------------------------------------
+// Function to create persistent requests for halo swap of spin data
+//
+// The send and receive buffers are fixed after init_mpi_comms, so the
+// requests are created once and restarted for every halo swap. Receives are
+// created first so that they are posted before the sends.
+//-----------------------------------------------------------------------------
+void init_halo_swap_requests(){
+
+#ifdef MPICF
+	// free any existing requests
+	vmpi::free_halo_swap_requests();
+
+	for (int p=0;p<vmpi::num_processors;p++){
+		if(vmpi::recv_num_array[p]!=0){
+			int num_pts = 3*vmpi::recv_num_array[p];
+			int si = 3*vmpi::recv_start_index_array[p];
+			MPI_Request req;
+			MPI_Recv_init(&vmpi::recv_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &req);
+			vmpi::requests.push_back(req);
+			vmpi::request_peer_array.push_back(p);
+		}
+	}
+	for (int p=0;p<vmpi::num_processors;p++){
+		if(vmpi::send_num_array[p]!=0){
+			int num_pts = 3*vmpi::send_num_array[p];
+			int si = 3*vmpi::send_start_index_array[p];
+			MPI_Request req;
+			MPI_Send_init(&vmpi::send_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &req);
+			vmpi::requests.push_back(req);
+			vmpi::request_peer_array.push_back(p);
+		}
+	}
+
+	vmpi::stati.resize(vmpi::requests.size());
+
+	// initialise timing and data volume for each processor
+	vmpi::PeerWaitTimeArray.assign(vmpi::num_processors,0.0);
+	vmpi::PeerSendBytesArray.assign(vmpi::num_processors,0.0);
+	vmpi::PeerRecvBytesArray.assign(vmpi::num_processors,0.0);
+#endif
+
+	return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to free persistent requests for halo swap
+//-----------------------------------------------------------------------------
+void free_halo_swap_requests(){
+
+#ifdef MPICF
+	for(unsigned int r=0;r<vmpi::requests.size();r++) MPI_Request_free(&vmpi::requests[r]);
+	vmpi::requests.resize(0);
+	vmpi::request_peer_array.resize(0);
+#endif
+
+	return;
+
+}
+
 void mpi_init_halo_swap(){
 	//====================================================================================
 	//
@@ -70,42 +131,37 @@ void mpi_init_halo_swap(){
 	//----------------------------------------------------------
 	// Pack spins for sending
 	//----------------------------------------------------------
-
-	//std::cout << "rank: " << vmpi::my_rank << " num_halo_swaps: " << vmpi::send_atom_translation_array.size();
-	//std::cout << "\t" << "num_boundary_swaps: " << vmpi::recv_atom_translation_array.size() << std::endl;
-
-	for(unsigned int i=0;i<vmpi::send_atom_translation_array.size();i++){
-		int atom = vmpi::send_atom_translation_array[i];
-		vmpi::send_spin_data_array[3*i+0] = atoms::x_spin_array[atom];
-		vmpi::send_spin_data_array[3*i+1] = atoms::y_spin_array[atom];
-		vmpi::send_spin_data_array[3*i+2] = atoms::z_spin_array[atom];
-		//std::cout << vmpi::my_rank << "\t" << i << "\t";
-		//std::cout << atoms::x_spin_array[vmpi::send_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::y_spin_array[vmpi::send_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::z_spin_array[vmpi::send_atom_translation_array[i]] << std::endl;
+	// Spins for each processor are stored as contiguous blocks of x, y and z
+	// components so that the gather vectorises
+	const double* sx = &atoms::x_spin_array[0];
+	const double* sy = &atoms::y_spin_array[0];
+	const double* sz = &atoms::z_spin_array[0];
+
+	for(int p=0;p<vmpi::num_processors;p++){
+		const int n = vmpi::send_num_array[p];
+
+		// record data volume for each processor
+		vmpi::PeerSendBytesArray[p] += 3.0*sizeof(double)*double(n);
+		vmpi::PeerRecvBytesArray[p] += 3.0*sizeof(double)*double(vmpi::recv_num_array[p]);
+
+		if(n==0) continue;
+		const int si = vmpi::send_start_index_array[p];
+		const int* atom = &vmpi::send_atom_translation_array[si];
+		double* x = &vmpi::send_spin_data_array[3*si];
+		double* y = x+n;
+		double* z = y+n;
+		#pragma omp simd
+		for(int i=0;i<n;i++){
+			x[i] = sx[atom[i]];
+			y[i] = sy[atom[i]];
+			z[i] = sz[atom[i]];
+		}
 	}
 
 	//----------------------------------------------------------
-	// Send spin data array and post receives
+	// Start persistent receives and sends
 	//----------------------------------------------------------
-
-	vmpi::requests.resize(0);
-	MPI_Request req;
-
-	for (int p=0;p<vmpi::num_processors;p++){
-		if(vmpi::send_num_array[p]!=0){
-			int num_pts = 3*vmpi::send_num_array[p];
-			int si = 3*vmpi::send_start_index_array[p];
-			vmpi::requests.push_back(req);
-			MPI_Isend(&vmpi::send_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &vmpi::requests.back());
-		}
-		if(vmpi::recv_num_array[p]!=0){
-			int num_pts = 3*vmpi::recv_num_array[p];
-			int si = 3*vmpi::recv_start_index_array[p];
-			vmpi::requests.push_back(req);
-			MPI_Irecv(&vmpi::recv_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &vmpi::requests.back());
-		}
-	}
+	if(vmpi::requests.size()>0) MPI_Startall(vmpi::requests.size(),&vmpi::requests[0]);
 
    #endif
 	//----------------------------------------------------------
@@ -116,6 +172,22 @@ void mpi_init_halo_swap(){
 
 }
 
+//-----------------------------------------------------------------------------
+// Function to progress halo swap during computation of core atoms. Many MPI
+// libraries only transfer data inside MPI calls, so testing the requests
+// between chunks of computation allows the transfer to overlap.
+//-----------------------------------------------------------------------------
+void mpi_progress_halo_swap(){
+
+#ifdef MPICF
+	int flag;
+	if(vmpi::requests.size()>0) MPI_Testall(vmpi::requests.size(),&vmpi::requests[0],&flag,MPI_STATUSES_IGNORE);
+#endif
+
+	return;
+
+}
+
 void mpi_complete_halo_swap(){
 	//====================================================================================
 	///
@@ -138,22 +210,40 @@ void mpi_complete_halo_swap(){
 	// Swap timers compute -> wait
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
-	// Wait for all comms to complete
-	vmpi::stati.resize(vmpi::requests.size());
-	MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	// Wait for all comms to complete, assigning each interval of waiting to
+	// the processor whose message completed it
+	double last_time = vmpi::WaitTime;
+	for(unsigned int r=0;r<vmpi::requests.size();r++){
+		int index;
+		MPI_Waitany(vmpi::requests.size(),&vmpi::requests[0],&index,&vmpi::stati[0]);
+		if(index==MPI_UNDEFINED) break;
+		const double time = MPI_Wtime();
+		vmpi::PeerWaitTimeArray[vmpi::request_peer_array[index]] += time-last_time;
+		last_time = time;
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
 
 	// Unpack received spins
-	for(unsigned int i=0;i<vmpi::recv_atom_translation_array.size();i++){
-		atoms::x_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+0];
-		atoms::y_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+1];
-		atoms::z_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+2];
-		//std::cout << vmpi::my_rank << "\t" << i << "\t" << vmpi::recv_atom_translation_array[i] << "\t";
-		//std::cout << atoms::x_spin_array[vmpi::recv_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::y_spin_array[vmpi::recv_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::z_spin_array[vmpi::recv_atom_translation_array[i]] << std::endl;
+	double* sx = &atoms::x_spin_array[0];
+	double* sy = &atoms::y_spin_array[0];
+	double* sz = &atoms::z_spin_array[0];
+
+	for(int p=0;p<vmpi::num_processors;p++){
+		const int n = vmpi::recv_num_array[p];
+		if(n==0) continue;
+		const int si = vmpi::recv_start_index_array[p];
+		const int* atom = &vmpi::recv_atom_translation_array[si];
+		const double* x = &vmpi::recv_spin_data_array[3*si];
+		const double* y = x+n;
+		const double* z = y+n;
+		#pragma omp simd
+		for(int i=0;i<n;i++){
+			sx[atom[i]] = x[i];
+			sy[atom[i]] = y[i];
+			sz[atom[i]] = z[i];
+		}
 	}
 
    #endif
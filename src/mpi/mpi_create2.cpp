@@ -37,7 +37,8 @@
 
 namespace vmpi{
 	int mpi_mode=0;
-   unsigned int ppn=1;  ///< Processors per node
+   unsigned int ppn=1;  ///< Processors per node (0 = determine from shared memory nodes)
+   int mpi_thread_level=0; ///< Thread support level provided by MPI library
 	int my_rank=0;
 	int num_processors=1;
 	int num_core_atoms;
@@ -45,6 +46,9 @@ namespace vmpi{
 	int num_halo_atoms;
 
 	bool replicated_data_staged=false;
+	bool load_balancing=false; ///< Flag to rebalance geometric decomposition by atom weights
+	double load_balancing_atom_weight=4.0; ///< Cost of integrating an atom relative to one exchange interaction
+	std::string load_balancing_timings_file=""; ///< File of measured compute times used to calibrate atom weight
 
 	char hostname[20];
 
@@ -62,6 +66,9 @@ namespace vmpi{
 	bool DetailedMPITiming=false;
 	std::vector<double> ComputeTimeArray(0);
 	std::vector<double> WaitTimeArray(0);
+	std::vector<double> PeerWaitTimeArray(0); /// Total time spent waiting for each processor
+	std::vector<double> PeerSendBytesArray(0); /// Total bytes of halo data sent to each processor
+	std::vector<double> PeerRecvBytesArray(0); /// Total bytes of halo data received from each processor
 
 	double min_dimensions[3]; ///< Minimum coordinates of system on local cpu
 	double max_dimensions[3]; ///< Maximum coordinates of system on local cpu
@@ -75,9 +82,13 @@ namespace vmpi{
 	std::vector<int> recv_start_index_array;
 	std::vector<int> recv_num_array;
 	std::vector<double> recv_spin_data_array;
+
+	int num_core_atom_chunks=4; /// Number of chunks of core atoms with halo swap progressed between chunks
+
 	#ifdef MPICF
 	std::vector<MPI_Request> requests(0);
 	std::vector<MPI_Status> stati(0);
+	std::vector<int> request_peer_array(0);
 	#endif
 }
 
@@ -1047,6 +1058,9 @@ int init_mpi_comms(std::vector<cs::catom_t> & catom_array){
 	  }
 	}
 
+	// Create persistent requests for halo swap
+	vmpi::init_halo_swap_requests();
+
 	return EXIT_SUCCESS;
 }
 
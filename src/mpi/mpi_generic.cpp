@@ -32,6 +32,7 @@
 //
 //====================================================================================
 
+#include "atoms.hpp"
 #include "errors.hpp"
 #include "vmpi.hpp"
 #include <iostream>
@@ -65,8 +66,8 @@ int initialise(int argc, char *argv[]){
 
 	int resultlen;
 
-	// Initialise MPI
-	MPI_Init(&argc, &argv);
+	// Initialise MPI with support for threads, with MPI calls made only by the master thread
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &vmpi::mpi_thread_level);
 
 	// Get number of processors and rank
  	MPI_Comm_rank(MPI_COMM_WORLD, &vmpi::my_rank);
@@ -180,8 +181,66 @@ int finalise(){
 			}
 			ComputeTimesOFS.close();
 		}
+
+		// Gather data volume and wait time for each pair of processors
+		std::vector<double> PeerData(3*num_processors,0.0);
+		for(int p=0;p<num_processors && p<int(PeerWaitTimeArray.size());p++){
+			PeerData[3*p+0]=PeerSendBytesArray[p];
+			PeerData[3*p+1]=PeerRecvBytesArray[p];
+			PeerData[3*p+2]=PeerWaitTimeArray[p];
+		}
+
+		std::vector<double> AllPeerData(0);
+		if(my_rank==0) AllPeerData.resize(3*num_processors*num_processors);
+
+		MPI_Gather(&PeerData[0],3*num_processors,MPI_DOUBLE,&AllPeerData[0],3*num_processors,MPI_DOUBLE,0,MPI_COMM_WORLD);
+
+		if(my_rank==0){
+			std::ofstream PeerTimesOFS;
+			PeerTimesOFS.open("MPI-peer-times");
+			PeerTimesOFS << "# rank\tpeer\tbytes sent\tbytes received\twait time (s)" << std::endl;
+
+			// Row for each pair of processors exchanging halo data
+			for(int rank=0;rank<vmpi::num_processors;rank++){
+				for(int p=0;p<vmpi::num_processors;p++){
+					const int idx = 3*(rank*num_processors+p);
+					if(AllPeerData[idx+0]>0.0 || AllPeerData[idx+1]>0.0){
+						PeerTimesOFS << rank << "\t" << p << "\t" << AllPeerData[idx+0] << "\t" << AllPeerData[idx+1] << "\t" << AllPeerData[idx+2] << std::endl;
+					}
+				}
+			}
+			PeerTimesOFS.close();
+		}
+
+		// Gather number of atoms, exchange interactions and total compute time
+		// for calibration of load balancing weights
+		std::vector<double> LoadData(3,0.0);
+		const int num_local_atoms=vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+		LoadData[0]=double(num_local_atoms);
+		for(int atom=0;atom<num_local_atoms && atom<int(atoms::neighbour_list_end_index.size());atom++){
+			LoadData[1]+=double(atoms::neighbour_list_end_index[atom]-atoms::neighbour_list_start_index[atom]+1);
+		}
+		for(unsigned int idx=0;idx<ComputeTimeArray.size();idx++) LoadData[2]+=ComputeTimeArray[idx];
+
+		std::vector<double> AllLoadData(0);
+		if(my_rank==0) AllLoadData.resize(3*num_processors);
+
+		MPI_Gather(&LoadData[0],3,MPI_DOUBLE,&AllLoadData[0],3,MPI_DOUBLE,0,MPI_COMM_WORLD);
+
+		if(my_rank==0){
+			std::ofstream LoadWeightsOFS;
+			LoadWeightsOFS.open("MPI-load-weights");
+			LoadWeightsOFS << "# rank\tatoms\tinteractions\tcompute time (s)" << std::endl;
+			for(int p=0;p<vmpi::num_processors;p++){
+				LoadWeightsOFS << p << "\t" << AllLoadData[3*p+0] << "\t" << AllLoadData[3*p+1] << "\t" << AllLoadData[3*p+2] << std::endl;
+			}
+			LoadWeightsOFS.close();
+		}
 	}
 
+	// Free persistent requests for halo swap
+	free_halo_swap_requests();
+
 	// Stop MPI Timer and output to screen
 	//vmpi::end_time=MPI_Wtime();
 	//if(vmpi::my_rank==0){
@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "vomp.hpp"
+
+// openmp module headers
+#include "internal.hpp"
+
+namespace vomp{
+
+   //------------------------------------------------------------------------------
+   // Externally visible variables
+   //------------------------------------------------------------------------------
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Shared variables inside openmp module
+      //------------------------------------------------------------------------
+      int num_threads = 1; // default is serial execution unless requested
+      bool initialized = false; // flag to check module has been initialised
+
+   } // end of internal namespace
+
+} // end of vomp namespace
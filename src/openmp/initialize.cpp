@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <iostream>
+
+// Vampire headers
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vomp.hpp"
+
+// openmp module headers
+#include "internal.hpp"
+
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
+
+namespace vomp{
+
+   //----------------------------------------------------------------------------
+   // Function to initialize openmp module
+   //----------------------------------------------------------------------------
+   void initialize(){
+
+      #ifdef _OPENMP
+
+         // set number of threads for all subsequent parallel regions
+         omp_set_num_threads(internal::num_threads);
+
+         zlog << zTs() << "Shared memory parallelisation enabled with " << internal::num_threads << " thread(s) per process" << std::endl;
+
+         #ifdef MPICF
+            // MPI calls are made outside parallel regions, so funneled thread support is sufficient
+            if(internal::num_threads > 1 && vmpi::mpi_thread_level < MPI_THREAD_FUNNELED){
+               if(vmpi::my_rank == 0){
+                  std::cout << "Warning: MPI library does not support threads - running with one thread per process" << std::endl;
+               }
+               zlog << zTs() << "Warning: MPI library does not support threads - running with one thread per process" << std::endl;
+               internal::num_threads = 1;
+               omp_set_num_threads(internal::num_threads);
+            }
+            zlog << zTs() << "Hybrid parallelisation with " << vmpi::num_processors << " processes and " << internal::num_threads
+                 << " thread(s) per process (" << vmpi::num_processors*internal::num_threads << " cores in total)" << std::endl;
+         #endif
+
+      #else
+
+         // warn user if threads are requested but code is compiled without openmp support
+         if(internal::num_threads > 1){
+            if(vmpi::my_rank == 0){
+               std::cout << "Warning: multiple threads requested but code compiled without OpenMP support - running in serial" << std::endl;
+            }
+            zlog << zTs() << "Warning: " << internal::num_threads << " threads requested but code compiled without OpenMP support - running in serial" << std::endl;
+            internal::num_threads = 1;
+         }
+
+      #endif
+
+      internal::initialized = true;
+
+      return;
+
+   }
+
+   //----------------------------------------------------------------------------
+   // Function to get number of threads used for shared memory parallel loops
+   //----------------------------------------------------------------------------
+   int get_num_threads(){
+      return internal::num_threads;
+   }
+
+   //----------------------------------------------------------------------------
+   // Function to get thread id of calling thread (0 outside parallel regions)
+   //----------------------------------------------------------------------------
+   int get_thread_id(){
+      #ifdef _OPENMP
+         return omp_get_thread_num();
+      #else
+         return 0;
+      #endif
+   }
+
+} // end of vomp namespace
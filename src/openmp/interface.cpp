@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdlib>
+#include <string>
+
+// Vampire headers
+#include "errors.hpp"
+#include "vio.hpp"
+#include "vomp.hpp"
+
+// openmp module headers
+#include "internal.hpp"
+
+namespace vomp{
+
+   //---------------------------------------------------------------------------
+   // Function to process input file parameters for openmp module
+   //---------------------------------------------------------------------------
+   bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line){
+
+      // Check for valid key, if no match return false
+      std::string prefix="openmp";
+      if(key!=prefix) return false;
+
+      //--------------------------------------------------------------------
+      std::string test="num-threads";
+      if(word==test){
+         int nt = atoi(value.c_str());
+         // Test for valid range
+         vin::check_for_valid_int(nt, word, line, prefix, 1, 1024,"input","1 - 1024");
+         internal::num_threads = nt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      // Keyword not found
+      //--------------------------------------------------------------------
+      return false;
+
+   }
+
+} // end of vomp namespace
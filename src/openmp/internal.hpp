@@ -0,0 +1,40 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//------------------------------------------------------------------------------
+//
+
+#ifndef VOMP_INTERNAL_H_
+#define VOMP_INTERNAL_H_
+//
+//---------------------------------------------------------------------
+// This header file defines shared internal data structures and
+// functions for the openmp module. These functions and
+// variables should not be accessed outside of this module.
+//---------------------------------------------------------------------
+
+// C++ standard library headers
+
+// Vampire headers
+#include "vomp.hpp"
+
+// openmp module headers
+#include "internal.hpp"
+
+namespace vomp{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Internal shared variables
+      //-------------------------------------------------------------------------
+      extern int num_threads; // number of threads requested for parallel loops
+      extern bool initialized; // flag to check module has been initialised
+
+   } // end of internal namespace
+
+} // end of vomp namespace
+
+#endif //VOMP_INTERNAL_H_
@@ -53,10 +53,12 @@
 #include "errors.hpp"
 #include "material.hpp"
 #include "program.hpp"
+#include "random.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
+#include "vutil.hpp"
 
 
 namespace program{
@@ -162,4 +164,76 @@ namespace program{
 
    }
 
+   //------------------------------------------------------------------------------
+   // Function to time gaussian random number generators for the thermal field,
+   // reporting average time per sample and the mean and variance of the numbers
+   //------------------------------------------------------------------------------
+   void random_number_benchmark(){
+
+      // check calling of routine if error checking is activated
+      if(err::check==true) std::cout << "program::random_number_benchmark has been called" << std::endl;
+
+      const int num_samples = atoms::num_atoms;
+      const int num_repeats = sim::total_time > 0 ? sim::total_time : 1;
+
+      std::vector<double> x(num_samples,0.0);
+      std::vector<double> y(num_samples,0.0);
+      std::vector<double> z(num_samples,0.0);
+
+      std::cout << "Generator\tns/sample\tmean\tvariance" << std::endl;
+      zlog << zTs() << "Gaussian random number benchmark for " << num_repeats << " x " << 3*num_samples << " samples" << std::endl;
+
+      for(int generator = 0; generator < 3; generator++){
+
+         std::string name;
+         double sum = 0.0;
+         double sum_sq = 0.0;
+
+         vutil::vtimer_t timer;
+         timer.start();
+
+         for(int r = 0; r < num_repeats; r++){
+            switch(generator){
+               case 0: // single numbers from scalar ziggurat
+                  name = "scalar-ziggurat";
+                  for(int i = 0; i < num_samples; i++) x[i] = mtrandom::gaussian();
+                  for(int i = 0; i < num_samples; i++) y[i] = mtrandom::gaussian();
+                  for(int i = 0; i < num_samples; i++) z[i] = mtrandom::gaussian();
+                  break;
+               case 1: // block ziggurat
+                  name = "block-ziggurat";
+                  mtrandom::gaussian_array(x, 0, num_samples);
+                  mtrandom::gaussian_array(y, 0, num_samples);
+                  mtrandom::gaussian_array(z, 0, num_samples);
+                  break;
+               case 2: // counter based generator
+                  name = "philox";
+                  mtrandom::gaussian_block(mtrandom::thermal_stream, atoms::global_id_array, x, y, z, 0, num_samples);
+                  mtrandom::counter++;
+                  break;
+            }
+            // accumulate statistics for last set of numbers only to exclude from timing
+            if(r == num_repeats-1) timer.stop();
+         }
+
+         for(int i = 0; i < num_samples; i++){
+            sum += x[i] + y[i] + z[i];
+            sum_sq += x[i]*x[i] + y[i]*y[i] + z[i]*z[i];
+         }
+
+         const double n = 3.0*double(num_samples);
+         const double ns_per_sample = 1.0e9*timer.elapsed_time()/(n*double(num_repeats));
+         const double mean = sum/n;
+         const double variance = sum_sq/n - mean*mean;
+
+         std::cout << name << "\t" << ns_per_sample << "\t" << mean << "\t" << variance << std::endl;
+         zlog << zTs() << name << " generator: " << ns_per_sample << " ns/sample, mean " << mean << ", variance " << variance << std::endl;
+         zmag << name << "\t" << ns_per_sample << "\t" << mean << "\t" << variance << std::endl;
+
+      }
+
+      return;
+
+   }
+
 }//end of namespace program
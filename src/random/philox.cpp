@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <cmath>
+
+// Vampire headers
+#include "random.hpp"
+
+//-----------------------------------------------------------------------------
+//
+// Counter based random number generator using the Philox4x32-10 algorithm
+// of J. K. Salmon et al, Proc. SC11, "Parallel random numbers: as easy as
+// 1, 2, 3" (2011). Each set of random numbers is a pure function of a key
+// (seed, stream) and a counter (atom id, time step), so that numbers can be
+// generated for any atom in any order on any number of threads or processors
+// and give identical results.
+//
+//-----------------------------------------------------------------------------
+namespace mtrandom{
+
+	bool counter_based = false; /// flag to use counter based (Philox) generator for thermal fields
+	uint64_t counter = 0; /// counter for counter based generator, incremented every time step
+
+	// Philox round multipliers and Weyl sequence key increments
+	const uint32_t philox_m0 = 0xD2511F53;
+	const uint32_t philox_m1 = 0xCD9E8D57;
+	const uint32_t philox_w0 = 0x9E3779B9;
+	const uint32_t philox_w1 = 0xBB67AE85;
+
+	//-----------------------------------------------------------------------------
+	// Function to generate four random 32 bit integers from counter and key
+	//-----------------------------------------------------------------------------
+	inline void philox4x32(uint32_t ctr[4], uint32_t key[2]){
+
+		for(int round = 0; round < 10; round++){
+
+			const uint64_t p0 = uint64_t(philox_m0) * uint64_t(ctr[0]);
+			const uint64_t p1 = uint64_t(philox_m1) * uint64_t(ctr[2]);
+
+			const uint32_t hi0 = uint32_t(p0 >> 32);
+			const uint32_t lo0 = uint32_t(p0);
+			const uint32_t hi1 = uint32_t(p1 >> 32);
+			const uint32_t lo1 = uint32_t(p1);
+
+			ctr[0] = hi1 ^ ctr[1] ^ key[0];
+			ctr[1] = lo1;
+			ctr[2] = hi0 ^ ctr[3] ^ key[1];
+			ctr[3] = lo0;
+
+			key[0] += philox_w0;
+			key[1] += philox_w1;
+
+		}
+
+		return;
+
+	}
+
+	//-----------------------------------------------------------------------------
+	// Function to fill x,y,z arrays with gaussian random numbers between start
+	// and end index. Numbers for each atom depend only on the integration
+	// seed, random stream, atom id and current counter value.
+	//-----------------------------------------------------------------------------
+	void gaussian_block(const stream_t stream,
+							  const std::vector<uint64_t>& id_array,
+							  std::vector<double>& x_array,
+							  std::vector<double>& y_array,
+							  std::vector<double>& z_array,
+							  const int start_index,
+							  const int end_index){
+
+		const double two_pi = 2.0*M_PI;
+		const double inv_2_32 = 1.0/4294967296.0; // 2^-32
+
+		const uint32_t seed = uint32_t(integration_seed);
+		const uint32_t step[2] = {uint32_t(counter), uint32_t(counter >> 32)};
+
+		#pragma omp parallel for schedule(static)
+		for(int atom = start_index; atom < end_index; atom++){
+
+			const uint64_t id = id_array[atom];
+
+			uint32_t ctr[4] = {uint32_t(id), uint32_t(id >> 32), step[0], step[1]};
+			uint32_t key[2] = {seed, uint32_t(stream)};
+
+			philox4x32(ctr, key);
+
+			// convert to uniform numbers, u1 in (0,1] to avoid log(0)
+			const double u1 = (double(ctr[0]) + 1.0)*inv_2_32;
+			const double u2 = double(ctr[1])*inv_2_32;
+			const double u3 = (double(ctr[2]) + 1.0)*inv_2_32;
+			const double u4 = double(ctr[3])*inv_2_32;
+
+			// Box-Muller transform to gaussian numbers
+			const double r1 = sqrt(-2.0*log(u1));
+			const double r2 = sqrt(-2.0*log(u3));
+
+			x_array[atom] = r1*cos(two_pi*u2);
+			y_array[atom] = r1*sin(two_pi*u2);
+			z_array[atom] = r2*cos(two_pi*u4);
+
+		}
+
+		return;
+
+	}
+
+	//-----------------------------------------------------------------------------
+	// Function to generate four uniform random numbers in the range (0,1) for
+	// an arbitrary id and count in a given stream
+	//-----------------------------------------------------------------------------
+	void counter_uniforms(const stream_t stream, const uint64_t id, const uint64_t count, double u[4]){
+
+		const double inv_2_32 = 1.0/4294967296.0; // 2^-32
+
+		uint32_t ctr[4] = {uint32_t(id), uint32_t(id >> 32), uint32_t(count), uint32_t(count >> 32)};
+		uint32_t key[2] = {uint32_t(integration_seed), uint32_t(stream)};
+
+		philox4x32(ctr, key);
+
+		for(int i = 0; i < 4; i++) u[i] = (double(ctr[i]) + 0.5)*inv_2_32;
+
+		return;
+
+	}
+
+} // end of namespace mtrandom
@@ -23,6 +23,7 @@
 // ----------------------------------------------------------------------------
 //
 #include "random.hpp"
+#include <algorithm>
 #include <cmath>
 
 using std::log;
@@ -271,5 +272,77 @@ double gaussianc(MTRand& grnd){
   return  sign ? x : -x;
 }
 
+//-----------------------------------------------------------------------------
+// Function to complete a ziggurat sample which is not accepted by the fast
+// rectangular test, drawing further random numbers as needed
+//-----------------------------------------------------------------------------
+double ziggurat_rejection(uint32_t U){
+  unsigned long  sign, i, j;
+  double  x, y;
+
+  while (1) {
+    i = U & 0x0000007F;		/* 7 bit to choose the step */
+    sign = U & 0x00000080;	/* 1 bit for the sign */
+    j = U>>8;			/* 24 bit for the x-value */
+
+    x = j*wtab[i];
+    if (j < ktab[i])  break;
+
+    if (i<127) {
+      double  y0, y1;
+      y0 = ytab[i];
+      y1 = ytab[i+1];
+      y = y1+(y0-y1)*mtrandom::grnd();
+    } else {
+      x = PARAM_R - log(1.0-mtrandom::grnd())/PARAM_R;
+      y = exp(-PARAM_R*(x-0.5*PARAM_R))*mtrandom::grnd();
+    }
+    if (y < exp(-0.5*x*x))  break;
+    U = mtrandom::grnd.i32();
+  }
+  return  sign ? x : -x;
+}
+
+//-----------------------------------------------------------------------------
+// Function to fill an array with gaussian random numbers between start and
+// end index. Integers are drawn in blocks and the ziggurat fast path (~99%
+// of samples) is evaluated for the whole block in a branch free loop.
+// Samples outside the rectangular part of the ziggurat are then completed
+// serially.
+//-----------------------------------------------------------------------------
+void gaussian_array(std::vector<double>& array, const int start_index, const int end_index){
+
+  const int block_size = 256;
+  uint32_t U[block_size];
+  int rejected[block_size];
+
+  for(int block_start = start_index; block_start < end_index; block_start += block_size){
+
+    const int n = std::min(block_size, end_index - block_start);
+    double* const x = &array[block_start];
+
+    // draw integers for block
+    for(int k = 0; k < n; k++) U[k] = grnd.i32();
+
+    // rectangular test for all samples in block
+    int num_rejected = 0;
+    for(int k = 0; k < n; k++){
+      const uint32_t i = U[k] & 0x0000007F;
+      const uint32_t j = U[k] >> 8;
+      const double sign = double(int((U[k] >> 6) & 2) - 1); // +1 or -1 from bit 7
+      x[k] = sign*double(j)*wtab[i];
+      rejected[num_rejected] = k;
+      num_rejected += (j >= ktab[i]);
+    }
+
+    // complete rejected samples
+    for(int r = 0; r < num_rejected; r++) x[rejected[r]] = ziggurat_rejection(U[rejected[r]]);
+
+  }
+
+  return;
+
+}
+
 } // end of namespace random
 
@@ -184,12 +184,12 @@ int LLB_serial_heun(const int num_steps){
 	std::vector <double> Htz_para(atoms::x_spin_array.size());
 	
 	// precalculate thermal fields
-	generate (Htx_perp.begin(),Htx_perp.end(), mtrandom::gaussian);
-	generate (Hty_perp.begin(),Hty_perp.end(), mtrandom::gaussian);
-	generate (Htz_perp.begin(),Htz_perp.end(), mtrandom::gaussian);
-	generate (Htx_para.begin(),Htx_para.end(), mtrandom::gaussian);
-	generate (Hty_para.begin(),Hty_para.end(), mtrandom::gaussian);
-	generate (Htz_para.begin(),Htz_para.end(), mtrandom::gaussian);
+	mtrandom::gaussian_array(Htx_perp, 0, Htx_perp.size());
+	mtrandom::gaussian_array(Hty_perp, 0, Hty_perp.size());
+	mtrandom::gaussian_array(Htz_perp, 0, Htz_perp.size());
+	mtrandom::gaussian_array(Htx_para, 0, Htx_para.size());
+	mtrandom::gaussian_array(Hty_para, 0, Hty_para.size());
+	mtrandom::gaussian_array(Htz_para, 0, Htz_para.size());
 
 	for(unsigned int atom=0;atom<atoms::x_spin_array.size();atom++){
 		Htx_perp[atom] *= sigma_perp;
@@ -299,7 +299,7 @@ int LLB_serial_heun(const int num_steps){
 			atoms::z_total_spin_field_array[atom] = (pf-0.0				 )*m[2];
 		}
 
-		// Calculate Heun Gradients
+		// Calculate Heun Gradients and Heun Step
 		
 		for(unsigned int atom=0;atom<atoms::x_spin_array.size();atom++){
 
@@ -325,20 +325,10 @@ int LLB_serial_heun(const int num_steps){
 						+ alpha_para*S[2]*S[2]*H_para[2]*one_o_m_squared
 						-alpha_perp*(S[0]*(S[2]*H_perp[0]-S[0]*H_perp[2])-S[1]*(S[1]*H_perp[2]-S[2]*H_perp[1]))*one_o_m_squared;
 						
-			// Store dS in heun array
-			x_heun_array[atom]=xyz[0];
-			y_heun_array[atom]=xyz[1];
-			z_heun_array[atom]=xyz[2];
-		}
-
-		//----------------------------------------
-		// Calculate Heun Step
-		//----------------------------------------	
-
-		for(unsigned int atom=0;atom<atoms::x_spin_array.size();atom++){
-			atoms::x_spin_array[atom]=x_initial_spin_array[atom]+0.5*dt*(x_euler_array[atom]+x_heun_array[atom]);
-			atoms::y_spin_array[atom]=y_initial_spin_array[atom]+0.5*dt*(y_euler_array[atom]+y_heun_array[atom]);
-			atoms::z_spin_array[atom]=z_initial_spin_array[atom]+0.5*dt*(z_euler_array[atom]+z_heun_array[atom]);
+			// Calculate Heun Step
+			atoms::x_spin_array[atom]=x_initial_spin_array[atom]+0.5*dt*(x_euler_array[atom]+xyz[0]);
+			atoms::y_spin_array[atom]=y_initial_spin_array[atom]+0.5*dt*(y_euler_array[atom]+xyz[1]);
+			atoms::z_spin_array[atom]=z_initial_spin_array[atom]+0.5*dt*(z_euler_array[atom]+xyz[2]);
 		}
 
 	}
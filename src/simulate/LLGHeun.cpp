@@ -60,6 +60,7 @@
 //Function prototypes
 int calculate_spin_fields(const int,const int);
 int calculate_external_fields(const int,const int);
+int calculate_step_spin_fields(const int,const int);
 
 namespace LLG_arrays{
 
@@ -68,10 +69,6 @@ namespace LLG_arrays{
 	std::vector <double> y_euler_array;
 	std::vector <double> z_euler_array;
 
-	std::vector <double> x_heun_array;
-	std::vector <double> y_heun_array;
-	std::vector <double> z_heun_array;
-
 	std::vector <double> x_spin_storage_array;
 	std::vector <double> y_spin_storage_array;
 	std::vector <double> z_spin_storage_array;
@@ -113,9 +110,10 @@ int LLGinit(){
 
 	using namespace LLG_arrays;
 
-	x_spin_storage_array.resize(atoms::num_atoms,0.0);
-	y_spin_storage_array.resize(atoms::num_atoms,0.0);
-	z_spin_storage_array.resize(atoms::num_atoms,0.0);
+	// storage arrays are swapped with spin arrays and so must have identical size
+	x_spin_storage_array.resize(atoms::x_spin_array.size(),0.0);
+	y_spin_storage_array.resize(atoms::y_spin_array.size(),0.0);
+	z_spin_storage_array.resize(atoms::z_spin_array.size(),0.0);
 
 	x_initial_spin_array.resize(atoms::num_atoms,0.0);
 	y_initial_spin_array.resize(atoms::num_atoms,0.0);
@@ -125,10 +123,6 @@ int LLGinit(){
 	y_euler_array.resize(atoms::num_atoms,0.0);
 	z_euler_array.resize(atoms::num_atoms,0.0);
 
-	x_heun_array.resize(atoms::num_atoms,0.0);
-	y_heun_array.resize(atoms::num_atoms,0.0);
-	z_heun_array.resize(atoms::num_atoms,0.0);
-
 	LLG_set=true;
 
   	return EXIT_SUCCESS;
@@ -169,24 +163,19 @@ int LLG_Heun(){
 
 	// Local variables for system integration
 	const int num_atoms=atoms::num_atoms;
-	double xyz[3];		// Local Delta Spin Components
-	double S_new[3];	// New Local Spin Moment
-	double mod_S;		// magnitude of spin moment
-
-	// Store initial spin positions
-	for(int atom=0;atom<num_atoms;atom++){
-		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
-		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
-		z_initial_spin_array[atom] = atoms::z_spin_array[atom];
-	}
 
 	// Calculate fields
-	calculate_spin_fields(0,num_atoms);
+	calculate_step_spin_fields(0,num_atoms);
 	calculate_external_fields(0,num_atoms);
 
 	// Calculate Euler Step
+	#pragma omp parallel for schedule(static)
 	for(int atom=0;atom<num_atoms;atom++){
 
+		double xyz[3];		// Local Delta Spin Components
+		double S_new[3];	// New Local Spin Moment
+		double mod_S;		// magnitude of spin moment
+
 		const int imaterial=atoms::type_array[atom];
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
 		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
@@ -225,19 +214,22 @@ int LLG_Heun(){
 		z_spin_storage_array[atom]=S_new[2];
  	}
 
-	// Copy new spins to spin array
-	for(int atom=0;atom<num_atoms;atom++){
-		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
-		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
-		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
-	}
+	// Swap predicted spins into spin array, storage array now holds initial spins
+	atoms::x_spin_array.swap(x_spin_storage_array);
+	atoms::y_spin_array.swap(y_spin_storage_array);
+	atoms::z_spin_array.swap(z_spin_storage_array);
 
 	// Recalculate spin dependent fields
 	calculate_spin_fields(0,num_atoms);
 
-	// Calculate Heun Gradients
+	// Calculate Heun Gradients and Heun Step in a single pass
+	#pragma omp parallel for schedule(static)
 	for(int atom=0;atom<num_atoms;atom++){
 
+		double xyz[3];		// Local Delta Spin Components
+		double S_new[3];	// New Local Spin Moment
+		double mod_S;		// magnitude of spin moment
+
 		const int imaterial=atoms::type_array[atom];;
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq;
 		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
@@ -253,17 +245,10 @@ int LLG_Heun(){
 		xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 		xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-		// Store dS in heun array
-		x_heun_array[atom]=xyz[0];
-		y_heun_array[atom]=xyz[1];
-		z_heun_array[atom]=xyz[2];
-	}
-
-	// Calculate Heun Step
-	for(int atom=0;atom<num_atoms;atom++){
-		S_new[0]=x_initial_spin_array[atom]+mp::half_dt*(x_euler_array[atom]+x_heun_array[atom]);
-		S_new[1]=y_initial_spin_array[atom]+mp::half_dt*(y_euler_array[atom]+y_heun_array[atom]);
-		S_new[2]=z_initial_spin_array[atom]+mp::half_dt*(z_euler_array[atom]+z_heun_array[atom]);
+		// Calculate Heun Step from initial spin
+		S_new[0]=x_spin_storage_array[atom]+mp::half_dt*(x_euler_array[atom]+xyz[0]);
+		S_new[1]=y_spin_storage_array[atom]+mp::half_dt*(y_euler_array[atom]+xyz[1]);
+		S_new[2]=z_spin_storage_array[atom]+mp::half_dt*(z_euler_array[atom]+xyz[2]);
 
 		// Normalise Spin Length
 		mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
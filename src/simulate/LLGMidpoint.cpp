@@ -61,6 +61,7 @@
 //Function prototypes
 int calculate_spin_fields(const int,const int);
 int calculate_external_fields(const int,const int);
+int calculate_step_spin_fields(const int,const int);
 
 namespace sim{
 
@@ -108,7 +109,7 @@ int LLG_Midpoint(){
 	}
 
 	// Calculate fields
-	calculate_spin_fields(0,num_atoms);
+	calculate_step_spin_fields(0,num_atoms);
 	calculate_external_fields(0,num_atoms);
 	
 	// Calculate Predictor Step
@@ -0,0 +1,302 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "cells.hpp"
+#include "create.hpp"
+#include "errors.hpp"
+#include "material.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// sim module headers
+#include "internal.hpp"
+
+namespace sim{
+
+namespace internal{
+
+//------------------------------------------------------------------------------
+// Function to determine unit cell coordinates and unit cell atom id from the
+// global atom id
+//------------------------------------------------------------------------------
+void global_id_to_unit_cell(const uint64_t id, int sc[3], int& uc_id){
+
+   const uint64_t num_uc_atoms = cells::num_atoms_in_unit_cell;
+   const uint64_t nx = cs::total_num_unit_cells[0];
+   const uint64_t ny = cs::total_num_unit_cells[1];
+
+   const uint64_t cell = id / num_uc_atoms;
+
+   uc_id = id % num_uc_atoms;
+   sc[0] = cell % nx;
+   sc[1] = (cell / nx) % ny;
+   sc[2] = cell / (nx*ny);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to partition atoms into colour classes with no interactions
+// between atoms of the same colour. Unit cells are coloured with a block
+// pattern of k x k x k cells, where k exceeds the interaction range in unit
+// cells, and then by the atom id within the unit cell. The colouring depends
+// only on the global atom id and so is identical for any decomposition.
+//------------------------------------------------------------------------------
+void initialize_checkerboard_colours(){
+
+   #ifdef MPICF
+      const int num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+   #else
+      const int num_local_atoms = atoms::num_atoms;
+   #endif
+
+   const int num_uc_atoms = cells::num_atoms_in_unit_cell;
+   const int n[3] = {int(cs::total_num_unit_cells[0]), int(cs::total_num_unit_cells[1]), int(cs::total_num_unit_cells[2])};
+
+   // determine maximum interaction range in unit cells in each direction
+   int range[3] = {0, 0, 0};
+   for(int atom = 0; atom < num_local_atoms; atom++){
+      int sci[3], uci;
+      global_id_to_unit_cell(atoms::global_id_array[atom], sci, uci);
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+         int scj[3], ucj;
+         global_id_to_unit_cell(atoms::global_id_array[atoms::neighbour_list_array[nn]], scj, ucj);
+         for(int d = 0; d < 3; d++){
+            int dsc = scj[d] - sci[d];
+            // minimum image for periodic boundaries
+            if(cs::pbc[d]){
+               if(dsc >  n[d]/2) dsc -= n[d];
+               if(dsc < -n[d]/2) dsc += n[d];
+            }
+            range[d] = std::max(range[d], std::abs(dsc));
+         }
+      }
+   }
+
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, range, 3, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+   #endif
+
+   // determine block size, which must divide the number of cells for periodic boundaries
+   for(int d = 0; d < 3; d++){
+      int k = range[d] + 1;
+      if(cs::pbc[d]) while(n[d] % k != 0) k++;
+      checkerboard_block_size[d] = std::min(k, n[d]);
+   }
+   const int* k = checkerboard_block_size;
+
+   const int num_colours = k[0]*k[1]*k[2]*num_uc_atoms;
+
+   // calculate colour of each atom (including halo atoms for checking)
+   std::vector<int> colour(atoms::num_atoms);
+   for(int atom = 0; atom < atoms::num_atoms; atom++){
+      int sc[3], uc;
+      global_id_to_unit_cell(atoms::global_id_array[atom], sc, uc);
+      colour[atom] = (((sc[2] % k[2])*k[1] + sc[1] % k[1])*k[0] + sc[0] % k[0])*num_uc_atoms + uc;
+   }
+
+   // check that no interacting atoms share a colour
+   for(int atom = 0; atom < num_local_atoms; atom++){
+      for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+         const int natom = atoms::neighbour_list_array[nn];
+         if(natom != atom && colour[natom] == colour[atom]){
+            terminaltextcolor(RED);
+            std::cerr << "Error: Unable to colour interacting atoms " << atom << " and " << natom << " for checkerboard Monte Carlo. Exiting." << std::endl;
+            terminaltextcolor(WHITE);
+            zlog << zTs() << "Error: Unable to colour interacting atoms " << atom << " and " << natom << " for checkerboard Monte Carlo. Exiting." << std::endl;
+            err::vexit();
+         }
+      }
+   }
+
+   // save lists of local atoms for each colour. Empty colours are kept so that
+   // halo swaps are synchronised between processors
+   checkerboard_colour_list.assign(num_colours, std::vector<int>(0));
+   for(int atom = 0; atom < num_local_atoms; atom++) checkerboard_colour_list[colour[atom]].push_back(atom);
+
+   checkerboard_initialised = true;
+
+   zlog << zTs() << "Checkerboard Monte Carlo initialised with " << num_colours << " colours using "
+        << k[0] << " x " << k[1] << " x " << k[2] << " unit cell blocks" << std::endl;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to generate a trial move for a single spin from pre-generated
+// uniform random numbers u[0-4], with the same algorithms as sim::mc_move
+//------------------------------------------------------------------------------
+void checkerboard_trial_move(const double sigma, const double old_spin[3], double new_spin[3], const double u[5]){
+
+   // select move type
+   int move = sim::mc_algorithm;
+   if(sim::mc_algorithm == hinzke_nowak){
+      const int pick_move = int(3.0*u[0]);
+      const int moves[3] = {spin_flip, uniform, angle};
+      move = moves[std::min(pick_move, 2)];
+   }
+
+   // spin flip needs no gaussian random numbers
+   if(move == spin_flip){
+      new_spin[0] = -old_spin[0];
+      new_spin[1] = -old_spin[1];
+      new_spin[2] = -old_spin[2];
+      return;
+   }
+
+   // gaussian random numbers from Box-Muller transform
+   const double two_pi = 2.0*M_PI;
+   const double r1 = sqrt(-2.0*log(u[1]));
+   const double r2 = sqrt(-2.0*log(u[3]));
+   const double g[3] = {r1*cos(two_pi*u[2]), r1*sin(two_pi*u[2]), r2*cos(two_pi*u[4])};
+
+   switch(move){
+      case uniform:
+         new_spin[0] = g[0];
+         new_spin[1] = g[1];
+         new_spin[2] = g[2];
+         break;
+      case angle:
+      default:
+         new_spin[0] = old_spin[0] + g[0]*sigma;
+         new_spin[1] = old_spin[1] + g[1]*sigma;
+         new_spin[2] = old_spin[2] + g[2]*sigma;
+         break;
+   }
+
+   // Apply normalisation
+   const double r = 1.0/sqrt(new_spin[0]*new_spin[0] + new_spin[1]*new_spin[1] + new_spin[2]*new_spin[2]);
+   new_spin[0] *= r;
+   new_spin[1] *= r;
+   new_spin[2] *= r;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Checkerboard Monte Carlo integrator. Atoms of each colour have no mutual
+// interactions and so are updated in parallel, with halo atoms updated
+// between colours. The colour order is chosen at random every step, which
+// together with the Metropolis acceptance of each move preserves detailed
+// balance. Random numbers for each atom are generated from a counter based
+// generator so that results are independent of the number of threads and
+// processors.
+//------------------------------------------------------------------------------
+void checkerboard_monte_carlo(){
+
+   // Check for calling of function
+   if(err::check==true) std::cout << "sim::internal::checkerboard_monte_carlo has been called" << std::endl;
+
+   if(checkerboard_initialised == false) initialize_checkerboard_colours();
+
+   // Material dependent temperature rescaling
+   std::vector<double> rescaled_material_kBTBohr(mp::num_materials);
+   std::vector<double> moment_array(mp::num_materials); // mu_s/mu_B
+   std::vector<double> sigma_array(mp::num_materials); // range for tuned gaussian random move
+   for(int m=0; m<mp::num_materials; ++m){
+      double alpha = mp::material[m].temperature_rescaling_alpha;
+      double Tc = mp::material[m].temperature_rescaling_Tc;
+      double rescaled_temperature = sim::temperature < Tc ? Tc*pow(sim::temperature/Tc,alpha) : sim::temperature;
+      rescaled_material_kBTBohr[m] = 9.27400915e-24/(rescaled_temperature*1.3806503e-23);
+      sigma_array[m] = rescaled_temperature < 1.0 ? 0.02 : pow(1.0/rescaled_material_kBTBohr[m],0.2)*0.08;
+      moment_array[m] = mp::material[m].mu_s_SI*1.07828231e23; //1/9.27400915e-24
+   }
+
+   // Random permutation of colour order, identical on all processors
+   const int num_colours = checkerboard_colour_list.size();
+   const uint64_t order_id = ~uint64_t(0); // reserved id outside range of atom ids
+   std::vector<int> colour_order(num_colours);
+   for(int c = 0; c < num_colours; c++) colour_order[c] = c;
+   for(int c = num_colours-1; c > 0; c--){
+      double u[4];
+      mtrandom::counter_uniforms(mtrandom::mc_stream, order_id, mtrandom::counter*uint64_t(num_colours) + c, u);
+      std::swap(colour_order[c], colour_order[std::min(int(u[0]*(c+1)), c)]);
+   }
+
+   double statistics_moves = 0.0;
+   double statistics_reject = 0.0;
+
+   for(int c = 0; c < num_colours; c++){
+
+      const std::vector<int>& colour_atoms = checkerboard_colour_list[colour_order[c]];
+      const int num_colour_atoms = colour_atoms.size();
+
+      // loop over all atoms of one colour in parallel
+      #pragma omp parallel for schedule(static) reduction(+:statistics_moves,statistics_reject)
+      for(int i = 0; i < num_colour_atoms; i++){
+
+         const int atom = colour_atoms[i];
+         const int imaterial = atoms::type_array[atom];
+
+         // random numbers for trial move and acceptance
+         double u[8];
+         const uint64_t id = atoms::global_id_array[atom];
+         mtrandom::counter_uniforms(mtrandom::mc_stream, id, 2*mtrandom::counter,   &u[0]);
+         mtrandom::counter_uniforms(mtrandom::mc_stream, id, 2*mtrandom::counter+1, &u[4]);
+
+         // Save old spin position
+         const double old_spin[3] = {atoms::x_spin_array[atom], atoms::y_spin_array[atom], atoms::z_spin_array[atom]};
+
+         // Make Monte Carlo move
+         double new_spin[3];
+         checkerboard_trial_move(sigma_array[imaterial], old_spin, new_spin, u);
+
+         // Copy new spin position
+         atoms::x_spin_array[atom] = new_spin[0];
+         atoms::y_spin_array[atom] = new_spin[1];
+         atoms::z_spin_array[atom] = new_spin[2];
+
+         // Calculate energy difference from local field in Joules/mu_B
+         const double DE = sim::calculate_spin_energy_difference(atom, old_spin, new_spin)*moment_array[imaterial];
+
+         statistics_moves += 1.0;
+
+         // Accept lower energy states unconditionally, otherwise evaluate probability for move
+         if(DE < 0 || exp(-DE*rescaled_material_kBTBohr[imaterial]) >= u[5]) continue;
+
+         // If rejected reset spin coordinates
+         atoms::x_spin_array[atom] = old_spin[0];
+         atoms::y_spin_array[atom] = old_spin[1];
+         atoms::z_spin_array[atom] = old_spin[2];
+         statistics_reject += 1.0;
+
+      }
+
+      // update halo spins before next colour
+      #ifdef MPICF
+         vmpi::mpi_init_halo_swap();
+         vmpi::mpi_complete_halo_swap();
+      #endif
+
+   }
+
+   // Save statistics to sim namespace variable
+   sim::mc_statistics_moves += statistics_moves;
+   sim::mc_statistics_reject += statistics_reject;
+
+   return;
+
+}
+
+} // end of namespace internal
+
+} // end of namespace sim
@@ -38,6 +38,22 @@ namespace sim{
 
       int num_monte_carlo_preconditioning_steps = 0;
 
+      bool enable_checkerboard_monte_carlo = false; // flag to use checkerboard Monte Carlo in serial
+      bool checkerboard_initialised = false; // flag to show atom colours have been calculated
+      int checkerboard_block_size[3] = {1, 1, 1}; // size of colour block in unit cells
+      std::vector<std::vector<int> > checkerboard_colour_list; // list of local atoms in each colour
+
+      bool spin_fields_reusable = false; // flag set if spin fields calculated for statistics can be reused by integrator
+      uint64_t spin_fields_time = 0; // time step for which reusable spin fields were calculated
+      double spin_fields_temperature = 0.0; // temperature for which reusable spin fields were calculated
+      std::vector<double> spin_fields_x_spin_array; // spin configuration for which reusable spin fields were calculated
+      std::vector<double> spin_fields_y_spin_array;
+      std::vector<double> spin_fields_z_spin_array;
+
+      bool external_fields_set = false; // flag set if external fields have been calculated
+      uint64_t external_fields_time = 0; // time step at which external fields were last calculated
+      double external_fields_conditions[5] = {0.0, 0.0, 0.0, 0.0, 0.0}; // temperature and applied field when external fields were last calculated
+
    } // end of internal namespace
 
 } // end of sim namespace
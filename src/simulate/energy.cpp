@@ -172,4 +172,46 @@ double calculate_spin_energy(const int atom){
 	return energy; // Tesla
 }
 
+/// @brief Calculates the energy difference for a trial move of a single spin.
+///
+/// @details Exchange, applied field and magnetostatic energies are linear in
+/// the spin direction, and so the energy difference is calculated from a
+/// single evaluation of the local field dotted with the change in spin. Only
+/// the anisotropy energy and the exchange energy of an atom with its own
+/// periodic image are evaluated separately for the old and new spin. The
+/// result is independent of the value of the spin in the spin arrays.
+///
+/// @param[in] atom atom number
+/// @param[in] old_spin spin direction before move
+/// @param[in] new_spin spin direction after move
+/// @return energy difference (Tesla)
+///
+double calculate_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]){
+
+	// Check for calling of function
+	if(err::check==true) std::cout << "calculate_spin_energy_difference has been called" << std::endl;
+
+	const int imaterial=atoms::type_array[atom];
+
+	// Calculate local field from linear energy terms
+	double H[3]={sim::H_applied*sim::H_vec[0], sim::H_applied*sim::H_vec[1], sim::H_applied*sim::H_vec[2]};
+	const bool self_image = exchange::single_spin_field(atom, H[0], H[1], H[2]);
+	if(dipole::activated){
+		H[0]+=dipole::atom_mu0demag_field_array_x[atom];
+		H[1]+=dipole::atom_mu0demag_field_array_y[atom];
+		H[2]+=dipole::atom_mu0demag_field_array_z[atom];
+	}
+
+	double energy = -(H[0]*(new_spin[0]-old_spin[0]) + H[1]*(new_spin[1]-old_spin[1]) + H[2]*(new_spin[2]-old_spin[2]));
+
+	// Add difference in exchange energy with periodic images of the same spin
+	if(self_image) energy += exchange::self_image_energy_difference(atom, old_spin, new_spin);
+
+	// Add difference in non-linear anisotropy energy
+	energy += anisotropy::single_spin_energy(atom, imaterial, new_spin[0], new_spin[1], new_spin[2], sim::temperature)
+	        - anisotropy::single_spin_energy(atom, imaterial, old_spin[0], old_spin[1], old_spin[2], sim::temperature);
+
+	return energy; // Tesla
+}
+
 } // end of namespace sim
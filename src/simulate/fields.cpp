@@ -63,6 +63,8 @@ void calculate_hamr_fields(const int,const int);
 void calculate_fmr_fields(const int,const int);
 void calculate_lagrange_fields(const int,const int);
 void calculate_full_spin_fields(const int start_index,const int end_index);
+int calculate_exchange_spin_fields(const int start_index,const int end_index);
+int calculate_non_exchange_spin_fields(const int start_index,const int end_index);
 
 int calculate_spin_fields(const int start_index,const int end_index){
 
@@ -75,10 +77,26 @@ int calculate_spin_fields(const int start_index,const int end_index){
 	// check calling of routine if error checking is activated
 	if(err::check==true){std::cout << "calculate_spin_fields has been called" << std::endl;}
 
+	calculate_exchange_spin_fields(start_index,end_index);
+	calculate_non_exchange_spin_fields(start_index,end_index);
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to initialise spin fields with the exchange fields only, so that
+// the exchange energy can be calculated from the fields before other spin
+// dependent fields are added
+//------------------------------------------------------------------------------
+int calculate_exchange_spin_fields(const int start_index,const int end_index){
+
 	// Initialise Total Spin Fields to zero
-	fill (atoms::x_total_spin_field_array.begin()+start_index,atoms::x_total_spin_field_array.begin()+end_index,0.0);
-	fill (atoms::y_total_spin_field_array.begin()+start_index,atoms::y_total_spin_field_array.begin()+end_index,0.0);
-	fill (atoms::z_total_spin_field_array.begin()+start_index,atoms::z_total_spin_field_array.begin()+end_index,0.0);
+	#pragma omp parallel for schedule(static)
+	for(int atom=start_index;atom<end_index;atom++){
+		atoms::x_total_spin_field_array[atom]=0.0;
+		atoms::y_total_spin_field_array[atom]=0.0;
+		atoms::z_total_spin_field_array[atom]=0.0;
+	}
 
    //-----------------------------------------
 	// Calculate exchange Fields
@@ -100,6 +118,14 @@ int calculate_spin_fields(const int start_index,const int end_index){
                     atoms::y_total_spin_field_array,
                     atoms::z_total_spin_field_array);
 
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to add all spin dependent fields other than exchange
+//------------------------------------------------------------------------------
+int calculate_non_exchange_spin_fields(const int start_index,const int end_index){
+
    //-----------------------------------------
    // calculate anistropy fields
    //-----------------------------------------
@@ -115,6 +141,75 @@ int calculate_spin_fields(const int start_index,const int end_index){
 	return 0;
 }
 
+//------------------------------------------------------------------------------
+// Function to mark the spin fields of all atoms as reusable by the first pass
+// of the next integrator time step. Called after statistics have calculated
+// the spin fields for the current configuration. In parallel the halo spins
+// are not up to date between time steps, so the fields are never reused.
+//------------------------------------------------------------------------------
+void set_reusable_spin_fields(){
+
+	#ifndef MPICF
+		sim::internal::spin_fields_x_spin_array = atoms::x_spin_array;
+		sim::internal::spin_fields_y_spin_array = atoms::y_spin_array;
+		sim::internal::spin_fields_z_spin_array = atoms::z_spin_array;
+		sim::internal::spin_fields_time = sim::time;
+		sim::internal::spin_fields_temperature = sim::temperature;
+		sim::internal::spin_fields_reusable = true;
+	#endif
+
+	return;
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate spin dependent fields at the start of a time step.
+// Spin fields already calculated for statistics are reused if the time,
+// temperature and spin configuration are unchanged since.
+//------------------------------------------------------------------------------
+int calculate_step_spin_fields(const int start_index,const int end_index){
+
+	using namespace sim::internal;
+
+	bool reuse = spin_fields_reusable &&
+	             spin_fields_time == sim::time &&
+	             spin_fields_temperature == sim::temperature &&
+	             sim::lagrange_multiplier == false &&
+	             spin_fields_x_spin_array.size() == atoms::x_spin_array.size();
+
+	// check spins have not been changed outside of integrator
+	if(reuse){
+		reuse = std::equal(atoms::x_spin_array.begin(), atoms::x_spin_array.end(), spin_fields_x_spin_array.begin()) &&
+		        std::equal(atoms::y_spin_array.begin(), atoms::y_spin_array.end(), spin_fields_y_spin_array.begin()) &&
+		        std::equal(atoms::z_spin_array.begin(), atoms::z_spin_array.end(), spin_fields_z_spin_array.begin());
+	}
+
+	// fields are only reused once
+	spin_fields_reusable = false;
+
+	if(!reuse) calculate_spin_fields(start_index,end_index);
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate spin dependent fields for core atoms during a halo
+// swap. The atoms are split into chunks and the halo swap is progressed
+// between chunks so that communication overlaps with computation.
+//------------------------------------------------------------------------------
+int calculate_core_spin_fields(const int start_index,const int end_index){
+
+	const int num_chunks = vmpi::num_core_atom_chunks;
+
+	for(int chunk=0;chunk<num_chunks;chunk++){
+		const int si = start_index + (chunk*(end_index-start_index))/num_chunks;
+		const int ei = start_index + ((chunk+1)*(end_index-start_index))/num_chunks;
+		calculate_spin_fields(si,ei);
+		vmpi::mpi_progress_halo_swap();
+	}
+
+	return 0;
+}
+
 int calculate_external_fields(const int start_index,const int end_index){
 	///======================================================
 	/// 		Subroutine to calculate external fields
@@ -129,9 +224,12 @@ int calculate_external_fields(const int start_index,const int end_index){
 	if(err::check==true){std::cout << "calculate_external_fields has been called" << std::endl;}
 
 	// Initialise Total External Fields to zero
-	fill (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index,0.0);
-	fill (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index,0.0);
-	fill (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index,0.0);
+	#pragma omp parallel for schedule(static)
+	for(int atom=start_index;atom<end_index;atom++){
+		atoms::x_total_external_field_array[atom]=0.0;
+		atoms::y_total_external_field_array[atom]=0.0;
+		atoms::z_total_external_field_array[atom]=0.0;
+	}
 
 	if(sim::program==7) calculate_hamr_fields(start_index,end_index);
    else if(sim::program==13){
@@ -163,9 +261,45 @@ int calculate_external_fields(const int start_index,const int end_index){
 	// Dipolar Fields
 	calculate_dipolar_fields(start_index,end_index);
 
+	// save time and conditions for statistics
+	sim::internal::external_fields_set = true;
+	sim::internal::external_fields_time = sim::time;
+	sim::internal::external_fields_conditions[0] = sim::temperature;
+	sim::internal::external_fields_conditions[1] = sim::H_applied;
+	sim::internal::external_fields_conditions[2] = sim::H_vec[0];
+	sim::internal::external_fields_conditions[3] = sim::H_vec[1];
+	sim::internal::external_fields_conditions[4] = sim::H_vec[2];
+
 	return 0;
 }
 
+//------------------------------------------------------------------------------
+// Function to determine if the external fields were calculated in the last
+// time step under the same temperature and applied field, so that statistics
+// can use them without drawing new thermal fields. Fields from time dependent
+// sources (fmr fields, hamr head fields and localised laser heating) change
+// every time step, and dipolar and spin torque fields depend on the spin
+// configuration, so these are never reused.
+//------------------------------------------------------------------------------
+bool external_fields_are_current(){
+
+	using namespace sim::internal;
+
+	const bool time_dependent_fields = sim::enable_fmr || sim::program == 7 || sim::program == 13;
+	const bool spin_dependent_fields = dipole::activated || st::is_enabled();
+
+	return !time_dependent_fields &&
+	       !spin_dependent_fields &&
+	       external_fields_set &&
+	       external_fields_time + 1 == sim::time &&
+	       external_fields_conditions[0] == sim::temperature &&
+	       external_fields_conditions[1] == sim::H_applied &&
+	       external_fields_conditions[2] == sim::H_vec[0] &&
+	       external_fields_conditions[3] == sim::H_vec[1] &&
+	       external_fields_conditions[4] == sim::H_vec[2];
+
+}
+
 int calculate_applied_fields(const int start_index,const int end_index){
 	///==========================================================================
 	///
@@ -199,6 +333,7 @@ int calculate_applied_fields(const int start_index,const int end_index){
 		}
 
 		// Add local field AND global field
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			const int imaterial=atoms::type_array[atom];
 			atoms::x_total_external_field_array[atom] += Hx + Hlocal[3*imaterial + 0];
@@ -208,6 +343,7 @@ int calculate_applied_fields(const int start_index,const int end_index){
 	}
 	else{
 		// Calculate global field
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			atoms::x_total_external_field_array[atom] += Hx;
 			atoms::y_total_external_field_array[atom] += Hy;
@@ -230,6 +366,7 @@ int calculate_applied_fields(const int start_index,const int end_index){
 		//std::cout << "mu_0" << "\t" << mu_0 << std::endl;
 		//std::cout << "Magnetisation " << stats::total_mag_actual[0] << "\t" << stats::total_mag_actual[1] << "\t" << stats::total_mag_actual[2] << std::endl;
 		//std::cout << "External Demag Field " << HD[0] << "\t" << HD[1] << "\t" << HD[2] << std::endl;
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			atoms::x_total_external_field_array[atom] += HD[0];
 			atoms::y_total_external_field_array[atom] += HD[1];
@@ -269,10 +406,20 @@ int calculate_thermal_fields(const int start_index,const int end_index){
       sigma_prefactor.push_back(sqrt_T*mp::material[mat].H_th_sigma);
    }
 
-   generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+   // Counter based random numbers are generated in parallel and independent of decomposition
+   if(mtrandom::counter_based){
+      mtrandom::gaussian_block(mtrandom::thermal_stream, atoms::global_id_array,
+                               atoms::x_total_external_field_array, atoms::y_total_external_field_array, atoms::z_total_external_field_array,
+                               start_index, end_index);
+   }
+   // Otherwise random numbers are drawn serially from a single generator so that results do not depend on number of threads
+   else{
+      mtrandom::gaussian_array(atoms::x_total_external_field_array, start_index, end_index);
+      mtrandom::gaussian_array(atoms::y_total_external_field_array, start_index, end_index);
+      mtrandom::gaussian_array(atoms::z_total_external_field_array, start_index, end_index);
+   }
 
+   #pragma omp parallel for schedule(static)
    for(int atom=start_index;atom<end_index;atom++){
 
       const int imaterial=atoms::type_array[atom];
@@ -300,6 +447,7 @@ int calculate_dipolar_fields(const int start_index,const int end_index){
 
    // Add dipolar fields
    if(dipole::activated){
+      #pragma omp parallel for schedule(static)
       for(int atom=start_index;atom<end_index;atom++){
          atoms::x_total_external_field_array[atom] += dipole::atom_dipolar_field_array_x[atom];
          atoms::y_total_external_field_array[atom] += dipole::atom_dipolar_field_array_y[atom];
@@ -338,11 +486,19 @@ void calculate_hamr_fields(const int start_index,const int end_index){
 	const double Hvecz=sim::H_vec[2];
 
 	// Add localised thermal field
-	generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-	generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-	generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+	if(mtrandom::counter_based){
+		mtrandom::gaussian_block(mtrandom::thermal_stream, atoms::global_id_array,
+										 atoms::x_total_external_field_array, atoms::y_total_external_field_array, atoms::z_total_external_field_array,
+										 start_index, end_index);
+	}
+	else{
+		mtrandom::gaussian_array(atoms::x_total_external_field_array, start_index, end_index);
+		mtrandom::gaussian_array(atoms::y_total_external_field_array, start_index, end_index);
+		mtrandom::gaussian_array(atoms::z_total_external_field_array, start_index, end_index);
+	}
 
 	if(sim::head_laser_on){
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			const int imaterial=atoms::type_array[atom];
 			const double cx = atoms::x_coord_array[atom];
@@ -356,6 +512,7 @@ void calculate_hamr_fields(const int start_index,const int end_index){
 		}
 
 		// Add localised applied field
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			const double cx = atoms::x_coord_array[atom];
 			const double cy = atoms::y_coord_array[atom];
@@ -375,6 +532,7 @@ void calculate_hamr_fields(const int start_index,const int end_index){
 	else{
 		// Otherwise just use global temperature
 		double sqrt_T=sqrt(sim::temperature);
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			const int imaterial=atoms::type_array[atom];
 			const double H_th_sigma = sqrt_T*material_parameters::material[imaterial].H_th_sigma;
@@ -418,6 +576,7 @@ void calculate_fmr_fields(const int start_index,const int end_index){
 		}
 
 		// Add local field AND global field
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			const int imaterial=atoms::type_array[atom];
 			atoms::x_total_external_field_array[atom] += Hx + H_fmr_local[3*imaterial + 0];
@@ -427,6 +586,7 @@ void calculate_fmr_fields(const int start_index,const int end_index){
 	}
 	else{
 		// Add fmr field
+		#pragma omp parallel for schedule(static)
 		for(int atom=start_index;atom<end_index;atom++){
 			atoms::x_total_external_field_array[atom] += Hx;
 			atoms::y_total_external_field_array[atom] += Hy;
@@ -464,6 +624,7 @@ void calculate_lagrange_fields(const int start_index,const int end_index){
    const double N=sim::lagrange_N;
 
    // Calculate LaGrange fields
+   #pragma omp parallel for schedule(static)
    for(int atom=start_index;atom<end_index;atom++){
       const double sx=atoms::x_spin_array[atom];
       const double sy=atoms::y_spin_array[atom];
@@ -495,6 +656,7 @@ void calculate_full_spin_fields(const int start_index,const int end_index){
 
 	using namespace sim::internal;
 
+   #pragma omp parallel for schedule(static)
    for(int atom=start_index;atom<end_index;atom++){
 
 		// temporary variables for field components
@@ -54,6 +54,33 @@ namespace sim{
          sim::internal::num_monte_carlo_preconditioning_steps = n;
          return true;
       }
+      test="checkerboard-monte-carlo";
+      if(word==test){
+         test="";
+         if(value==test){
+            sim::internal::enable_checkerboard_monte_carlo = true;
+            return true;
+         }
+         test="true";
+         if(value==test){
+            sim::internal::enable_checkerboard_monte_carlo = true;
+            return true;
+         }
+         // default
+         test="false";
+         if(value==test){
+            sim::internal::enable_checkerboard_monte_carlo = false;
+            return true;
+         }
+         else{
+            terminaltextcolor(RED);
+            std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
+            std::cerr << "\t\"true\"" << std::endl;
+            std::cerr << "\t\"false\"" << std::endl;
+            terminaltextcolor(WHITE);
+            err::vexit();
+         }
+      }
       //-------------------------------------------------------------------
       test="time-step";
       if(word==test){
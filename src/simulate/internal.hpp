@@ -58,8 +58,25 @@ namespace sim{
 
       extern int num_monte_carlo_preconditioning_steps;
 
+      extern bool enable_checkerboard_monte_carlo; // flag to use checkerboard Monte Carlo in serial
+      extern bool checkerboard_initialised; // flag to show atom colours have been calculated
+      extern int checkerboard_block_size[3]; // size of colour block in unit cells
+      extern std::vector<std::vector<int> > checkerboard_colour_list; // list of local atoms in each colour
+
+      extern bool spin_fields_reusable; // flag set if spin fields calculated for statistics can be reused by integrator
+      extern uint64_t spin_fields_time; // time step for which reusable spin fields were calculated
+      extern double spin_fields_temperature; // temperature for which reusable spin fields were calculated
+      extern std::vector<double> spin_fields_x_spin_array; // spin configuration for which reusable spin fields were calculated
+      extern std::vector<double> spin_fields_y_spin_array;
+      extern std::vector<double> spin_fields_z_spin_array;
+
+      extern bool external_fields_set; // flag set if external fields have been calculated
+      extern uint64_t external_fields_time; // time step at which external fields were last calculated
+      extern double external_fields_conditions[5]; // temperature and applied field when external fields were last calculated
+
       // internal function declarations
       extern void monte_carlo_preconditioning();
+      extern void checkerboard_monte_carlo();
 
    } // end of internal namespace
 } // end of sim namespace
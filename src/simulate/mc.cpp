@@ -97,8 +97,6 @@ int MonteCarlo(){
 
 	// Temporaries
 	int atom=0;
-	double Eold=0.0;
-	double Enew=0.0;
 	double DE=0.0;
 
    // Material dependent temperature rescaling
@@ -138,19 +136,13 @@ int MonteCarlo(){
       // Make Monte Carlo move
       sim::mc_move(Sold, Snew);
 
-		// Calculate current energy
-		Eold = sim::calculate_spin_energy(atom);
-
 		// Copy new spin position
 		atoms::x_spin_array[atom] = Snew[0];
 		atoms::y_spin_array[atom] = Snew[1];
 		atoms::z_spin_array[atom] = Snew[2];
 
-		// Calculate new energy
-		Enew = sim::calculate_spin_energy(atom);
-
-		// Calculate difference in Joules/mu_B
-		DE = (Enew-Eold)*mp::material[imaterial].mu_s_SI*1.07828231e23; //1/9.27400915e-24
+		// Calculate energy difference from local field in Joules/mu_B
+		DE = sim::calculate_spin_energy_difference(atom, &Sold[0], &Snew[0])*mp::material[imaterial].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 		// Check for lower energy state and accept unconditionally
 		if(DE<0) continue;
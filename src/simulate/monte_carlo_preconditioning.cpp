@@ -112,9 +112,6 @@ void monte_carlo_preconditioning(){
 
          //std::cout << "here" << std::endl;
 
-   		// Calculate current energy
-   		double old_energy = sim::calculate_spin_energy(atom);
-
    		// Copy new spin position
    		atoms::x_spin_array[atom] = new_spin[0];
    		atoms::y_spin_array[atom] = new_spin[1];
@@ -122,12 +119,8 @@ void monte_carlo_preconditioning(){
 
          //std::cout << "here2" << std::endl;
 
-
-   		// Calculate new energy
-   		const double new_energy = sim::calculate_spin_energy(atom);
-
-   		// Calculate difference in Joules/mu_B
-   		const double DE = (new_energy - old_energy) * moment_array[imaterial];
+   		// Calculate energy difference from local field in Joules/mu_B
+   		const double DE = sim::calculate_spin_energy_difference(atom, &old_spin[0], &new_spin[0]) * moment_array[imaterial];
 
    		// Check for lower energy state and accept unconditionally
    		if(DE<0) continue;
@@ -41,6 +41,7 @@
 ///
 
 // Standard Libraries
+#include <algorithm>
 #include <iostream>
 
 // Vampire Header files
@@ -59,6 +60,7 @@
 #include "stopwatch.hpp"
 #include "vio.hpp"
 #include "vmpi.hpp"
+#include "vomp.hpp"
 #include "vutil.hpp"
 
 // sim module headers
@@ -163,6 +165,9 @@ namespace sim{
    bool save_checkpoint_flag=false; // Save checkpoint
    bool save_checkpoint_continuous_flag=false; // save checkpoints during simulations
    int save_checkpoint_rate=1; // Default increment between checkpoints
+   int checkpoint_generations=1; // Number of previous checkpoint files kept
+   bool asynchronous_checkpoint_flag=false; // write checkpoints in the background
+   int checkpoint_output_nodes=0; // Number of collated checkpoint files (0 = file per process)
 
    // Local function declarations
    void integrate_serial(uint64_t);
@@ -198,6 +203,9 @@ namespace sim{
 		sim::time++;
 		sim::head_position[0]+=sim::head_speed*mp::dt_SI*1.0e10;
 
+		// advance counter based random number generator to next time step
+		mtrandom::counter++;
+
       // Update dipole fields
 		dipole::calculate_field(sim::time);
 
@@ -234,6 +242,9 @@ int run(){
 	// Check for calling of function
 	if(err::check==true) std::cout << "sim::run has been called" << std::endl;
 
+	// Initialise shared memory parallelisation
+	vomp::initialize();
+
 	// Initialise simulation data structures
 	sim::initialize(mp::num_materials);
 
@@ -316,6 +327,9 @@ int run(){
 	vmpi::WaitTime=MPI_Wtime();
 	vmpi::TotalComputeTime=0.0;
 	vmpi::TotalWaitTime=0.0;
+	std::fill(vmpi::PeerWaitTimeArray.begin(),vmpi::PeerWaitTimeArray.end(),0.0);
+	std::fill(vmpi::PeerSendBytesArray.begin(),vmpi::PeerSendBytesArray.end(),0.0);
+	std::fill(vmpi::PeerRecvBytesArray.begin(),vmpi::PeerRecvBytesArray.end(),0.0);
 	#endif
 
 	// Select program to run
@@ -472,6 +486,14 @@ int run(){
 		  	program::setting_process();
 		    break;
 
+		case 52:
+			if(vmpi::my_rank==0){
+				std::cout << "Diagnostic-Random-Numbers..." << std::endl;
+				zlog << "Diagnostic-Random-Numbers..." << std::endl;
+			}
+			program::random_number_benchmark();
+			break;
+
 		default:{
 			std::cerr << "Unknown Internal Program ID "<< sim::program << " requested, exiting" << std::endl;
 			zlog << "Unknown Internal Program ID "<< sim::program << " requested, exiting" << std::endl;
@@ -508,6 +530,9 @@ int run(){
       zlog << zTs() << "\t" << (cmc::sphere_reject/cmc::mc_total)*100.0 << "% Rejected (Sphere)" << std::endl;
    }
 
+   // Output adaptive dipole field update statistics if applicable
+   dipole::output_update_statistics();
+
 	//program::LLB_Boltzmann();
 
    // De-initialize GPU
@@ -516,6 +541,9 @@ int run(){
    // optionally save checkpoint file
    if(sim::save_checkpoint_flag && !sim::save_checkpoint_continuous_flag) save_checkpoint();
 
+   // wait for checkpoint written in the background
+   wait_for_checkpoint();
+
 	return EXIT_SUCCESS;
 }
 
@@ -600,7 +628,9 @@ void integrate_serial(uint64_t n_steps){
 
 		case 1: // Montecarlo
 			for(uint64_t ti=0;ti<n_steps;ti++){
-				sim::MonteCarlo();
+				// Optionally use checkerboard algorithm for parallel moves
+				if(sim::internal::enable_checkerboard_monte_carlo) sim::internal::checkerboard_monte_carlo();
+				else sim::MonteCarlo();
 				// increment time
 				increment_time();
 			}
@@ -686,10 +716,8 @@ int integrate_mpi(uint64_t n_steps){
 
 		case 1: // Montecarlo
 			for(uint64_t ti=0;ti<n_steps;ti++){
-				terminaltextcolor(RED);
-				std::cerr << "Error - Monte Carlo Integrator unavailable for parallel execution" << std::endl;
-				terminaltextcolor(WHITE);
-				err::vexit();
+				// Checkerboard algorithm moves non-interacting spins on all processors simultaneously
+				sim::internal::checkerboard_monte_carlo();
 				// increment time
 				increment_time();
 			}
@@ -19,6 +19,12 @@
 
 namespace st{
 
+   //-----------------------------------------------------------------------------
+   // Function to check spin torque calculation is enabled
+   //-----------------------------------------------------------------------------
+   bool is_enabled(){
+      return st::internal::enabled;
+   }
 
    //-----------------------------------------------------------------------------
    // Function for updating spin torque fields
@@ -66,9 +72,12 @@ namespace st{
 
 
       // Add spin torque fields
-      for(int i=start_index; i<end_index; ++i) x_total_external_field_array[i] += st::internal::x_field_array[i];
-      for(int i=start_index; i<end_index; ++i) y_total_external_field_array[i] += st::internal::y_field_array[i];
-      for(int i=start_index; i<end_index; ++i) z_total_external_field_array[i] += st::internal::z_field_array[i];
+      #pragma omp parallel for schedule(static)
+      for(int i=start_index; i<end_index; ++i){
+         x_total_external_field_array[i] += st::internal::x_field_array[i];
+         y_total_external_field_array[i] += st::internal::y_field_array[i];
+         z_total_external_field_array[i] += st::internal::z_field_array[i];
+      }
 
       return;
    }
@@ -8,10 +8,14 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <vector>
 
 // Vampire headers
 #include "stats.hpp"
 
+// statistics module headers
+#include "internal.hpp"
+
 namespace stats{
 
    bool calculate_system_magnetization          = true;
@@ -34,5 +38,8 @@ namespace stats{
    //-----------------------------------------------------------------------------
    namespace internal{
 
+      std::vector<double> thread_magnetization;
+      std::vector<double> combined_magnetization;
+
    } // end of internal namespace
 } // end of stats namespace
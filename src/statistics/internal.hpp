@@ -0,0 +1,38 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) agent 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+#ifndef STATS_INTERNAL_H_
+#define STATS_INTERNAL_H_
+//
+//---------------------------------------------------------------------
+// This header file defines shared internal data structures and
+// functions for the statistics module. These functions and
+// variables should not be accessed outside of this module.
+//---------------------------------------------------------------------
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "stats.hpp"
+
+namespace stats{
+
+   namespace internal{
+
+      //-------------------------------------------------------------------------
+      // Internal shared variables
+      //-------------------------------------------------------------------------
+      extern std::vector<double> thread_magnetization;   /// accumulators for magnetization of each thread
+      extern std::vector<double> combined_magnetization; /// magnetization of all statistics for single reduction
+
+   } // end of internal namespace
+
+} // end of stats namespace
+
+#endif //STATS_INTERNAL_H_
@@ -18,6 +18,10 @@
 #include "stats.hpp"
 #include "vmpi.hpp"
 #include "vio.hpp"
+#include "vomp.hpp"
+
+// statistics module headers
+#include "internal.hpp"
 
 namespace stats{
 
@@ -121,22 +125,17 @@ void magnetization_statistic_t::calculate_magnetization(const std::vector<double
                                                          const std::vector<double>& sz,
                                                          const std::vector<double>& mm){
 
-   // initialise magnetization to zero [.end() seems to be optimised away by the compiler...]
-   std::fill(magnetization.begin(),magnetization.end(),0.0);
+   std::vector<magnetization_statistic_t*> stats_list(1, this);
+   stats::calculate_magnetizations(stats_list, sx, sy, sz, mm);
 
-   // calculate contributions of spins to each magetization category
-   for(int atom=0; atom<num_atoms; ++atom){
-      const int mask_id = mask[atom]; // get mask id
-      magnetization[4*mask_id + 0] += sx[atom]*mm[atom];
-      magnetization[4*mask_id + 1] += sy[atom]*mm[atom];
-      magnetization[4*mask_id + 2] += sz[atom]*mm[atom];
-      magnetization[4*mask_id + 3] += mm[atom];
-   }
+   return;
 
-   // Reduce on all CPUS
-   #ifdef MPICF
-      MPI_Allreduce(MPI_IN_PLACE, &magnetization[0], 4*mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   #endif
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to normalise reduced magnetization and add to mean
+//------------------------------------------------------------------------------------------------------
+void magnetization_statistic_t::normalize_magnetization(){
 
    // Calculate magnetisation length and normalize
    for(int mask_id=0; mask_id<mask_size; ++mask_id){
@@ -164,6 +163,105 @@ void magnetization_statistic_t::calculate_magnetization(const std::vector<double
 
 }
 
+//------------------------------------------------------------------------------------------------------
+// Function to calculate the magnetization of several statistics in a single pass over atoms.
+//
+// The moments of each atom are computed once in blocks and added to the mask elements of every
+// statistic in thread local accumulators. The accumulators are summed in thread order and the
+// results for all statistics are reduced between processors in a single call.
+//------------------------------------------------------------------------------------------------------
+void calculate_magnetizations(const std::vector<magnetization_statistic_t*>& stats_list,
+                              const std::vector<double>& sx, // spin unit vector
+                              const std::vector<double>& sy,
+                              const std::vector<double>& sz,
+                              const std::vector<double>& mm){
+
+   const int num_stats = stats_list.size();
+   if(num_stats == 0) return;
+
+   // determine offsets of each statistic in combined buffer
+   std::vector<int> offset(num_stats+1, 0);
+   std::vector<const int*> mask(num_stats);
+   for(int s=0; s<num_stats; ++s){
+      offset[s+1] = offset[s] + stats_list[s]->magnetization.size();
+      mask[s] = stats_list[s]->mask.size() > 0 ? &stats_list[s]->mask[0] : NULL;
+   }
+   const int buffer_size = offset[num_stats];
+
+   // all statistics use the same atoms
+   const int num_atoms = stats_list[0]->num_atoms;
+
+   const int num_threads = vomp::get_num_threads();
+   std::vector<double>& thread_magnetization = stats::internal::thread_magnetization;
+   std::vector<double>& combined_magnetization = stats::internal::combined_magnetization;
+   combined_magnetization.resize(buffer_size);
+
+   // zero all accumulators so that slices of threads not started by the
+   // runtime do not contribute to the sum
+   thread_magnetization.assign(num_threads*buffer_size, 0.0);
+
+   // number of atoms for which moments are calculated together
+   const int block_size = 256;
+
+   #pragma omp parallel num_threads(num_threads)
+   {
+      double* magnetization = &thread_magnetization[vomp::get_thread_id()*buffer_size];
+
+      double mx[block_size];
+      double my[block_size];
+      double mz[block_size];
+
+      #pragma omp for schedule(static)
+      for(int block=0; block<num_atoms; block+=block_size){
+
+         const int num_block_atoms = std::min(block_size, num_atoms-block);
+
+         // calculate moments of atoms in block
+         #pragma omp simd
+         for(int i=0; i<num_block_atoms; ++i){
+            mx[i] = sx[block+i]*mm[block+i];
+            my[i] = sy[block+i]*mm[block+i];
+            mz[i] = sz[block+i]*mm[block+i];
+         }
+
+         // add contributions of spins to each magnetization category
+         for(int s=0; s<num_stats; ++s){
+            double* smag = magnetization + offset[s];
+            const int* smask = mask[s] + block;
+            for(int i=0; i<num_block_atoms; ++i){
+               const int mask_id = smask[i];
+               smag[4*mask_id + 0] += mx[i];
+               smag[4*mask_id + 1] += my[i];
+               smag[4*mask_id + 2] += mz[i];
+               smag[4*mask_id + 3] += mm[block+i];
+            }
+         }
+
+      }
+   }
+
+   // sum thread accumulators in thread order
+   std::copy(thread_magnetization.begin(), thread_magnetization.begin()+buffer_size, combined_magnetization.begin());
+   for(int thread=1; thread<num_threads; ++thread){
+      const double* magnetization = &thread_magnetization[thread*buffer_size];
+      for(int idx=0; idx<buffer_size; ++idx) combined_magnetization[idx] += magnetization[idx];
+   }
+
+   // Reduce all statistics on all CPUS
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, &combined_magnetization[0], buffer_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   // copy results and normalise each statistic
+   for(int s=0; s<num_stats; ++s){
+      std::copy(combined_magnetization.begin()+offset[s], combined_magnetization.begin()+offset[s+1], stats_list[s]->magnetization.begin());
+      stats_list[s]->normalize_magnetization();
+   }
+
+   return;
+
+}
+
 //------------------------------------------------------------------------------------------------------
 // Function to get magnetisation data
 //------------------------------------------------------------------------------------------------------
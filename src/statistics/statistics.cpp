@@ -33,11 +33,14 @@ namespace stats{
          gpu::stats::update();
       }
       else{
-         // update magnetization statistics
-         if(stats::calculate_system_magnetization)          stats::system_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_material_magnetization)        stats::material_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_height_magnetization)          stats::height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
+         // update all magnetization statistics in a single pass
+         std::vector<magnetization_statistic_t*> stats_list;
+         if(stats::calculate_system_magnetization)          stats_list.push_back(&stats::system_magnetization);
+         if(stats::calculate_material_magnetization)        stats_list.push_back(&stats::material_magnetization);
+         if(stats::calculate_height_magnetization)          stats_list.push_back(&stats::height_magnetization);
+         if(stats::calculate_material_height_magnetization) stats_list.push_back(&stats::material_height_magnetization);
+
+         stats::calculate_magnetizations(stats_list,sx,sy,sz,mm);
 
          // update susceptibility statistics
          if(stats::calculate_system_susceptibility)         stats::system_susceptibility.calculate(stats::system_magnetization.get_magnetization());
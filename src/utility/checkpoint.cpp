@@ -8,163 +8,815 @@
 //-----------------------------------------------------------------------------
 
 // System headers
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 // Program headers
 #include "atoms.hpp"
+#include "create.hpp"
 #include "errors.hpp"
 #include "random.hpp"
 #include "sim.hpp"
 #include "vio.hpp"
+#include "vutil.hpp"
 #include "program.hpp"
 
 //-----------------------------------------------------------------------------
-// Function to save checkpoint file
+// Checkpoint files consist of a 64 byte header followed by the checkpoint data
+// (payload) of one process:
+//
+//    bytes  0- 7 : "VAMPCHKP"
+//    bytes  8-15 : format version
+//    bytes 16-23 : rank of process
+//    bytes 24-31 : number of processes
+//    bytes 32-39 : size of payload (bytes)
+//    bytes 40-47 : checksum of payload
+//    bytes 48-55 : checksum of header bytes 0-47
+//    bytes 56-63 : reserved
+//
+// The payload has the same layout as checkpoint files written by earlier
+// versions, which have no header and can still be loaded. Collated checkpoint
+// files (sim:checkpoint-output-nodes) contain the records (header and payload)
+// of all processes in an output group, preceded by a group header and index:
+//
+//    bytes  0- 7 : "VAMPCHKG"
+//    bytes  8-15 : format version
+//    bytes 16-23 : number of records
+//    bytes 24-31 : checksum of index
+//    index       : rank, offset and size of each record (3 x 8 bytes)
+//
+// Files are written under a temporary name and renamed once complete, so that
+// an interrupted write never replaces the previous checkpoint.
 //-----------------------------------------------------------------------------
-void save_checkpoint(){
+namespace checkpoint{
+namespace internal{
 
-   // convert number of atoms, rank and time to standard long int
-   uint64_t natoms64 = uint64_t(atoms::num_atoms-vmpi::num_halo_atoms);
-   int64_t time64 = int64_t(sim::time);
-   int64_t eqtime64 = int64_t(sim::equilibration_time);
-   int64_t parity64 = int64_t(sim::parity);
-   int64_t iH64 = int64_t(sim::iH);
-   double temp = sim::temperature;
-   int64_t output_atoms_file_counter64 = int64_t(sim::output_atoms_file_counter);
-   int64_t output_cells_file_counter64 = int64_t(sim::output_cells_file_counter);
-   int64_t output_rate_counter64 = int64_t(sim::output_rate_counter);
-   double constr_theta = sim::constraint_theta;
-   double constr_phi   = sim::constraint_phi;
-   bool flag_constraint_theta_changed = sim::constraint_theta_changed;
-   bool flag_constraint_phi_changed   = sim::constraint_phi_changed;
-
-   // determine checkpoint file name
-   std::stringstream chkfilenamess;
-   chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
-   std::string chkfilename = chkfilenamess.str();
-
-   // open checkpoint file
-   std::ofstream chkfile;
-   chkfile.open(chkfilename.c_str(),std::ios::binary);
-
-   // check for open file
-   if(!chkfile.is_open()){
+   const uint64_t version = 2; // checkpoint format version
+   const uint64_t header_size = 64; // size of record header (bytes)
+   const uint64_t group_header_size = 32; // size of collated file header (bytes)
+   const uint64_t index_entry_size = 24; // size of collated file index entry (bytes)
+
+   // variables for asynchronous checkpoint output
+   bool in_flight = false; // flag to indicate checkpoint is being written
+   bool collated_in_flight = false; // flag to indicate collated checkpoint is being written
+   std::thread writer; // background thread writing checkpoint file
+   std::vector<char> buffer; // snapshot of checkpoint being written
+   std::string filename; // name of checkpoint file being written
+   std::string error; // error message from background write
+   double io_time = 0.0; // time taken to write checkpoint file
+   vutil::vtimer_t timer; // timer for collated writes
+
+   #ifdef MPICF
+      // variables for collated checkpoint output
+      bool group_initialised = false;
+      int group_id = 0;
+      int group_rank = 0;
+      int group_size = 1;
+      MPI_Comm group_comm;
+      MPI_File fh;
+      MPI_Request request = MPI_REQUEST_NULL;
+      bool write_failed = false; // flag to indicate MPI-IO write failed on this process
+      const uint64_t max_chunk_size = 1 << 30; // largest single MPI-IO write (int counts limit writes to 2 GiB)
+   #endif
+
+   //--------------------------------------------------------------------------
+   // Functions to pack data into and unpack data from byte buffers. Unpack
+   // returns false if the buffer is too short.
+   //--------------------------------------------------------------------------
+   template <typename T> void pack(std::vector<char>& buffer, const T* data, const uint64_t count){
+      const char* bytes = reinterpret_cast<const char*>(data);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T)*count);
+   }
+
+   template <typename T> void pack(std::vector<char>& buffer, const T& value){
+      pack(buffer, &value, 1);
+   }
+
+   template <typename T> bool unpack(const std::vector<char>& buffer, uint64_t& position, T* data, const uint64_t count){
+      const uint64_t bytes = sizeof(T)*count;
+      if(position > buffer.size() || bytes > buffer.size() - position) return false;
+      if(bytes > 0) std::memcpy(data, &buffer[position], bytes);
+      position += bytes;
+      return true;
+   }
+
+   template <typename T> bool unpack(const std::vector<char>& buffer, uint64_t& position, T& value){
+      return unpack(buffer, position, &value, 1);
+   }
+
+   inline uint64_t read_uint(const char* data){
+      uint64_t value;
+      std::memcpy(&value, data, sizeof(uint64_t));
+      return value;
+   }
+
+   inline void write_uint(char* data, const uint64_t value){
+      std::memcpy(data, &value, sizeof(uint64_t));
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to print error message and exit
+   //--------------------------------------------------------------------------
+   void exit_with_error(const std::string& message, const std::string& info = ""){
       terminaltextcolor(RED);
-      std::cerr << "Error: Unable to open checkpoint file " << chkfilename << " for writing. Exiting." << std::endl;
+      std::cerr << "Error: " << message << " Exiting." << std::endl;
+      if(info.size() > 0) std::cerr << "Info: " << info << std::endl;
       terminaltextcolor(WHITE);
-      zlog << zTs() << "Error: Unable to open checkpoint file " << chkfilename << " for writing. Exiting." << std::endl;
+      zlog << zTs() << "Error: " << message << " Exiting." << std::endl;
+      if(info.size() > 0) zlog << zTs() << "Info: " << info << std::endl;
       err::vexit();
    }
 
-   // get state of random number generator
-   std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
-   int32_t mt_p=0; // position in rng state
-   mt_p=mtrandom::grnd.get_state(mt_state);
-   //std::cout << "random generator state = " << mt_p << std::endl;
-
-   // write checkpoint variables to file
-   chkfile.write(reinterpret_cast<const char*>(&natoms64),sizeof(uint64_t));
-   chkfile.write(reinterpret_cast<const char*>(&time64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&eqtime64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&parity64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&iH64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&temp),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&constr_theta),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&constr_phi),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&flag_constraint_theta_changed),sizeof(bool));
-   chkfile.write(reinterpret_cast<const char*>(&flag_constraint_phi_changed  ),sizeof(bool));
-   chkfile.write(reinterpret_cast<const char*>(&output_atoms_file_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&output_cells_file_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&output_rate_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&mt_p),sizeof(int32_t));
-   chkfile.write(reinterpret_cast<const char*>(&mt_state[0]),sizeof(uint32_t)*mt_state.size());
-
-   // write spin array to file
-   chkfile.write(reinterpret_cast<const char*>(&atoms::x_spin_array[0]),sizeof(double)*natoms64);
-   chkfile.write(reinterpret_cast<const char*>(&atoms::y_spin_array[0]),sizeof(double)*natoms64);
-   chkfile.write(reinterpret_cast<const char*>(&atoms::z_spin_array[0]),sizeof(double)*natoms64);
-
-   // close checkpoint file
-   chkfile.close();
+   //--------------------------------------------------------------------------
+   // Function to determine checkpoint file name, with one file per process or
+   // one file per output group for collated output
+   //--------------------------------------------------------------------------
+   std::string checkpoint_filename(){
+      std::stringstream chkfilenamess;
+      #ifdef MPICF
+         if(sim::checkpoint_output_nodes > 0){
+            chkfilenamess << "vampire-group" << group_id << ".chk";
+            return chkfilenamess.str();
+         }
+      #endif
+      chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
+      return chkfilenamess.str();
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to determine file name of previous checkpoint generation
+   //--------------------------------------------------------------------------
+   std::string generation_filename(const std::string& name, const int generation){
+      if(generation == 0) return name;
+      std::stringstream gss;
+      gss << name << "." << generation;
+      return gss.str();
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to copy state of simulation into a checkpoint record, leaving
+   // space for the header
+   //--------------------------------------------------------------------------
+   void pack_checkpoint(std::vector<char>& record){
+
+      // convert number of atoms, rank and time to standard long int
+      uint64_t natoms64 = uint64_t(atoms::num_atoms-vmpi::num_halo_atoms);
+      int64_t time64 = int64_t(sim::time);
+      int64_t eqtime64 = int64_t(sim::equilibration_time);
+      int64_t parity64 = int64_t(sim::parity);
+      int64_t iH64 = int64_t(sim::iH);
+      double temp = sim::temperature;
+      int64_t output_atoms_file_counter64 = int64_t(sim::output_atoms_file_counter);
+      int64_t output_cells_file_counter64 = int64_t(sim::output_cells_file_counter);
+      int64_t output_rate_counter64 = int64_t(sim::output_rate_counter);
+      double constr_theta = sim::constraint_theta;
+      double constr_phi   = sim::constraint_phi;
+      bool flag_constraint_theta_changed = sim::constraint_theta_changed;
+      bool flag_constraint_phi_changed   = sim::constraint_phi_changed;
+
+      // get state of random number generator
+      std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
+      int32_t mt_p=0; // position in rng state
+      mt_p=mtrandom::grnd.get_state(mt_state);
+
+      record.resize(0);
+      record.reserve(header_size + 256 + sizeof(uint32_t)*mt_state.size() + 3*sizeof(double)*natoms64);
+      record.resize(header_size, 0);
+
+      // pack checkpoint variables
+      pack(record, natoms64);
+      pack(record, time64);
+      pack(record, eqtime64);
+      pack(record, parity64);
+      pack(record, iH64);
+      pack(record, temp);
+      pack(record, constr_theta);
+      pack(record, constr_phi);
+      pack(record, flag_constraint_theta_changed);
+      pack(record, flag_constraint_phi_changed);
+      pack(record, output_atoms_file_counter64);
+      pack(record, output_cells_file_counter64);
+      pack(record, output_rate_counter64);
+      // a negative rng position flags that the counter based generator state follows the mt state
+      if(mtrandom::counter_based){
+         int32_t flagged_mt_p = -mt_p-1;
+         uint64_t counter64 = mtrandom::counter;
+         pack(record, flagged_mt_p);
+         pack(record, &mt_state[0], mt_state.size());
+         pack(record, counter64);
+      }
+      else{
+         pack(record, mt_p);
+         pack(record, &mt_state[0], mt_state.size());
+      }
+
+      // pack spin arrays
+      if(create::renumbered_atom_array.size() == natoms64){
+         // atoms have been renumbered, so write spins in generation order
+         std::vector<double>* spin_arrays[3] = {&atoms::x_spin_array, &atoms::y_spin_array, &atoms::z_spin_array};
+         for(int i=0; i<3; i++){
+            const uint64_t start = record.size();
+            record.resize(start + sizeof(double)*natoms64);
+            for(uint64_t atom=0; atom<natoms64; atom++){
+               const double s = (*spin_arrays[i])[create::renumbered_atom_array[atom]];
+               std::memcpy(&record[start + sizeof(double)*atom], &s, sizeof(double));
+            }
+         }
+      }
+      else{
+         pack(record, &atoms::x_spin_array[0], natoms64);
+         pack(record, &atoms::y_spin_array[0], natoms64);
+         pack(record, &atoms::z_spin_array[0], natoms64);
+      }
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to fill in header of checkpoint record including checksums
+   //--------------------------------------------------------------------------
+   void finalize_record(std::vector<char>& record){
+
+      const uint64_t payload_size = record.size() - header_size;
+      char* header = &record[0];
+
+      std::memcpy(header, "VAMPCHKP", 8);
+      write_uint(header +  8, version);
+      write_uint(header + 16, vmpi::my_rank);
+      write_uint(header + 24, vmpi::num_processors);
+      write_uint(header + 32, payload_size);
+      write_uint(header + 40, vutil::checksum(&record[header_size], payload_size));
+      write_uint(header + 48, vutil::checksum(header, 48));
+      write_uint(header + 56, 0);
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to replace checkpoint file with newly written temporary file,
+   // keeping previous generations as name.1, name.2, ... The current file is
+   // hard linked to name.1 so that a complete checkpoint always exists under
+   // the original name. Returns an error message if the rename fails.
+   //--------------------------------------------------------------------------
+   std::string commit_file(const std::string& tmp_name, const std::string& name){
+
+      const int generations = sim::checkpoint_generations;
+
+      // shift older generations
+      for(int g = generations - 1; g > 1; g--){
+         std::rename(generation_filename(name, g-1).c_str(), generation_filename(name, g).c_str());
+      }
+
+      // keep current checkpoint as previous generation
+      if(generations > 1){
+         std::remove(generation_filename(name, 1).c_str());
+         #ifdef WIN_COMPILE
+            std::rename(name.c_str(), generation_filename(name, 1).c_str());
+         #else
+            if(link(name.c_str(), generation_filename(name, 1).c_str()) != 0){
+               std::rename(name.c_str(), generation_filename(name, 1).c_str());
+            }
+         #endif
+      }
+
+      if(std::rename(tmp_name.c_str(), name.c_str()) != 0){
+         return "Unable to rename checkpoint file " + tmp_name + " to " + name + ".";
+      }
+
+      return "";
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to write checkpoint record to temporary file, flush it to disk
+   // and replace the checkpoint file. Returns an error message on failure.
+   //--------------------------------------------------------------------------
+   std::string write_file(const std::string& name, const std::vector<char>& record){
+
+      const std::string tmp_name = name + ".tmp";
+
+      FILE* chkfile = std::fopen(tmp_name.c_str(), "wb");
+      if(chkfile == NULL) return "Unable to open checkpoint file " + tmp_name + " for writing.";
+
+      bool ok = (std::fwrite(&record[0], 1, record.size(), chkfile) == record.size());
+      ok = (std::fflush(chkfile) == 0) && ok;
+      #ifndef WIN_COMPILE
+         ok = (fsync(fileno(chkfile)) == 0) && ok;
+      #endif
+      ok = (std::fclose(chkfile) == 0) && ok;
+
+      if(!ok){
+         std::remove(tmp_name.c_str());
+         return "Unable to write checkpoint file " + tmp_name + ".";
+      }
+
+      return commit_file(tmp_name, name);
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function called at program exit to finish writing a checkpoint in the
+   // background, since destroying a running thread terminates the program
+   //--------------------------------------------------------------------------
+   void join_writer(){
+      if(!writer.joinable()) return;
+      if(writer.get_id() == std::this_thread::get_id()) writer.detach();
+      else writer.join();
+      return;
+   }
+
+   //--------------------------------------------------------------------------
+   // Function run by background thread to write checkpoint file
+   //--------------------------------------------------------------------------
+   void async_write_file(){
+      vutil::vtimer_t write_timer;
+      write_timer.start();
+      finalize_record(checkpoint::internal::buffer);
+      checkpoint::internal::error = write_file(checkpoint::internal::filename, checkpoint::internal::buffer);
+      write_timer.stop();
+      checkpoint::internal::io_time = write_timer.elapsed_time();
+      return;
+   }
+
+   #ifdef MPICF
+
+   //--------------------------------------------------------------------------
+   // Function to split processes into groups writing collated checkpoint files
+   //--------------------------------------------------------------------------
+   void initialise_groups(){
+
+      if(group_initialised) return;
+
+      const int num_groups = sim::checkpoint_output_nodes;
+      group_id = vmpi::my_rank / ( 1 + (vmpi::num_processors - 1)/num_groups);
+
+      MPI_Comm_split(MPI_COMM_WORLD, group_id, vmpi::my_rank, &group_comm);
+      MPI_Comm_rank(group_comm, &group_rank);
+      MPI_Comm_size(group_comm, &group_size);
+
+      group_initialised = true;
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to start collective write of checkpoint records of all
+   // processes in the group to a collated file. The group master prepends the
+   // group header and index to its record. Records larger than the maximum
+   // size of a single write are written in chunks with blocking writes.
+   //--------------------------------------------------------------------------
+   void start_collated_write(std::vector<char>& record, const bool async){
+
+      finalize_record(record);
+
+      // determine offset of record in file
+      uint64_t record_size = record.size();
+      uint64_t offset = 0;
+      MPI_Exscan(&record_size, &offset, 1, MPI_UINT64_T, MPI_SUM, group_comm);
+      if(group_rank == 0) offset = 0;
+      offset += group_header_size + index_entry_size*group_size;
+
+      // gather index to group master
+      uint64_t entry[3] = {uint64_t(vmpi::my_rank), offset, record_size};
+      std::vector<uint64_t> index(3*group_size, 0);
+      MPI_Gather(entry, 3, MPI_UINT64_T, &index[0], 3, MPI_UINT64_T, 0, group_comm);
+
+      if(group_rank == 0){
+         std::vector<char> prefix(group_header_size + index_entry_size*group_size);
+         std::memcpy(&prefix[0], "VAMPCHKG", 8);
+         write_uint(&prefix[8], version);
+         write_uint(&prefix[16], group_size);
+         std::memcpy(&prefix[group_header_size], &index[0], index_entry_size*group_size);
+         write_uint(&prefix[24], vutil::checksum(&prefix[group_header_size], index_entry_size*group_size));
+         record.insert(record.begin(), prefix.begin(), prefix.end());
+         offset = 0;
+      }
+
+      checkpoint::internal::buffer.swap(record);
+      checkpoint::internal::filename = checkpoint_filename();
+      checkpoint::internal::timer.start();
+
+      const std::string tmp_name = checkpoint::internal::filename + ".tmp";
+      char *cfilename = (char*)tmp_name.c_str();
+      if(MPI_File_open(group_comm, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+         exit_with_error("Unable to open checkpoint file " + tmp_name + " for writing.");
+      }
+
+      // discard any data from an incomplete previous write
+      write_failed = MPI_File_set_size(fh, 0) != MPI_SUCCESS;
+
+      // all processes make the same number of collective writes, and none if
+      // the file could not be truncated on any process
+      uint64_t chunks_and_failed[2] = {(buffer.size() + max_chunk_size - 1)/max_chunk_size, uint64_t(write_failed)};
+      MPI_Allreduce(MPI_IN_PLACE, chunks_and_failed, 2, MPI_UINT64_T, MPI_MAX, group_comm);
+      write_failed = chunks_and_failed[1] != 0;
+      const uint64_t num_chunks = write_failed ? 0 : chunks_and_failed[0];
+      request = MPI_REQUEST_NULL;
+
+      // non-blocking collective writes require MPI 3.1
+      #if MPI_VERSION > 3 || (MPI_VERSION == 3 && MPI_SUBVERSION >= 1)
+         if(async && num_chunks == 1){
+            if(MPI_File_iwrite_at_all(fh, offset, &buffer[0], int(buffer.size()), MPI_BYTE, &request) != MPI_SUCCESS){
+               write_failed = true;
+               request = MPI_REQUEST_NULL;
+            }
+            return;
+         }
+      #endif
+
+      for(uint64_t chunk = 0; chunk < num_chunks; chunk++){
+         const uint64_t start = std::min(chunk*max_chunk_size, uint64_t(buffer.size()));
+         const uint64_t size = std::min(max_chunk_size, uint64_t(buffer.size()) - start);
+         MPI_Status status;
+         if(MPI_File_write_at_all(fh, offset + start, &buffer[0] + start, int(size), MPI_BYTE, &status) != MPI_SUCCESS) write_failed = true;
+      }
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to complete collective write of collated checkpoint file and
+   // replace the previous file. The previous file is only replaced if the
+   // write succeeded on all processes in the group, otherwise the temporary
+   // file is removed and an error is returned on all processes.
+   //--------------------------------------------------------------------------
+   void finish_collated_write(){
+
+      if(request != MPI_REQUEST_NULL){
+         MPI_Status status;
+         if(MPI_Wait(&request, &status) != MPI_SUCCESS) write_failed = true;
+      }
+
+      if(MPI_File_sync(fh) != MPI_SUCCESS) write_failed = true;
+      if(MPI_File_close(&fh) != MPI_SUCCESS) write_failed = true;
+
+      int failed = write_failed ? 1 : 0;
+      MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, group_comm);
+
+      const std::string tmp_name = checkpoint::internal::filename + ".tmp";
+      if(failed != 0){
+         if(group_rank == 0) std::remove(tmp_name.c_str());
+         checkpoint::internal::error = "Unable to write checkpoint file " + tmp_name + " on all processes in the output group.";
+      }
+      else if(group_rank == 0){
+         checkpoint::internal::error = commit_file(tmp_name, checkpoint::internal::filename);
+      }
+
+      checkpoint::internal::timer.stop();
+      checkpoint::internal::io_time = checkpoint::internal::timer.elapsed_time();
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to read checkpoint record of this process from collated file.
+   // Records are read in the same chunks as they are written, and loading
+   // stops with an error if any read fails.
+   //--------------------------------------------------------------------------
+   void read_collated_record(const std::string& chkfilename, std::vector<char>& record){
+
+      char *cfilename = (char*)chkfilename.c_str();
+      if(MPI_File_open(group_comm, cfilename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+         exit_with_error("Unable to open checkpoint file " + chkfilename + " for reading.",
+                         "sim:continue may be specified in the input file which requires a valid checkpoint file.");
+      }
+
+      MPI_Offset file_size;
+      MPI_File_get_size(fh, &file_size);
+
+      // read group header
+      MPI_Status status;
+      char header[group_header_size];
+      std::memset(header, 0, group_header_size);
+      if(MPI_File_read_at_all(fh, 0, header, group_header_size, MPI_BYTE, &status) != MPI_SUCCESS){
+         exit_with_error("Unable to read header of checkpoint file " + chkfilename + ".");
+      }
+
+      const uint64_t num_records = read_uint(header + 16);
+      if(uint64_t(file_size) < group_header_size || std::memcmp(header, "VAMPCHKG", 8) != 0 ||
+         num_records > (uint64_t(file_size) - group_header_size)/index_entry_size){
+         exit_with_error("File " + chkfilename + " is not a valid collated checkpoint file.");
+      }
+      if(read_uint(header + 8) > version){
+         exit_with_error("Checkpoint file " + chkfilename + " was written by a newer version of vampire.");
+      }
+
+      // read and check index
+      std::vector<uint64_t> index(3*num_records+1, 0);
+      if(MPI_File_read_at_all(fh, group_header_size, &index[0], int(index_entry_size*num_records), MPI_BYTE, &status) != MPI_SUCCESS){
+         exit_with_error("Unable to read index of checkpoint file " + chkfilename + ".");
+      }
+      if(num_records == 0 || vutil::checksum(reinterpret_cast<const char*>(&index[0]), index_entry_size*num_records) != read_uint(header + 24)){
+         exit_with_error("Index of checkpoint file " + chkfilename + " is corrupted (checksum mismatch).");
+      }
+
+      // find record of this process
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      bool found = false;
+      for(uint64_t r = 0; r < num_records; r++){
+         if(index[3*r] == uint64_t(vmpi::my_rank)){
+            offset = index[3*r+1];
+            size = index[3*r+2];
+            found = true;
+         }
+      }
+      const bool valid = found && offset <= uint64_t(file_size) && size <= uint64_t(file_size) - offset;
+      if(!valid) size = 0;
+
+      // all processes make the same number of collective reads
+      uint64_t num_chunks = (size + max_chunk_size - 1)/max_chunk_size;
+      MPI_Allreduce(MPI_IN_PLACE, &num_chunks, 1, MPI_UINT64_T, MPI_MAX, group_comm);
+
+      record.resize(size+1);
+      bool read_failed = false;
+      for(uint64_t chunk = 0; chunk < num_chunks; chunk++){
+         const uint64_t start = std::min(chunk*max_chunk_size, size);
+         const uint64_t chunk_size = std::min(max_chunk_size, size - start);
+         if(MPI_File_read_at_all(fh, offset + start, &record[0] + start, int(chunk_size), MPI_BYTE, &status) != MPI_SUCCESS) read_failed = true;
+      }
+      record.resize(size);
+      MPI_File_close(&fh);
+
+      if(!valid){
+         std::stringstream message;
+         message << "Checkpoint file " << chkfilename << " does not contain a valid checkpoint for process " << vmpi::my_rank << ".";
+         exit_with_error(message.str(), "The number of processes and sim:checkpoint-output-nodes must be the same as when the checkpoint was saved.");
+      }
+      if(read_failed){
+         exit_with_error("Unable to read checkpoint record from file " + chkfilename + ".");
+      }
+
+      return;
+
+   }
+
+   #endif
+
+   //--------------------------------------------------------------------------
+   // Function to read checkpoint file into memory
+   //--------------------------------------------------------------------------
+   void read_file(const std::string& chkfilename, std::vector<char>& record){
+
+      std::ifstream chkfile;
+      chkfile.open(chkfilename.c_str(), std::ios::binary | std::ios::ate);
+
+      // check for open file
+      if(!chkfile.is_open()){
+         exit_with_error("Unable to open checkpoint file " + chkfilename + " for reading.",
+                         "sim:continue may be specified in the input file which requires a valid checkpoint file.");
+      }
+
+      const std::streamoff size = chkfile.tellg();
+      chkfile.seekg(0, std::ios::beg);
+      record.resize(size);
+      if(size > 0) chkfile.read(&record[0], size);
+      if(!chkfile.good()) exit_with_error("Unable to read checkpoint file " + chkfilename + ".");
+
+      chkfile.close();
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to check header and checksum of checkpoint record, exiting if
+   // the record is incomplete or corrupted
+   //--------------------------------------------------------------------------
+   void verify_record(const std::string& chkfilename, const std::vector<char>& record){
+
+      const std::string info = "Previous checkpoint generations are kept as " + chkfilename + ".1 etc if sim:checkpoint-generations is set, and may be renamed to " + chkfilename + " to continue.";
+
+      if(record.size() < header_size || vutil::checksum(&record[0], 48) != read_uint(&record[48])){
+         exit_with_error("Header of checkpoint file " + chkfilename + " is corrupted (checksum mismatch).", info);
+      }
+      if(read_uint(&record[8]) > version){
+         exit_with_error("Checkpoint file " + chkfilename + " was written by a newer version of vampire.");
+      }
+      if(read_uint(&record[16]) != uint64_t(vmpi::my_rank) || read_uint(&record[24]) != uint64_t(vmpi::num_processors)){
+         std::stringstream message;
+         message << "Checkpoint file " << chkfilename << " was written by process " << read_uint(&record[16]) << " of " << read_uint(&record[24]) <<
+                    " and cannot be loaded by process " << vmpi::my_rank << " of " << vmpi::num_processors << ".";
+         exit_with_error(message.str());
+      }
+      if(read_uint(&record[32]) != record.size() - header_size){
+         exit_with_error("Checkpoint file " + chkfilename + " is incomplete.", info);
+      }
+      if(vutil::checksum(&record[header_size], record.size() - header_size) != read_uint(&record[40])){
+         exit_with_error("Checkpoint file " + chkfilename + " is corrupted (checksum mismatch).", info);
+      }
+
+      return;
+
+   }
+
+} // end of namespace internal
+} // end of namespace checkpoint
+
+//-----------------------------------------------------------------------------
+// Function to save checkpoint file
+//
+// The state of the simulation is copied to a buffer and written to a
+// temporary file which replaces the checkpoint file once complete. For
+// asynchronous checkpoints the file is written in the background while the
+// simulation continues.
+//-----------------------------------------------------------------------------
+void save_checkpoint(){
+
+   using namespace checkpoint::internal;
+
+   // wait for previous checkpoint to be written
+   wait_for_checkpoint();
+
+   vutil::vtimer_t save_timer;
+   save_timer.start();
+
+   // copy state of simulation
+   std::vector<char> record;
+   pack_checkpoint(record);
+
+   #ifdef MPICF
+      // write collated checkpoint files with MPI-IO
+      if(sim::checkpoint_output_nodes > 0){
+         initialise_groups();
+         start_collated_write(record, sim::asynchronous_checkpoint_flag);
+         if(request != MPI_REQUEST_NULL){
+            in_flight = true;
+            collated_in_flight = true;
+            save_timer.stop();
+            zlog << zTs() << "Checkpoint copied for writing in the background [ " << save_timer.elapsed_time() << " s]" << std::endl;
+            return;
+         }
+         finish_collated_write();
+         if(error.size() > 0) exit_with_error(error);
+         save_timer.stop();
+         zlog << zTs() << "Checkpoint file " << filename << " written to disk [ " << save_timer.elapsed_time() << " s]" << std::endl;
+         return;
+      }
+   #endif
+
+   // write checkpoint in background from copy
+   if(sim::asynchronous_checkpoint_flag){
+      buffer.swap(record);
+      filename = checkpoint_filename();
+      in_flight = true;
+      collated_in_flight = false;
+      // ensure background writer is joined if the program exits early
+      static bool exit_hook_registered = false;
+      if(!exit_hook_registered) exit_hook_registered = (std::atexit(join_writer) == 0);
+      writer = std::thread(async_write_file);
+      save_timer.stop();
+      zlog << zTs() << "Checkpoint copied for writing in the background [ " << save_timer.elapsed_time() << " s]" << std::endl;
+      return;
+   }
+
+   finalize_record(record);
+   const std::string chkfilename = checkpoint_filename();
+   const std::string write_error = write_file(chkfilename, record);
+   if(write_error.size() > 0) exit_with_error(write_error);
 
    // log writing checkpoint file
-   zlog << zTs() << "Checkpoint file written to disk." << std::endl;
+   save_timer.stop();
+   zlog << zTs() << "Checkpoint file " << chkfilename << " written to disk [ " << save_timer.elapsed_time() << " s]" << std::endl;
 
    return;
 
 }
 
 //-----------------------------------------------------------------------------
-// Function to save checkpoint file
+// Function to wait for checkpoint file written in the background. Blocks only
+// if the file is still being written.
+//-----------------------------------------------------------------------------
+void wait_for_checkpoint(){
+
+   using namespace checkpoint::internal;
+
+   if(!in_flight) return;
+
+   vutil::vtimer_t wait_timer;
+   wait_timer.start();
+
+   #ifdef MPICF
+      if(collated_in_flight) finish_collated_write();
+      else writer.join();
+   #else
+      writer.join();
+   #endif
+
+   in_flight = false;
+   collated_in_flight = false;
+
+   if(error.size() > 0) exit_with_error(error);
+
+   wait_timer.stop();
+   zlog << zTs() << "Checkpoint file " << filename << " written asynchronously [ " << io_time << " s, waited " << wait_timer.elapsed_time() << " s]" << std::endl;
+
+   // release memory of snapshot
+   std::vector<char>().swap(buffer);
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to load checkpoint file
 //-----------------------------------------------------------------------------
 void load_checkpoint(){
 
+   using namespace checkpoint::internal;
+
    // convert number of atoms, rank and time to standard long int
-   uint64_t natoms64;
-   int64_t time64;
-   int64_t eqtime64;
-   int64_t parity64;
-   int64_t iH64;
-   double temp;
-   int64_t output_atoms_file_counter64;
-   int64_t output_cells_file_counter64;
-   int64_t output_rate_counter64;
-   double constr_theta;
-   double constr_phi;
-   bool flag_constraint_theta_changed;
-   bool flag_constraint_phi_changed  ;
+   uint64_t natoms64 = 0;
+   int64_t time64 = 0;
+   int64_t eqtime64 = 0;
+   int64_t parity64 = 0;
+   int64_t iH64 = 0;
+   double temp = 0.0;
+   int64_t output_atoms_file_counter64 = 0;
+   int64_t output_cells_file_counter64 = 0;
+   int64_t output_rate_counter64 = 0;
+   double constr_theta = 0.0;
+   double constr_phi = 0.0;
+   bool flag_constraint_theta_changed = false;
+   bool flag_constraint_phi_changed = false;
 
    // variables for loading state of random number generator
    std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
    int32_t mt_p=0; // position in rng state
 
-   // determine checkpoint file name
-   std::stringstream chkfilenamess;
-   chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
-   std::string chkfilename = chkfilenamess.str();
+   // read checkpoint record
+   std::vector<char> record;
+   #ifdef MPICF
+      if(sim::checkpoint_output_nodes > 0) initialise_groups();
+   #endif
+   const std::string chkfilename = checkpoint_filename();
+   #ifdef MPICF
+      if(sim::checkpoint_output_nodes > 0) read_collated_record(chkfilename, record);
+      else read_file(chkfilename, record);
+   #else
+      read_file(chkfilename, record);
+   #endif
 
-   // open checkpoint file
-   std::ifstream chkfile;
-   chkfile.open(chkfilename.c_str(),std::ios::binary);
-
-   // check for open file
-   if(!chkfile.is_open()){
-      terminaltextcolor(RED);
-      std::cerr << "Error: Unable to open checkpoint file " << chkfilename << " for reading. Exiting." << std::endl;
-      std::cerr << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
-      terminaltextcolor(WHITE);
-      zlog << zTs() << "Error: Unable to open checkpoint file " << chkfilename << " for reading. Exiting." << std::endl;
-      zlog << zTs() << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
-      err::vexit();
+   // check integrity of data
+   uint64_t position = 0;
+   if(record.size() >= 8 && std::memcmp(&record[0], "VAMPCHKP", 8) == 0){
+      verify_record(chkfilename, record);
+      position = header_size;
+   }
+   else{
+      zlog << zTs() << "Warning: Checkpoint file " << chkfilename << " has no header and checksum (written by an earlier version of vampire). Integrity of data cannot be checked." << std::endl;
    }
 
    // Set flag to true do determine that this is the beginning of the simulation
    sim::checkpoint_loaded_flag=true;
    zlog << zTs() << "Flag:checkpoint_loaded_flag = " << sim::checkpoint_loaded_flag <<std::endl;
 
-   // read checkpoint variables from file
-   chkfile.read((char*)&natoms64,sizeof(uint64_t));
-   chkfile.read((char*)&time64,sizeof(int64_t));
-   chkfile.read((char*)&eqtime64,sizeof(int64_t));
-   chkfile.read((char*)&parity64,sizeof(int64_t));
-   chkfile.read((char*)&iH64,sizeof(int64_t));
-   chkfile.read((char*)&temp,sizeof(double));
-   chkfile.read((char*)&constr_theta,sizeof(double));
-   chkfile.read((char*)&constr_phi,sizeof(double));
-   chkfile.read((char*)&flag_constraint_theta_changed,sizeof(bool));
-   chkfile.read((char*)&flag_constraint_phi_changed  ,sizeof(bool));
-   chkfile.read((char*)&output_atoms_file_counter64,sizeof(int64_t));
-   chkfile.read((char*)&output_cells_file_counter64,sizeof(int64_t));
-   chkfile.read((char*)&output_rate_counter64,sizeof(int64_t));
-   chkfile.read((char*)&mt_p,sizeof(int32_t));
-   chkfile.read((char*)&mt_state[0],sizeof(uint32_t)*mt_state.size());
+   // read checkpoint variables
+   bool ok = true;
+   ok = ok && unpack(record, position, natoms64);
+   ok = ok && unpack(record, position, time64);
+   ok = ok && unpack(record, position, eqtime64);
+   ok = ok && unpack(record, position, parity64);
+   ok = ok && unpack(record, position, iH64);
+   ok = ok && unpack(record, position, temp);
+   ok = ok && unpack(record, position, constr_theta);
+   ok = ok && unpack(record, position, constr_phi);
+   ok = ok && unpack(record, position, flag_constraint_theta_changed);
+   ok = ok && unpack(record, position, flag_constraint_phi_changed  );
+   ok = ok && unpack(record, position, output_atoms_file_counter64);
+   ok = ok && unpack(record, position, output_cells_file_counter64);
+   ok = ok && unpack(record, position, output_rate_counter64);
+   ok = ok && unpack(record, position, mt_p);
+   ok = ok && unpack(record, position, &mt_state[0], mt_state.size());
+
+   // negative rng position indicates saved state of counter based generator
+   uint64_t counter64 = 0;
+   if(ok && mt_p < 0){
+      mt_p = -mt_p-1;
+      ok = unpack(record, position, counter64);
+   }
+
+   if(!ok) exit_with_error("Checkpoint file " + chkfilename + " is incomplete.");
 
    //std::cout << "random generator state loaded = " << mt_p << std::endl;
    // if continuing set state of rng
-   if(sim::load_checkpoint_continue_flag) mtrandom::grnd.set_state(mt_state, mt_p);
+   if(sim::load_checkpoint_continue_flag){
+      mtrandom::grnd.set_state(mt_state, mt_p);
+      mtrandom::counter = counter64;
+   }
 
    // check for rational number of atoms
    if(static_cast<uint64_t>(atoms::num_atoms-vmpi::num_halo_atoms) != natoms64){
@@ -175,6 +827,11 @@ void load_checkpoint(){
       err::vexit();
    }
 
+   // check spin data are complete before changing any state
+   if(record.size() - position != 3*sizeof(double)*natoms64){
+      exit_with_error("Checkpoint file " + chkfilename + " is incomplete.");
+   }
+
    // Load saved parameters if simulation continuing
    if(sim::load_checkpoint_continue_flag){
       sim::parity = parity64;
@@ -192,12 +849,20 @@ void load_checkpoint(){
    }
 
    // Load spin positions
-   chkfile.read((char*)&atoms::x_spin_array[0],sizeof(double)*natoms64);
-   chkfile.read((char*)&atoms::y_spin_array[0],sizeof(double)*natoms64);
-   chkfile.read((char*)&atoms::z_spin_array[0],sizeof(double)*natoms64);
-
-   // close checkpoint file
-   chkfile.close();
+   if(create::renumbered_atom_array.size() == natoms64){
+      // atoms have been renumbered, so read spins from generation order
+      std::vector<double>* spin_arrays[3] = {&atoms::x_spin_array, &atoms::y_spin_array, &atoms::z_spin_array};
+      std::vector<double> spin_buffer(natoms64);
+      for(int i=0; i<3; i++){
+         unpack(record, position, &spin_buffer[0], natoms64);
+         for(uint64_t atom=0; atom<natoms64; atom++) (*spin_arrays[i])[create::renumbered_atom_array[atom]] = spin_buffer[atom];
+      }
+   }
+   else{
+      unpack(record, position, &atoms::x_spin_array[0], natoms64);
+      unpack(record, position, &atoms::y_spin_array[0], natoms64);
+      unpack(record, position, &atoms::z_spin_array[0], natoms64);
+   }
 
    // log reading checkpoint file
    zlog << zTs() << "Checkpoint file loaded at sim::time " << sim::time << "." << std::endl;
@@ -63,6 +63,10 @@
 //Function prototypes
 int calculate_spin_fields(const int,const int);
 int calculate_external_fields(const int,const int);
+int calculate_exchange_spin_fields(const int,const int);
+int calculate_non_exchange_spin_fields(const int,const int);
+void set_reusable_spin_fields();
+bool external_fields_are_current();
 
 /// @namespace stats
 /// @brief Variables and functions for calculation of system statistics.
@@ -104,8 +108,7 @@ namespace stats
 	double torque_data_counter=0.0;
 
 	// function prototypes
-	void system_torque();
-	void system_energy();
+	void field_statistics();
 
 	bool is_initialised=false;
 
@@ -176,11 +179,8 @@ int mag_m(){
    // update statistics - need to eventually replace mag_m() with stats::update()...
    stats::update(atoms::x_spin_array, atoms::y_spin_array, atoms::z_spin_array, atoms::m_spin_array);
 
-   // optionally calculate system torque
-   if(stats::calculate_torque==true) stats::system_torque();
-
-   // optionally calculate energy
-   if(stats::calculate_energy==true) stats::system_energy();
+   // optionally calculate system torque and energy
+   if(stats::calculate_torque==true || stats::calculate_energy==true) stats::field_statistics();
 
    // increment data counter
    stats::data_counter+=1.0;
@@ -263,6 +263,9 @@ double max_torque(){
 	calculate_spin_fields(0,num_atoms);
 	calculate_external_fields(0,num_atoms);
 
+	// spin fields can be reused by next time step if calculated for all atoms
+	if(num_atoms==atoms::num_atoms) set_reusable_spin_fields();
+
 	for(int atom=0;atom<num_atoms;atom++){
 
 		// Store local spin in Sand local field in H
@@ -292,22 +295,56 @@ double max_torque(){
 
 }
 
+///---------------------------------------------------------------------------
 ///
-/// @brief      Calculates the torque on the system
-///
-/// Calculates the instantaneous value of the system torque T = sum (Si x Hi)
+///          Function to calculate system torque and energy
 ///
-/// @return     void
+///   Calculates the instantaneous value of the system torque T = sum (Si x Hi)
+///   and the exchange, anisotropy, applied field and magnetostatic energies
+///   in a single pass over atoms. The spin fields are calculated once, with
+///   the exchange energy taken from the exchange field before other spin
+///   dependent fields are added, and can be reused by the first pass of the
+///   next integrator time step. The external fields calculated by the
+///   integrator in the last time step are used for the torque if available.
 ///
-void system_torque(){
+///---------------------------------------------------------------------------
+void field_statistics(){
+
+	const bool torque_stats = stats::calculate_torque;
+	const bool energy_stats = stats::calculate_energy;
+
+	//---------------------------------------------------------------
+	// Calculate exchange fields and exchange energy E = -1/2 sum Si.Hi
+	//---------------------------------------------------------------
+	calculate_exchange_spin_fields(0,atoms::num_atoms);
+
+	double exchange_energy = 0.0;
+
+	if(energy_stats){
+		for(int atom = 0; atom < stats::num_atoms; atom++){
+			const int imaterial = atoms::type_array[atom];
+			exchange_energy -= (atoms::x_spin_array[atom]*atoms::x_total_spin_field_array[atom] +
+			                    atoms::y_spin_array[atom]*atoms::y_total_spin_field_array[atom] +
+			                    atoms::z_spin_array[atom]*atoms::z_total_spin_field_array[atom]) * mp::material[imaterial].mu_s_SI;
+		}
+	}
+
+	// complete spin fields
+	calculate_non_exchange_spin_fields(0,atoms::num_atoms);
+	set_reusable_spin_fields();
 
-	// parallel version, multiple materials, initialisation
+	// use external fields from last time step if available to avoid drawing new thermal fields
+	if(torque_stats && !external_fields_are_current()) calculate_external_fields(0,atoms::num_atoms);
 
+	//---------------------------------------------------------------
+	// Calculate torque and single spin energies in a single pass
+	//---------------------------------------------------------------
 	double torque[3]={0.0,0.0,0.0};
+	double anisotropy_energy = 0.0;
+	double applied_field_energy = 0.0;
+	double magnetostatic_energy = 0.0;
 
-	// calculate net fields
-	calculate_spin_fields(0,atoms::num_atoms);
-	calculate_external_fields(0,atoms::num_atoms);
+	const double temperature = sim::temperature;
 
 	for(int atom=0;atom<stats::num_atoms;atom++){
 
@@ -315,153 +352,105 @@ void system_torque(){
 		const int imat=atoms::type_array[atom];
 		const double mu = mp::material[imat].mu_s_SI;
 
-		// Store local spin in Sand local field in H
-		const double S[3] = {atoms::x_spin_array[atom]*mu,atoms::y_spin_array[atom]*mu,atoms::z_spin_array[atom]*mu};
-		const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
-									atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
-									atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
-
-		torque[0] += S[1]*H[2]-S[2]*H[1];
-		torque[1] += S[2]*H[0]-S[0]*H[2];
-		torque[2] += S[0]*H[1]-S[1]*H[0];
-
-		stats::sublattice_mean_torque_x_array[imat]+=S[1]*H[2]-S[2]*H[1];
-		stats::sublattice_mean_torque_y_array[imat]+=S[2]*H[0]-S[0]*H[2];
-		stats::sublattice_mean_torque_z_array[imat]+=S[0]*H[1]-S[1]*H[0];
-	}
-
-	// reduce torque on all nodes
-	#ifdef MPICF
-		MPI_Allreduce(MPI_IN_PLACE,&torque[0],3,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-		MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_x_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-		MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_y_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-		MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_z_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-	#endif
+		const double sx = atoms::x_spin_array[atom];
+		const double sy = atoms::y_spin_array[atom];
+		const double sz = atoms::z_spin_array[atom];
 
-	// Set stats values
-	stats::total_system_torque[0]=torque[0];
-	stats::total_system_torque[1]=torque[1];
-	stats::total_system_torque[2]=torque[2];
+		if(torque_stats){
 
-	stats::total_mean_system_torque[0]+=torque[0];
-	stats::total_mean_system_torque[1]+=torque[1];
-	stats::total_mean_system_torque[2]+=torque[2];
+			// Store local spin in Sand local field in H
+			const double S[3] = {sx*mu,sy*mu,sz*mu};
+			const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
+										atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
+										atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
 
-	stats::torque_data_counter+=1.0;
-	return;
+			torque[0] += S[1]*H[2]-S[2]*H[1];
+			torque[1] += S[2]*H[0]-S[0]*H[2];
+			torque[2] += S[0]*H[1]-S[1]*H[0];
 
-}
+			stats::sublattice_mean_torque_x_array[imat]+=S[1]*H[2]-S[2]*H[1];
+			stats::sublattice_mean_torque_y_array[imat]+=S[2]*H[0]-S[0]*H[2];
+			stats::sublattice_mean_torque_z_array[imat]+=S[0]*H[1]-S[1]*H[0];
 
-///---------------------------------------------------------------------------
-///
-///                     Function to calculate system energy
-///
-///        Wraps the single spin energy functions used for MC calculation
-///
-///---------------------------------------------------------------------------
-void system_energy(){
-
-   // Reinitialise stats values
-   stats::total_energy=0.0;
-   stats::total_exchange_energy=0.0;
-   stats::total_anisotropy_energy=0.0;
-   stats::total_applied_field_energy=0.0;
-   stats::total_magnetostatic_energy=0.0;
+		}
 
-   //------------------------------
-   // Calculate exchange energy
-   //------------------------------
-   {
-      double energy = 0.0;
+		if(energy_stats){
+			anisotropy_energy    += anisotropy::single_spin_energy(atom, imat, sx, sy, sz, temperature) * mu;
+			applied_field_energy += sim::spin_applied_field_energy(sx, sy, sz) * mu;
+			magnetostatic_energy += sim::spin_magnetostatic_energy(atom, sx, sy, sz) * mu;
+		}
 
-      for(int atom = 0; atom < stats::num_atoms; atom++){
+	}
 
-         double sx = atoms::x_spin_array[atom];
-         double sy = atoms::y_spin_array[atom];
-         double sz = atoms::z_spin_array[atom];
-         const int imaterial = atoms::type_array[atom];
+	if(torque_stats){
 
-         energy += exchange::single_spin_energy(atom, sx, sy, sz) * mp::material[imaterial].mu_s_SI;
+		// reduce torque on all nodes
+		#ifdef MPICF
+			MPI_Allreduce(MPI_IN_PLACE,&torque[0],3,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+			MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_x_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+			MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_y_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+			MPI_Allreduce(MPI_IN_PLACE,&stats::sublattice_mean_torque_z_array[0],mp::num_materials,MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+		#endif
 
-      }
+		// Set stats values
+		stats::total_system_torque[0]=torque[0];
+		stats::total_system_torque[1]=torque[1];
+		stats::total_system_torque[2]=torque[2];
 
-      // save total energy accounting for factor 1/2 in double summation
-      stats::total_exchange_energy = 0.5*energy;
+		stats::total_mean_system_torque[0]+=torque[0];
+		stats::total_mean_system_torque[1]+=torque[1];
+		stats::total_mean_system_torque[2]+=torque[2];
 
-   }
-   //------------------------------
-   // Calculate anisotropy energy
-   //------------------------------
-   {
-      double energy=0.0;
-      const double temperature = sim::temperature;
-      for(int atom=0; atom<stats::num_atoms; atom++){
-         double sx=atoms::x_spin_array[atom];
-         double sy=atoms::y_spin_array[atom];
-         double sz=atoms::z_spin_array[atom];
-         const int imaterial=atoms::type_array[atom];
-         energy +=  anisotropy::single_spin_energy(atom, imaterial, sx, sy, sz, temperature) * mp::material[imaterial].mu_s_SI;
-      }
-      stats::total_anisotropy_energy += energy;
-   }
+		stats::torque_data_counter+=1.0;
 
-   {
-      double energy=0.0;
-      for(int atom=0; atom<stats::num_atoms; atom++){
-         const double Sx=atoms::x_spin_array[atom];
-         const double Sy=atoms::y_spin_array[atom];
-         const double Sz=atoms::z_spin_array[atom];
-         const int imaterial=atoms::type_array[atom];
-         energy+=sim::spin_applied_field_energy(Sx, Sy, Sz) * mp::material[imaterial].mu_s_SI;
-      }
-      stats::total_applied_field_energy=energy;
-   }
-   {
-      double energy=0.0;
-      for(int atom=0; atom<stats::num_atoms; atom++){
-         const double Sx=atoms::x_spin_array[atom];
-         const double Sy=atoms::y_spin_array[atom];
-         const double Sz=atoms::z_spin_array[atom];
-         const int imaterial=atoms::type_array[atom];
-         energy+=sim::spin_magnetostatic_energy(atom, Sx, Sy, Sz) * mp::material[imaterial].mu_s_SI;
-      }
-      stats::total_magnetostatic_energy=0.5*energy;
-   }
+	}
 
-   // Calculate total energy
-   stats::total_energy = stats::total_exchange_energy +
-                         stats::total_anisotropy_energy +
-                         stats::total_applied_field_energy +
-                         stats::total_magnetostatic_energy;
+	if(energy_stats){
+
+		// save total energies accounting for factor 1/2 in double summation
+		stats::total_exchange_energy      = 0.5*exchange_energy;
+		stats::total_anisotropy_energy    = anisotropy_energy;
+		stats::total_applied_field_energy = applied_field_energy;
+		stats::total_magnetostatic_energy = 0.5*magnetostatic_energy;
+
+		// Calculate total energy
+		stats::total_energy = stats::total_exchange_energy +
+		                      stats::total_anisotropy_energy +
+		                      stats::total_applied_field_energy +
+		                      stats::total_magnetostatic_energy;
+
+		// reduce energies to root node
+		#ifdef MPICF
+			// MPI_IN_PLACE is only valid on root process for MPI_Reduce()
+			// MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm)
+			if(vmpi::my_rank==0){
+				MPI_Reduce(MPI_IN_PLACE, &stats::total_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(MPI_IN_PLACE, &stats::total_exchange_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(MPI_IN_PLACE, &stats::total_anisotropy_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(MPI_IN_PLACE, &stats::total_applied_field_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(MPI_IN_PLACE, &stats::total_magnetostatic_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+			}
+			else{
+				MPI_Reduce(&stats::total_energy, &stats::total_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(&stats::total_exchange_energy, &stats::total_exchange_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(&stats::total_anisotropy_energy, &stats::total_anisotropy_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(&stats::total_applied_field_energy, &stats::total_applied_field_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+				MPI_Reduce(&stats::total_magnetostatic_energy, &stats::total_magnetostatic_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+			}
+		#endif
+
+		// Add calculated values to mean
+		stats::mean_total_energy                    += stats::total_energy;
+		stats::mean_total_exchange_energy           += stats::total_exchange_energy;
+		stats::mean_total_anisotropy_energy         += stats::total_anisotropy_energy;
+		stats::mean_total_applied_field_energy      += stats::total_applied_field_energy;
+		stats::mean_total_magnetostatic_energy      += stats::total_magnetostatic_energy;
+
+		stats::energy_data_counter+=1.0;
 
-   // reduce energies to root node
-   #ifdef MPICF
-      // MPI_IN_PLACE is only valid on root process for MPI_Reduce()
-      // MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm)
-      if(vmpi::my_rank==0){
-         MPI_Reduce(MPI_IN_PLACE, &stats::total_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(MPI_IN_PLACE, &stats::total_exchange_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(MPI_IN_PLACE, &stats::total_anisotropy_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(MPI_IN_PLACE, &stats::total_applied_field_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(MPI_IN_PLACE, &stats::total_magnetostatic_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-      }
-      else{
-         MPI_Reduce(&stats::total_energy, &stats::total_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(&stats::total_exchange_energy, &stats::total_exchange_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(&stats::total_anisotropy_energy, &stats::total_anisotropy_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(&stats::total_applied_field_energy, &stats::total_applied_field_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-         MPI_Reduce(&stats::total_magnetostatic_energy, &stats::total_magnetostatic_energy, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-      }
-   #endif
-
-   // Add calculated values to mean
-   stats::mean_total_energy                    += stats::total_energy;
-   stats::mean_total_exchange_energy           += stats::total_exchange_energy;
-   stats::mean_total_anisotropy_energy         += stats::total_anisotropy_energy;
-   stats::mean_total_applied_field_energy      += stats::total_applied_field_energy;
-   stats::mean_total_magnetostatic_energy      += stats::total_magnetostatic_energy;
+	}
 
-   stats::energy_data_counter+=1.0;
+	return;
 
 }
 
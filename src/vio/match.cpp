@@ -26,6 +26,7 @@
 #include "grains.hpp"
 #include "stats.hpp"
 #include "units.hpp"
+#include "vomp.hpp"
 #include "config.hpp"
 #include "demag.hpp"
 #include "cells.hpp"
@@ -78,6 +79,7 @@ namespace vin{
         else if(st::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(unitcell::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
         else if(vio::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
+        else if(vomp::match_input_parameter(key, word, value, unit, line)) return EXIT_SUCCESS;
 
         //===================================================================
         // Test for create variables
@@ -764,6 +766,11 @@ namespace vin{
                 sim::program=51;
                 return EXIT_SUCCESS;
             }
+            test="diagnostic-random-numbers";
+            if(value==test){
+                sim::program=52;
+                return EXIT_SUCCESS;
+            }
             else{
             terminaltextcolor(RED);
                 std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
@@ -1123,14 +1130,60 @@ namespace vin{
             }
         }
         //--------------------------------------------------------------------
+        test="mpi-load-balancing";
+        if(word==test){
+            vmpi::load_balancing=true;
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
+        test="mpi-load-balancing-atom-weight";
+        if(word==test){
+            double aw=atof(value.c_str());
+            check_for_valid_value(aw, word, line, prefix, unit, "none", 0.0, 1000.0,"input","0.0 - 1000.0");
+            vmpi::load_balancing_atom_weight=aw;
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
+        test="mpi-load-balancing-timings-file";
+        if(word==test){
+            std::string timings_file=value;
+            // strip quotes
+            timings_file.erase(remove(timings_file.begin(), timings_file.end(), '\"'), timings_file.end());
+            test="";
+            if(timings_file!=test){
+                vmpi::load_balancing_timings_file=timings_file;
+                return EXIT_SUCCESS;
+            }
+            else{
+                terminaltextcolor(RED);
+                std::cerr << "Error - empty filename in control statement \'sim:" << word << "\' on line " << line << " of input file" << std::endl;
+                terminaltextcolor(WHITE);
+                return EXIT_FAILURE;
+            }
+        }
+        //--------------------------------------------------------------------
         test="mpi-ppn";
         if(word==test){
+            // determine processors per node from shared memory nodes
+            test="auto";
+            if(value==test){
+                vmpi::ppn=0;
+                return EXIT_SUCCESS;
+            }
             int ppn=atoi(value.c_str());
             check_for_valid_int(ppn, word, line, prefix, 1, 1024,"input","1 - 1024");
             vmpi::ppn=ppn;
             return EXIT_SUCCESS;
         }
         //--------------------------------------------------------------------
+        test="mpi-core-atom-chunks";
+        if(word==test){
+            int nc=atoi(value.c_str());
+            check_for_valid_int(nc, word, line, prefix, 1, 1000,"input","1 - 1000");
+            vmpi::num_core_atom_chunks=nc;
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
         test="integrator-random-seed";
         if(word==test){
             int is=atoi(value.c_str());
@@ -1139,6 +1192,28 @@ namespace vin{
             return EXIT_SUCCESS;
         }
         //--------------------------------------------------------------------
+        test="random-number-generator";
+        if(word==test){
+            test="mersenne-twister";
+            if(value==test){
+                mtrandom::counter_based=false;
+                return EXIT_SUCCESS;
+            }
+            test="philox";
+            if(value==test){
+                mtrandom::counter_based=true;
+                return EXIT_SUCCESS;
+            }
+            else{
+            terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"mersenne-twister\"" << std::endl;
+                std::cerr << "\t\"philox\"" << std::endl;
+            terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
+        //--------------------------------------------------------------------
         test="constraint-rotation-update";
         if(word==test){
             sim::constraint_rotation=true;
@@ -1276,6 +1351,33 @@ namespace vin{
             sim::save_checkpoint_rate=scr;
             return EXIT_SUCCESS;
         }
+        //--------------------------------------------------------------------
+        test="checkpoint-generations";
+        if(word==test){
+            int g=atoi(value.c_str());
+            check_for_valid_int(g, word, line, prefix, 1, 1000,"input","1 - 1,000");
+            sim::checkpoint_generations=g;
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
+        test="asynchronous-checkpoint";
+        if(word==test){
+            sim::asynchronous_checkpoint_flag=true;
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
+        test="checkpoint-output-nodes";
+        if(word==test){
+            int n=atoi(value.c_str());
+            check_for_valid_int(n, word, line, prefix, 1, 1000000,"input","1 - 1,000,000");
+            if(n > vmpi::num_processors){
+                zlog << zTs() << "Warning: Number of checkpoint output nodes set to " << n << " which is greater than the number of processors (" <<
+                vmpi::num_processors << ") used in this simulation. Setting checkpoint-output-nodes to " << vmpi::num_processors << "." << std::endl;
+                n = vmpi::num_processors;
+            }
+            sim::checkpoint_output_nodes=n;
+            return EXIT_SUCCESS;
+        }
         //-------------------------------------------------------------------
         test="load-checkpoint";
         if(word==test){
@@ -0,0 +1,138 @@
+#!/bin/bash
+
+# terminal output colors
+readonly green='\033[0;32m'
+readonly red='\033[0;31m'
+readonly nc='\033[0m'
+
+function help_message {
+    echo "Script to test encoded, delta encoded and container spin configuration"
+    echo "output of VAMPIRE and their conversion with the vampire data converter."
+    echo "Run from the root directory of the repository after building vampire"
+    echo "and vdc."
+    echo
+    echo "Options:"
+    echo " --help (-h): Prints this message."
+    echo
+    echo " --vampire (-v): Path to vampire executable [default ./vampire-serial]."
+    echo
+    echo " --vdc (-c): Path to vdc executable [default ./util/vdc/vdc]."
+}
+
+function cleanup {
+    rm -rf "$workdir"
+}
+
+function is_within_tolerance {
+    if awk -v error=$1 -v tolerance=$2 'BEGIN { exit !(error <= tolerance) }'; then
+        echo -e "${green}passed${nc} (maximum error $1, bound $2)"
+    else
+        echo -e "${red}failed${nc} (maximum error $1, bound $2)"
+        failed=1
+    fi
+}
+
+# runs vampire in directory $1 and converts the spin data to vtk files
+function run_and_convert {
+    (cd $1 && "$vampire" &>/dev/null && "$vdc" --vtk &>vdc.log)
+}
+
+function encoded_output {
+    echo -n "Testing encoded spin output.............."
+
+    # reference run without encoding or container from the same input
+    mkdir $workdir/reference $workdir/encoded
+    grep -v "config:spin-\|config:output-container" $dir/input > $workdir/reference/input
+    cp $dir/input $workdir/encoded/input
+    cp $dir/Co.mat $workdir/reference/Co.mat
+    cp $dir/Co.mat $workdir/encoded/Co.mat
+
+    if ! run_and_convert $workdir/reference || ! run_and_convert $workdir/encoded; then
+        echo -e "${red}failed${nc} (vampire or vdc exited with an error)"
+        failed=1
+        return
+    fi
+
+    # maximum angular error of encoding reported in log file
+    bound=$(grep -o "maximum angular error [^ ]*" $workdir/encoded/log | awk '{print $4}')
+
+    $dir/spin_errors.py $workdir/reference $workdir/encoded > $workdir/encoded_errors.dat
+    num_snapshots=$(grep "# number of snapshots = " $workdir/encoded_errors.dat | awk '{print $6}')
+    max_error=$(grep "# maximum error = " $workdir/encoded_errors.dat | awk '{print $5}')
+
+    if [[ -z "$bound" || "$num_snapshots" != "$expected_snapshots" ]]; then
+        echo -e "${red}failed${nc} (found $num_snapshots of $expected_snapshots snapshots)"
+        failed=1
+        return
+    fi
+    is_within_tolerance $max_error $bound
+}
+
+function truncated_container {
+    echo -n "Testing truncated container recovery....."
+
+    # remove the index and the last part of the container file
+    mkdir $workdir/truncated
+    cp $workdir/encoded/atoms-coords.* $workdir/encoded/spins-container.* $workdir/truncated/
+    size=$(stat -c %s $workdir/truncated/spins-container.data)
+    truncate -s $((size*3/4)) $workdir/truncated/spins-container.data
+
+    if ! (cd $workdir/truncated && "$vdc" --vtk &>vdc.log); then
+        echo -e "${red}failed${nc} (vdc exited with an error)"
+        failed=1
+        return
+    fi
+
+    $dir/spin_errors.py $workdir/reference $workdir/truncated > $workdir/truncated_errors.dat
+    num_snapshots=$(grep "# number of snapshots = " $workdir/truncated_errors.dat | awk '{print $6}')
+    max_error=$(grep "# maximum error = " $workdir/truncated_errors.dat | awk '{print $5}')
+    last_snapshot=$(printf "spins-%08d.vtu" $((num_snapshots-1)))
+
+    # complete snapshots before the truncation are recovered in order
+    if [[ $num_snapshots -gt 0 && $num_snapshots -lt $expected_snapshots && -f $workdir/truncated/$last_snapshot ]]; then
+        is_within_tolerance $max_error $bound
+    else
+        echo -e "${red}failed${nc} (recovered $num_snapshots of $expected_snapshots snapshots)"
+        failed=1
+    fi
+}
+
+readonly dir=tests/config-output
+readonly expected_snapshots=20
+vampire=$(pwd)/vampire-serial
+vdc=$(pwd)/util/vdc/vdc
+failed=0
+
+while [[ $# -gt 0 ]]
+do
+    key="$1"
+
+    case $key in
+        -h|--help)
+            help_message
+            exit
+            ;;
+        -v|--vampire)
+            vampire=$(realpath $2)
+            shift 2
+            ;;
+        -c|--vdc)
+            vdc=$(realpath $2)
+            shift 2
+            ;;
+        *)
+            echo -e "${red}Error: unknown option $key. See --help for details."
+            exit 1
+            ;;
+    esac
+done
+
+workdir=$(mktemp -d)
+trap cleanup EXIT INT TERM
+
+encoded_output
+if [[ $failed == 0 ]]; then
+    truncated_container
+fi
+
+exit $failed
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+
+# Compares spin directions in vtk files converted by vdc from encoded output
+# with those converted from unencoded output of the same simulation. Prints
+# the angular error of each snapshot, the number of snapshots found and the
+# maximum angular error in radians.
+#
+# usage: spin_errors.py reference_directory test_directory
+
+import glob
+import math
+import os
+import struct
+import sys
+
+def read_spins(filename):
+    """
+    returns the spin vectors of all atoms in a vtu file written by vdc with
+    raw appended float64 data, in which the spin array is the first block
+    """
+    data = open(filename, "rb").read()
+    if b'type="Float64" Name="spin"' not in data:
+        sys.exit("error: " + filename + " does not contain float64 spin data")
+    start = data.index(b'<AppendedData encoding="raw">')
+    start = data.index(b"_", start) + 1
+    size = struct.unpack("<Q", data[start:start+8])[0]
+    values = struct.unpack("<%dd" % (size // 8), data[start+8:start+8+size])
+    return [values[i:i+3] for i in range(0, len(values), 3)]
+
+def angle(a, b):
+    """
+    returns the angle between two vectors, using the cross product for an
+    accurate result for small angles
+    """
+    cross = (a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0])
+    sin = math.sqrt(sum(c*c for c in cross))
+    cos = sum(x*y for x, y in zip(a, b))
+    return math.atan2(sin, cos)
+
+reference_directory, test_directory = sys.argv[1:3]
+
+test_files = sorted(glob.glob(os.path.join(test_directory, "spins-*.vtu")))
+max_error = 0.0
+
+for test_file in test_files:
+    reference_file = os.path.join(reference_directory, os.path.basename(test_file))
+    if not os.path.exists(reference_file):
+        sys.exit("error: no reference snapshot for " + test_file)
+    reference = read_spins(reference_file)
+    test = read_spins(test_file)
+    if len(reference) != len(test):
+        sys.exit("error: different number of atoms in " + test_file)
+    error = max(angle(a, b) for a, b in zip(reference, test))
+    print(os.path.basename(test_file), error)
+
+    max_error = max(max_error, error)
+
+print("# number of snapshots = ", len(test_files))
+print("# maximum error = ", max_error)
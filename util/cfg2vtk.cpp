@@ -9,12 +9,17 @@
 //
 // Program to convert vampire cfg files to vtk format (for programs such as paraview)
 //
-// ./cfg2vtk
+// ./cfg2vtk [--float32]
+//
+// Each snapshot is written as a binary XML unstructured grid file atoms-XXXXXXXX.vtu
+// with appended raw data in double (or single with --float32) precision, and
+// the time series is collected in atoms.pvd.
 //
 
 // Standard Libraries
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -63,7 +68,62 @@ void rgb( double ireal, double &red, double &green, double &blue){
 
 }
 
-int main(){
+//------------------------------------------------------------------------------
+// Function to append real data to appended data block in output precision
+//------------------------------------------------------------------------------
+void append_real_data(std::vector<char>& block, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z, const unsigned int n, const bool float32){
+
+	const uint64_t size = uint64_t(n)*3*(float32 ? sizeof(float) : sizeof(double));
+	const uint64_t start = block.size();
+	block.resize(start + sizeof(uint64_t) + size);
+	std::memcpy(&block[start], &size, sizeof(uint64_t));
+
+	char* data = &block[start + sizeof(uint64_t)];
+	for(unsigned int i=0; i<n; i++){
+		const double v[3] = {x[i], y[i], z[i]};
+		for(int c=0; c<3; c++){
+			if(float32){
+				const float f = v[c];
+				std::memcpy(data, &f, sizeof(float));
+				data += sizeof(float);
+			}
+			else{
+				std::memcpy(data, &v[c], sizeof(double));
+				data += sizeof(double);
+			}
+		}
+	}
+
+}
+
+//------------------------------------------------------------------------------
+// Function to append integer data to appended data block
+//------------------------------------------------------------------------------
+void append_int_data(std::vector<char>& block, const std::vector<int>& x, const unsigned int n){
+
+	const uint64_t size = uint64_t(n)*sizeof(int);
+	const uint64_t start = block.size();
+	block.resize(start + sizeof(uint64_t) + size);
+	std::memcpy(&block[start], &size, sizeof(uint64_t));
+	if(n > 0) std::memcpy(&block[start + sizeof(uint64_t)], &x[0], size);
+
+}
+
+int main(int argc, char* argv[]){
+
+	// optional single precision output
+	bool float32 = false;
+	for(int arg=1; arg<argc; arg++){
+		if(std::string(argv[arg]) == "--float32") float32 = true;
+		else{
+			std::cerr << "Error! Unknown argument " << argv[arg] << ". Usage: cfg2vtk [--float32]" << std::endl;
+			return 1;
+		}
+	}
+	const std::string real_type = float32 ? "Float32" : "Float64";
+
+	// time of each snapshot for time series file
+	std::vector <double> snapshot_times(0);
 
 	std::vector <int> mat(0);
 	std::vector <int> cat(0);
@@ -316,7 +376,7 @@ int main(){
 	std::string vtk_file = vtk_file_sstr.str();
 
 	std::ofstream vtkfile;
-	vtkfile.open(vtk_file.c_str());
+	vtkfile.open(vtk_file.c_str(), std::ios::binary);
 
 	double sx,sy,sz,red,green,blue,ireal;
 	unsigned int si=0;
@@ -354,42 +414,44 @@ int main(){
 		infile.close();
 	}
 
+   // pack appended data blocks (spin, material, category, points, empty cell arrays)
+   std::vector<char> block;
+   uint64_t offset[7];
+   offset[0] = block.size(); append_real_data(block, spinx, spiny, spinz, si, float32);
+   offset[1] = block.size(); append_int_data(block, mat, si);
+   offset[2] = block.size(); append_int_data(block, cat, si);
+   offset[3] = block.size(); append_real_data(block, cx, cy, cz, si, float32);
+   for(int b=4; b<7; b++){
+      offset[b] = block.size(); append_int_data(block, mat, 0);
+   }
+
    // write .vtu file
    vtkfile << "<?xml version=\"1.0\"?>" << "\n";
-   vtkfile << "<VTKFile type=\"UnstructuredGrid\">" << "\n";
+   vtkfile << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">" << "\n";
    vtkfile << "<UnstructuredGrid>" << "\n";
-   vtkfile << "<Piece NumberOfPoints=\""<<si<<"\"  NumberOfCells=\"1\">" << "\n";
-   vtkfile << "<PointData Scalar=\"Spin\">" << "\n";
-   vtkfile << "<DataArray type=\"Float32\" Name=\"Spin\" NumberOfComponents=\"3\" format=\"ascii\">" << "\n";
-   for(int i=0; i<si; ++i){
-      vtkfile << spinx[i] << "\t" << spiny[i] << "\t" << spinz[i] << "\n";
-   }
-   vtkfile << "</DataArray>" << "\n";
+   vtkfile << "<Piece NumberOfPoints=\""<<si<<"\" NumberOfCells=\"0\">" << "\n";
+   vtkfile << "<PointData Vectors=\"Spin\" Scalars=\"Material\">" << "\n";
+   vtkfile << "<DataArray type=\"" << real_type << "\" Name=\"Spin\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offset[0] << "\"/>" << "\n";
+   vtkfile << "<DataArray type=\"Int32\" Name=\"Material\" format=\"appended\" offset=\"" << offset[1] << "\"/>" << "\n";
+   vtkfile << "<DataArray type=\"Int32\" Name=\"Category\" format=\"appended\" offset=\"" << offset[2] << "\"/>" << "\n";
    vtkfile << "</PointData>" << "\n";
-   vtkfile << "<CellData>" << "\n";
-   vtkfile << "</CellData>" << "\n";
    vtkfile << "<Points>" << "\n";
-   vtkfile << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"ascii\">" << "\n";
-   for(int i=0; i<si; ++i){
-      vtkfile << cx[i] << "\t" << cy[i] << "\t" << cz[i] << "\n";
-   }
-   vtkfile << "</DataArray>" << "\n";
+   vtkfile << "<DataArray type=\"" << real_type << "\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offset[3] << "\"/>" << "\n";
    vtkfile << "</Points>" << "\n";
    vtkfile << "<Cells>" << "\n";
-   vtkfile << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">" << "\n";
-   vtkfile << "1" << "\n";
-   vtkfile << "</DataArray>" << "\n";
-   vtkfile << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">" << "\n";
-   vtkfile << "1" << "\n";
-   vtkfile << "</DataArray>" << "\n";
-   vtkfile << "<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">" << "\n";
-   vtkfile << "1" << "\n";
-   vtkfile << "</DataArray>" << "\n";
+   vtkfile << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"" << offset[4] << "\"/>" << "\n";
+   vtkfile << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"" << offset[5] << "\"/>" << "\n";
+   vtkfile << "<DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offset[6] << "\"/>" << "\n";
    vtkfile << "</Cells>" << "\n";
    vtkfile << "</Piece>" << "\n";
    vtkfile << "</UnstructuredGrid>" << "\n";
+   vtkfile << "<AppendedData encoding=\"raw\">" << "\n" << "_";
+   vtkfile.write(&block[0], block.size());
+   vtkfile << "\n" << "</AppendedData>" << "\n";
    vtkfile << "</VTKFile>" << "\n";
 
+	snapshot_times.push_back(time);
+
 	// close vtk file
 	vtkfile.close();
 
@@ -398,6 +460,19 @@ int main(){
 	  else ios=1;
    }
 
+	// write time series file
+	std::ofstream pvdfile;
+	pvdfile.open("atoms.pvd");
+	pvdfile << "<?xml version=\"1.0\"?>" << "\n";
+	pvdfile << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\">" << "\n";
+	pvdfile << "<Collection>" << "\n";
+	for(int i=0; i<snapshot_times.size(); i++){
+		pvdfile << "<DataSet timestep=\"" << snapshot_times[i] << "\" group=\"\" part=\"0\" file=\"atoms-" << std::setfill('0') << std::setw(8) << i << ".vtu\"/>" << "\n";
+	}
+	pvdfile << "</Collection>" << "\n";
+	pvdfile << "</VTKFile>" << "\n";
+	pvdfile.close();
+
 
 
 	// finished
@@ -0,0 +1,53 @@
+#!/bin/bash
+#--------------------------------------------------------------------------
+#
+#   Script to measure the shared memory scaling of vampire with the number
+#   of OpenMP threads. Runs the input file in the current directory for
+#   1 to max_threads threads and reports the wall time and speed up.
+#
+#   Usage: openmp-scaling.sh <path to vampire-serial> <max threads> [out_file]
+#
+#--------------------------------------------------------------------------
+
+vampire=$1
+max_threads=$2
+out_file=$3
+
+if [ -z "$vampire" ] || [ -z "$max_threads" ]
+then
+    echo "Usage: $0 <path to vampire-serial> <max threads> [out_file]"
+    exit 1
+fi
+
+# runs use a temporary copy of the input file so that it is left unchanged
+tmp_input=$(mktemp ./input-scaling.XXXXXX) || exit 1
+trap 'rm -f "$tmp_input"' EXIT INT TERM
+
+echo "# threads  time(s)  speedup  efficiency"
+
+t1=""
+for (( nthreads=1; nthreads<=max_threads; nthreads++ ))
+do
+    grep -v "openmp:num-threads" input > "$tmp_input"
+    echo "openmp:num-threads=$nthreads" >> "$tmp_input"
+
+    start=$(date +%s.%N)
+    $vampire --input-file "$tmp_input" &>/dev/null
+    end=$(date +%s.%N)
+    t=$(awk "BEGIN{print $end - $start}")
+
+    if [ -z "$t1" ]
+    then
+        t1=$t
+    fi
+
+    speedup=$(awk "BEGIN{print $t1 / $t}")
+    efficiency=$(awk "BEGIN{print $speedup / $nthreads}")
+
+    printf "%8d  %8.3f  %7.3f  %10.3f\n" $nthreads $t $speedup $efficiency
+
+    if [ ! -z "$out_file" ]
+    then
+        printf "%d %f %f %f\n" $nthreads $t $speedup $efficiency >> $out_file
+    fi
+done
@@ -63,19 +63,10 @@ namespace vdc{
 
       unsigned int num_cells[3] = { nx, ny, nz };
 
-      // allocate storage for cell coordinates and cell magnetization
+      // allocate storage for cell coordinates (cell magnetization is calculated for each snapshot)
       vdc::total_cells = num_cells[0] * num_cells[1] * num_cells[2];
 
-      // total number of materials + 1
-      const unsigned int tmid = 1+vdc::materials.size();
-
       vdc::cell_coords.resize(3*total_cells, 0.0);
-      vdc::cell_magnetization.resize(total_cells);
-      for(int i = 0; i < vdc::total_cells; i++){
-         vdc::cell_magnetization[i].resize(tmid);
-         // stored as mx, my, mz, |m| sets
-         for(int j=0; j< tmid; j++) vdc::cell_magnetization[i][j].resize(4,0.0); // initialise cell magnetization to zero
-      }
 
       // allocate cell memory in 3D and store 1D cell id
       int cell = 0;
@@ -132,22 +123,18 @@ namespace vdc{
 
    }
 
-   void output_cell_file(unsigned int spin_file_id){
-
-      // output informative message to user
-      if(vdc::verbose) std::cout << "   Calculating cell magnetization for " << vdc::cell_magnetization.size() << " cells" << std::endl;
+   //---------------------------------------------------------------------------
+   // Function to calculate cell magnetization of a single snapshot and output
+   // to disk. Cell magnetization is stored locally so that snapshots can be
+   // processed in parallel.
+   //---------------------------------------------------------------------------
+   void output_cell_file(unsigned int spin_file_id, const std::vector<double>& spins){
 
       // total number of materials + 1
       const unsigned int tmid = 1+vdc::materials.size();
 
-      // initialise magnetization to zero
-      for(int cell = 0; cell < vdc::total_cells; cell++){
-         for(int m = 0; m < tmid; m++){
-            for(int e = 0; e < 4; e++){
-               vdc::cell_magnetization[cell][m][e] = 0.0;
-            }
-         }
-      }
+      // cell magnetization stored as mx, my, mz, |m| sets for each material (initialised to zero)
+      std::vector<double> cell_magnetization(4*tmid*vdc::total_cells, 0.0);
 
       // calculate cell magnetizations in 1D
       for(unsigned int atom = 0; atom < vdc::num_atoms; atom++){
@@ -155,44 +142,47 @@ namespace vdc{
          const unsigned int mat = vdc::type[atom];
          const double mu = vdc::materials[mat].moment;
 
-         const double sx = vdc::spins[3*atom+0];
-         const double sy = vdc::spins[3*atom+1];
-         const double sz = vdc::spins[3*atom+2];
+         const double sx = spins[3*atom+0];
+         const double sy = spins[3*atom+1];
+         const double sz = spins[3*atom+2];
 
          const unsigned int cell_id = atom_cell_id[atom];
 
-         vdc::cell_magnetization[cell_id][mat][0] += sx*mu;
-         vdc::cell_magnetization[cell_id][mat][1] += sy*mu;
-         vdc::cell_magnetization[cell_id][mat][2] += sz*mu;
-         vdc::cell_magnetization[cell_id][mat][3] += mu;
+         double* cm = &cell_magnetization[4*tmid*cell_id];
+
+         cm[4*mat+0] += sx*mu;
+         cm[4*mat+1] += sy*mu;
+         cm[4*mat+2] += sz*mu;
+         cm[4*mat+3] += mu;
 
          // total magnetization in last set
-         vdc::cell_magnetization[cell_id][tmid-1][0] += sx*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][1] += sy*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][2] += sz*mu;
-         vdc::cell_magnetization[cell_id][tmid-1][3] += mu;
+         cm[4*(tmid-1)+0] += sx*mu;
+         cm[4*(tmid-1)+1] += sy*mu;
+         cm[4*(tmid-1)+2] += sz*mu;
+         cm[4*(tmid-1)+3] += mu;
 
       }
 
       // normalise magnetizations
       for(int cell = 0; cell < vdc::total_cells; cell++){
          for(int m = 0; m < tmid; m++){
-            const double mx = vdc::cell_magnetization[cell][m][0];
-            const double my = vdc::cell_magnetization[cell][m][1];
-            const double mz = vdc::cell_magnetization[cell][m][2];
-            const double mm = vdc::cell_magnetization[cell][m][3];
+            double* cm = &cell_magnetization[4*(tmid*cell + m)];
+            const double mx = cm[0];
+            const double my = cm[1];
+            const double mz = cm[2];
+            const double mm = cm[3];
 
             const double norm = sqrt(mx*mx + my*my + mz*mz);
             const double inorm = 1.0/norm;
 
-            vdc::cell_magnetization[cell][m][0] = mx*inorm;
-            vdc::cell_magnetization[cell][m][1] = my*inorm;
-            vdc::cell_magnetization[cell][m][2] = mz*inorm;
+            cm[0] = mx*inorm;
+            cm[1] = my*inorm;
+            cm[2] = mz*inorm;
 
             // set magnetization of final cell to actual magnetization in mu_B
-            if(m == tmid -1) vdc::cell_magnetization[cell][m][3] = norm; // mu_B
+            if(m == tmid -1) cm[3] = norm; // mu_B
             // Otherwise normalise for material magnetization
-            else vdc::cell_magnetization[cell][m][3] = norm/mm; // m/m_s
+            else cm[3] = norm/mm; // m/m_s
 
          }
 	 }
@@ -207,15 +197,13 @@ namespace vdc{
       cell_file_sstr << ".txt";
       std::string cell_file_name = cell_file_sstr.str();
 
-      // output informative message to user
-      std::cout << "   Writing cell file " << cell_file_name << "..." << std::flush;
-
       ofile.open(cell_file_name.c_str());
 
       for(int cell = 0; cell < total_cells; cell++){
          ofile << vdc::cell_coords[3*cell + 0] << "\t" << vdc::cell_coords[3*cell + 1] << "\t" << vdc::cell_coords[3*cell + 2] << "\t";
          for(int m = 0; m < tmid; m++){
-            ofile << vdc::cell_magnetization[cell][m][0] << "\t" << vdc::cell_magnetization[cell][m][1] << "\t" << vdc::cell_magnetization[cell][m][2] << "\t" << vdc::cell_magnetization[cell][m][3] << "\t";
+            const double* cm = &cell_magnetization[4*(tmid*cell + m)];
+            ofile << cm[0] << "\t" << cm[1] << "\t" << cm[2] << "\t" << cm[3] << "\t";
          }
          ofile << "\n";
 
@@ -228,8 +216,6 @@ namespace vdc{
 
       ofile.close();
 
-      std::cout << "done!" << std::endl;
-
       return;
 
    }
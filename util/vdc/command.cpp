@@ -11,7 +11,10 @@
 //
 
 // C++ standard library headers
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 // program header
 #include "vdc.hpp"
@@ -29,3 +32,96 @@
 //    --objects = spins, cones, spheres, cubes
 //    --slice = x,x,y,y,z,z
 //    --multiscale = gradient, material, region
+//
+// Implemented options:
+//    --range = first,last - convert snapshots first to last (inclusive)
+//    --threads = n - number of threads used to convert snapshots
+//    --povray - generate povray files
+//    --vtk [= float64, float32] - generate binary vtk files
+//
+// If no output is specified povray files are generated.
+
+namespace vdc{
+
+//------------------------------------------------------------------------------
+// Function to print error for invalid command line argument and exit
+//------------------------------------------------------------------------------
+void invalid_argument(const std::string& argument, const std::string& expected){
+   std::cerr << "Error! Invalid command line argument \"" << argument << "\". Expected " << expected << ". Exiting" << std::endl;
+   exit(1);
+}
+
+//------------------------------------------------------------------------------
+// Function to process command line arguments
+//------------------------------------------------------------------------------
+void command(int argc, char* argv[]){
+
+   // flags for outputs specified on command line
+   bool povray = false;
+   bool vtk = false;
+
+   for(int arg = 1; arg < argc; arg++){
+
+      std::string argument = argv[arg];
+
+      // split argument into key and value, value may also be next argument
+      std::string key = argument;
+      std::string value = "";
+      const size_t eq = argument.find('=');
+      if(eq != std::string::npos){
+         key = argument.substr(0, eq);
+         value = argument.substr(eq + 1);
+      }
+      else if(arg + 1 < argc && (key == "--range" || key == "--threads")){
+         value = argv[++arg];
+         argument += " " + value;
+      }
+
+      //------------------------------------------------------------------------
+      if(key == "--range"){
+         // replace separator with space for reading
+         for(size_t i = 0; i < value.size(); i++) if(value[i] == ',' || value[i] == ':') value[i] = ' ';
+         std::istringstream ss(value);
+         int64_t first = -1;
+         int64_t last = -1;
+         ss >> first;
+         if(ss.fail() || first < 0) invalid_argument(argument, "--range=first,last");
+         // last snapshot is optional
+         if(!(ss >> last)) last = 99999999;
+         if(last < first) invalid_argument(argument, "--range=first,last with first <= last");
+         vdc::range_min = first;
+         vdc::range_max = last;
+      }
+      //------------------------------------------------------------------------
+      else if(key == "--threads"){
+         const int n = atoi(value.c_str());
+         if(n < 1 || n > 4096) invalid_argument(argument, "--threads=n with 1 <= n <= 4096");
+         vdc::num_threads = n;
+      }
+      //------------------------------------------------------------------------
+      else if(key == "--povray"){
+         povray = true;
+      }
+      //------------------------------------------------------------------------
+      else if(key == "--vtk"){
+         vtk = true;
+         if(value == "float32") vdc::vtk_float32 = true;
+         else if(value == "float64" || value == "") vdc::vtk_float32 = false;
+         else invalid_argument(argument, "--vtk=float64 or --vtk=float32");
+      }
+      //------------------------------------------------------------------------
+      else invalid_argument(argument, "--range=first,last, --threads=n, --povray or --vtk[=float32]");
+
+   }
+
+   // only generate specified outputs
+   if(povray || vtk){
+      vdc::povray = povray;
+      vdc::vtk = vtk;
+   }
+
+   return;
+
+}
+
+} // end of namespace vdc
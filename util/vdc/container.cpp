@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// program header
+#include "vdc.hpp"
+
+namespace vdc{
+
+// sizes of container file sections (bytes, see src/config/container.cpp)
+const uint64_t container_header_size = 32;
+const uint64_t record_header_size = 112;
+const uint64_t index_entry_size = 88;
+const uint64_t trailer_size = 32;
+
+//------------------------------------------------------------------------------
+// Function to unpack double from little-endian byte buffer
+//------------------------------------------------------------------------------
+inline double unpack_double(const char* buffer){
+   const uint64_t bits = unpack_uint(buffer, 8);
+   double value = 0.0;
+   std::memcpy(&value, &bits, sizeof(double));
+   return value;
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate 64 bit FNV-1a checksum (same as vutil::checksum)
+//------------------------------------------------------------------------------
+uint64_t checksum(const char* data, const uint64_t size){
+
+   uint64_t hash = 14695981039346656037ULL;
+   const uint64_t prime = 1099511628211ULL;
+   const uint64_t num_words = size/8;
+
+   for(uint64_t i = 0; i < num_words; i++){
+      uint64_t word;
+      std::memcpy(&word, data + 8*i, 8);
+      hash = (hash ^ word)*prime;
+   }
+   for(uint64_t i = 8*num_words; i < size; i++){
+      hash = (hash ^ uint64_t((unsigned char)data[i]))*prime;
+   }
+
+   return hash;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read container metafile listing container files. Returns false
+// if spin data are not in container format.
+//------------------------------------------------------------------------------
+//
+// Example metafile format:
+//
+//       #------------------------------------------------------
+//       # Atomistic spin configuration container for vampire v5+
+//       #------------------------------------------------------
+//       # Date: Fri Apr  7 21:42:33 2017
+//       #------------------------------------------------------
+//       Number of container files: 1
+//       spins-container.data
+//       #------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool read_container_metadata(){
+
+   std::ifstream cmfile;
+   cmfile.open("spins-container.meta");
+
+   // no container file, data are in separate files
+   if(!cmfile.is_open()) return false;
+
+   std::string line; // line string variable
+
+   // read in file header
+   for(int i=0; i<5; i++) getline(cmfile, line);
+
+   // get number of container files
+   getline(cmfile, line);
+   line.erase (line.begin(), line.begin()+27);
+   unsigned int num_files = atoi(line.c_str());
+
+   if(vdc::verbose) std::cout << "--------------------------------------------------------------------" << std::endl;
+   if(vdc::verbose) std::cout << "Reading spin container meta-data file spins-container.meta" << std::endl;
+   if(vdc::verbose) std::cout << "   Number of container files: " << num_files << std::endl;
+
+   vdc::container_filenames.resize(0);
+
+   for(unsigned int file = 0; file < num_files; file++){
+      getline(cmfile, line);
+      line.erase(remove(line.begin(), line.end(), '\t'), line.end());
+      line.erase(remove(line.begin(), line.end(), ' '), line.end());
+      line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+      vdc::container_filenames.push_back(line);
+      if(vdc::verbose) std::cout << "      " << line << std::endl;
+   }
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read index of mapped container file, giving snapshot ids and
+// offsets of spin data. If the index is invalid (the simulation stopped while
+// writing) the complete records are found by scanning the file.
+//------------------------------------------------------------------------------
+void read_container_index(const std::string& filename, const vdc::mapped_file_t& file, std::vector<uint64_t>& ids, std::vector<double>& times, std::vector<uint64_t>& offsets){
+
+   const uint64_t file_size = file.size;
+   const char* data = file.data;
+
+   if(file_size < container_header_size || std::memcmp(data, "VSPINC01", 8) != 0){
+      std::cerr << "   Error! File \"" << filename << "\" is not a spin container file. Exiting" << std::endl;
+      exit(1);
+   }
+
+   ids.resize(0);
+   times.resize(0);
+   offsets.resize(0);
+
+   // read index from trailer at end of file
+   if(file_size >= container_header_size + trailer_size){
+
+      const char* trailer = data + file_size - trailer_size;
+
+      const uint64_t num_snapshots = unpack_uint(trailer +  8, 8);
+      const uint64_t index_offset  = unpack_uint(trailer + 16, 8);
+      const uint64_t index_size = index_entry_size*num_snapshots;
+
+      if(std::memcmp(trailer, "VSPINIDX", 8) == 0 && num_snapshots <= file_size/index_entry_size &&
+         index_size + trailer_size <= file_size && index_offset <= file_size - trailer_size - index_size){
+
+         const char* index = data + index_offset;
+
+         if(checksum(index, index_size) == unpack_uint(trailer + 24, 8)){
+            for(uint64_t i = 0; i < num_snapshots; i++){
+               offsets.push_back(unpack_uint(&index[index_entry_size*i], 8) + record_header_size);
+               ids.push_back(unpack_uint(&index[index_entry_size*i + 16], 8));
+               times.push_back(unpack_double(&index[index_entry_size*i + 24]));
+            }
+            return;
+         }
+
+      }
+
+   }
+
+   // otherwise recover snapshots by scanning records
+   std::cout << "   Warning: index of container file \"" << filename << "\" is invalid - recovering complete snapshots" << std::endl;
+
+   uint64_t offset = container_header_size;
+
+   while(offset + record_header_size <= file_size){
+
+      const char* record = data + offset;
+      if(std::memcmp(record, "VSNAPREC", 8) != 0) break;
+      if(checksum(record, 96) != unpack_uint(record + 96, 8)) break;
+
+      const uint64_t payload_bytes = unpack_uint(record + 16, 8);
+      const uint64_t payload_checksum = unpack_uint(record + 24, 8);
+      if(payload_bytes > file_size - offset - record_header_size) break;
+
+      if(payload_checksum != 0){
+         if(checksum(record + record_header_size, payload_bytes) != payload_checksum) break;
+      }
+
+      ids.push_back(unpack_uint(record + 8, 8));
+      times.push_back(unpack_double(record + 32));
+      offsets.push_back(offset + record_header_size);
+      offset += record_header_size + payload_bytes;
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to map all container files and read their indices. Only snapshots
+// present in all files can be processed.
+//------------------------------------------------------------------------------
+void read_container_indices(std::vector<vdc::mapped_file_t*>& files){
+
+   const unsigned int num_files = vdc::container_filenames.size();
+
+   files.resize(num_files);
+   vdc::container_offsets.resize(num_files);
+
+   std::vector<uint64_t> ids;
+   std::vector<double> times;
+   for(unsigned int f = 0; f < num_files; f++){
+      files[f] = new vdc::mapped_file_t;
+      if(!files[f]->open(vdc::container_filenames[f])){
+         std::cerr << "   Error! Spin container file \"" << vdc::container_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
+         exit(1);
+      }
+      read_container_index(vdc::container_filenames[f], *files[f], ids, times, vdc::container_offsets[f]);
+      if(f == 0 || ids.size() < vdc::container_snapshot_ids.size()){
+         vdc::container_snapshot_ids = ids;
+         vdc::container_snapshot_times = times;
+      }
+   }
+
+   if(vdc::verbose) std::cout << "   Number of snapshots: " << vdc::container_snapshot_ids.size() << std::endl;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to locate spin data of snapshot s in mapped container files
+//------------------------------------------------------------------------------
+void open_container_snapshot(std::vector<vdc::mapped_file_t*>& files, uint64_t s, vdc::snapshot_t& snapshot){
+
+   const unsigned int num_files = files.size();
+
+   snapshot.filenames = vdc::container_filenames;
+   snapshot.data.resize(num_files);
+   snapshot.data_size.resize(num_files);
+
+   for(unsigned int f = 0; f < num_files; f++){
+      const uint64_t offset = vdc::container_offsets[f][s];
+      snapshot.data[f] = files[f]->data + offset;
+      snapshot.data_size[f] = files[f]->size - offset;
+   }
+
+   return;
+
+}
+
+} // end of namespace vdc
@@ -198,32 +198,41 @@ void read_coord_data(){
    // index counter
    uint64_t atom_id = 0;
 
+   vdc::coord_file_atoms.resize(0);
+
    // loop over all files
    for(unsigned int f = 0; f < vdc::coord_filenames.size(); f++){
 
       switch (vdc::format){
 
          case vdc::binary:{
-            uint64_t num_atoms_in_file = 0;
-            // open file in binary mode
-            std::ifstream ifile;
-            ifile.open(coord_filenames[f].c_str(), std::ios::binary); // check for errors
-            // check for open file
-            if(!ifile.is_open()){
+            // map file into memory
+            vdc::mapped_file_t ifile;
+            if(!ifile.open(coord_filenames[f])){
                std::cerr << "Error! Coordinate data file \"" << coord_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
                std::cerr << "Error code: " << std::strerror(errno) << std::endl;
                exit(1);
             }
             // read number of atoms
-            ifile.read( (char*)&num_atoms_in_file,sizeof(uint64_t) );
+            uint64_t num_atoms_in_file = 0;
+            if(ifile.size >= sizeof(uint64_t)) std::memcpy(&num_atoms_in_file, ifile.data, sizeof(uint64_t));
+            // check file contains data for all atoms
+            const uint64_t data_size = sizeof(uint64_t) + num_atoms_in_file*(2*sizeof(int) + 3*sizeof(double));
+            if(ifile.size < data_size || atom_id + num_atoms_in_file > vdc::num_atoms){
+               std::cerr << "Error! Coordinate data file \"" << coord_filenames[f] << "\" is truncated or has too many atoms. Exiting" << std::endl;
+               exit(1);
+            }
+            const char* data = ifile.data + sizeof(uint64_t);
             // read type array
-            ifile.read((char*)&vdc::type[atom_id], sizeof(int)*num_atoms_in_file);
+            std::memcpy(&vdc::type[atom_id], data, sizeof(int)*num_atoms_in_file);
+            data += sizeof(int)*num_atoms_in_file;
             // read category array
-            ifile.read((char*)&vdc::category[atom_id], sizeof(int)*num_atoms_in_file);
-            ifile.read((char*)&vdc::coordinates[3*atom_id], sizeof(double)*num_atoms_in_file*3);
+            std::memcpy(&vdc::category[atom_id], data, sizeof(int)*num_atoms_in_file);
+            data += sizeof(int)*num_atoms_in_file;
+            std::memcpy(&vdc::coordinates[3*atom_id], data, sizeof(double)*num_atoms_in_file*3);
             // increment counter
             atom_id += num_atoms_in_file;
-            ifile.close();
+            vdc::coord_file_atoms.push_back(num_atoms_in_file);
 
             break;
          }
@@ -261,6 +270,7 @@ void read_coord_data(){
                atom_id += 1;
             }
             ifile.close();
+            vdc::coord_file_atoms.push_back(num_atoms_in_file);
             break;
          }
 
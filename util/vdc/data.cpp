@@ -22,6 +22,15 @@ namespace vdc{
    bool xyz = true; // flag to specify crystal.xyz file output
    bool povray = true; // flag to specify povray file output
    bool cells = false; // flag to specify cells output
+   bool vtk = false; // flag to specify vtk file output
+   bool vtk_float32 = false; // flag to specify single precision vtk data
+
+   // number of threads for processing snapshots in parallel
+   unsigned int num_threads = 0; // default determined by hardware
+
+   // range of snapshots to convert (inclusive)
+   uint64_t range_min = 0;
+   uint64_t range_max = 99999999;
 
    format_t format;
 
@@ -40,7 +49,6 @@ namespace vdc{
    std::vector<int> type(0);
 
    std::vector<double> coordinates(0);
-   std::vector<double> spins(0);
 
    // non-magnetic atom data
    uint64_t num_nm_atoms = 0;
@@ -56,11 +64,16 @@ namespace vdc{
 
    std::vector<int> atom_cell_id;
    std::vector<double> cell_coords;
-   std::vector< std::vector< std::vector <double> > > cell_magnetization;
 
    // array to store subsidiary data file names
    std::vector <std::string> coord_filenames(0);
-   std::vector <std::string> spin_filenames(0);
+   std::vector <uint64_t> coord_file_atoms(0); // number of atoms in each coordinate file
    std::vector <std::string> nm_filenames(0);
 
+   // spin data container files and offsets of spin data of each snapshot
+   std::vector <std::string> container_filenames(0);
+   std::vector <uint64_t> container_snapshot_ids(0);
+   std::vector <double> container_snapshot_times(0);
+   std::vector < std::vector <uint64_t> > container_offsets(0);
+
 } // end of namespace vdc
@@ -19,7 +19,7 @@
 int main(int argc, char* argv[]){
 
    // process command line arguments
-   //command(argc, argv);
+   vdc::command(argc, argv);
 
    if(vdc::verbose){
       std::cout << "|------------------------------------------------------------|" << std::endl;
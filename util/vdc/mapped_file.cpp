@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <string>
+#include <vector>
+
+// POSIX headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// program header
+#include "vdc.hpp"
+
+namespace vdc{
+
+//------------------------------------------------------------------------------
+// Constructor and destructor
+//------------------------------------------------------------------------------
+mapped_file_t::mapped_file_t():
+   data(NULL),
+   size(0),
+   mapped(false)
+{}
+
+mapped_file_t::~mapped_file_t(){
+   close();
+}
+
+//------------------------------------------------------------------------------
+// Function to map file into memory, returning false if the file cannot be
+// opened
+//------------------------------------------------------------------------------
+bool mapped_file_t::open(const std::string& filename){
+
+   // release previously opened file
+   close();
+
+   const int fd = ::open(filename.c_str(), O_RDONLY);
+   if(fd < 0) return false;
+
+   struct stat file_stat;
+   if(fstat(fd, &file_stat) != 0){
+      ::close(fd);
+      return false;
+   }
+
+   size = file_stat.st_size;
+
+   if(size > 0){
+
+      void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if(ptr != MAP_FAILED){
+         // data are read once from start to end
+         madvise(ptr, size, MADV_SEQUENTIAL);
+         data = static_cast<const char*>(ptr);
+         mapped = true;
+      }
+      // otherwise read whole file into memory
+      else{
+         buffer.resize(size);
+         uint64_t bytes_read = 0;
+         while(bytes_read < size){
+            const ssize_t n = pread(fd, &buffer[bytes_read], size - bytes_read, bytes_read);
+            if(n <= 0) break;
+            bytes_read += n;
+         }
+         size = bytes_read;
+         data = &buffer[0];
+      }
+
+   }
+
+   // mapping remains valid after the file is closed
+   ::close(fd);
+
+   return true;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to unmap file
+//------------------------------------------------------------------------------
+void mapped_file_t::close(){
+
+   if(mapped) munmap(const_cast<char*>(data), size);
+
+   std::vector<char>().swap(buffer);
+
+   data = NULL;
+   size = 0;
+   mapped = false;
+
+   return;
+
+}
+
+} // end of namespace vdc
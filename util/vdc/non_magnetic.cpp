@@ -148,26 +148,32 @@ void read_nm_data(){
       switch (vdc::format){
 
          case vdc::binary:{
-            uint64_t num_atoms_in_file = 0;
-            // open file in binary mode
-            std::ifstream ifile;
-            ifile.open(nm_filenames[f].c_str(), std::ios::binary); // check for errors
-            // check for open file
-            if(!ifile.is_open()){
+            // map file into memory
+            vdc::mapped_file_t ifile;
+            if(!ifile.open(nm_filenames[f])){
                std::cerr << "Error! non-magnetic data file \"" << nm_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
                std::cerr << "Error code: " << std::strerror(errno) << std::endl;
                exit(1);
             }
             // read number of atoms
-            ifile.read( (char*)&num_atoms_in_file,sizeof(uint64_t) );
+            uint64_t num_atoms_in_file = 0;
+            if(ifile.size >= sizeof(uint64_t)) std::memcpy(&num_atoms_in_file, ifile.data, sizeof(uint64_t));
+            // check file contains data for all atoms
+            const uint64_t data_size = sizeof(uint64_t) + num_atoms_in_file*(2*sizeof(int) + 3*sizeof(double));
+            if(ifile.size < data_size || atom_id + num_atoms_in_file > vdc::num_nm_atoms){
+               std::cerr << "Error! non-magnetic data file \"" << nm_filenames[f] << "\" is truncated or has too many atoms. Exiting" << std::endl;
+               exit(1);
+            }
+            const char* data = ifile.data + sizeof(uint64_t);
             // read type array
-            ifile.read((char*)&vdc::nm_type[atom_id], sizeof(int)*num_atoms_in_file);
+            std::memcpy(&vdc::nm_type[atom_id], data, sizeof(int)*num_atoms_in_file);
+            data += sizeof(int)*num_atoms_in_file;
             // read category array
-            ifile.read((char*)&vdc::nm_category[atom_id], sizeof(int)*num_atoms_in_file);
-            ifile.read((char*)&vdc::nm_coordinates[3*atom_id], sizeof(double)*num_atoms_in_file*3);
+            std::memcpy(&vdc::nm_category[atom_id], data, sizeof(int)*num_atoms_in_file);
+            data += sizeof(int)*num_atoms_in_file;
+            std::memcpy(&vdc::nm_coordinates[3*atom_id], data, sizeof(double)*num_atoms_in_file*3);
             // increment counter
             atom_id += num_atoms_in_file;
-            ifile.close();
 
             break;
          }
@@ -12,6 +12,7 @@
 
 // C++ standard library headers
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -27,9 +28,9 @@ namespace vdc{
 // forward function declarations
 
 //------------------------------------------------------------------------------
-// Function to output crystal.xyz file compatible with rasmol
+// Function to output povray include file for spin data of a single snapshot
 //------------------------------------------------------------------------------
-void output_inc_file(unsigned int spin_file_id){
+void output_inc_file(unsigned int spin_file_id, const std::vector<double>& spins){
 
    // Open Povray Include File
 	std::stringstream incpov_file_sstr;
@@ -38,9 +39,6 @@ void output_inc_file(unsigned int spin_file_id){
 	incpov_file_sstr << ".inc";
 	std::string incpov_file = incpov_file_sstr.str();
 
-   // output informative message to user
-   std::cout << "   Writing povray file " << incpov_file << "..." << std::flush;
-
    // temporary variables defining spin colours
    double red=0.0, green=0.0, blue=1.0;
 
@@ -48,6 +46,10 @@ void output_inc_file(unsigned int spin_file_id){
    std::ofstream incfile;
    incfile.open(incpov_file.c_str());
 
+   // lines are formatted with snprintf (same format as default stream output)
+   // and streamed directly to the file buffer
+   char line[512];
+
    for(unsigned int atom = 0; atom < vdc::num_atoms; atom++){
 
       // get z-magnetization for colour constrast
@@ -56,35 +58,30 @@ void output_inc_file(unsigned int spin_file_id){
       // calculate rgb components based on z magnetization
       vdc::rgb(sz, red, green, blue);
 
-      std::stringstream line;
-      line << "spinm"<< type[atom] << "(" <<
-              coordinates[3*atom+0]-vdc::system_centre[0] << "," << coordinates[3*atom+1]-vdc::system_centre[1] << "," << coordinates[3*atom+2]-vdc::system_centre[2] << "," <<
-              spins[3*atom+0] << "," << spins[3*atom+1] << "," << spins[3*atom+2] << "," <<
-              red << "," << green << "," << blue << ")\n";
+      const int length = snprintf(line, sizeof(line), "spinm%d(%g,%g,%g,%g,%g,%g,%g,%g,%g)\n", type[atom],
+                                  coordinates[3*atom+0]-vdc::system_centre[0], coordinates[3*atom+1]-vdc::system_centre[1], coordinates[3*atom+2]-vdc::system_centre[2],
+                                  spins[3*atom+0], spins[3*atom+1], spins[3*atom+2],
+                                  red, green, blue);
 
-      incfile << line.str();
+      incfile.write(line, length);
 
    }
 
    // write non-magnetic atoms to inc file
    for(unsigned int atom = 0; atom < vdc::num_nm_atoms; atom++){
 
-      std::stringstream line;
-      line << "spinm"<< nm_type[atom] << "(" <<
-              nm_coordinates[3*atom+0]-vdc::system_centre[0] << "," << nm_coordinates[3*atom+1]-vdc::system_centre[1] << "," << nm_coordinates[3*atom+2]-vdc::system_centre[2] << "," <<
-              0.0 << "," << 0.0 << "," << 0.0 << "," << // no spin
-              0.3 << "," << 0.3 << "," << 0.3 << ")\n"; // grey colour by default
+      const int length = snprintf(line, sizeof(line), "spinm%d(%g,%g,%g,%g,%g,%g,%g,%g,%g)\n", nm_type[atom],
+                                  nm_coordinates[3*atom+0]-vdc::system_centre[0], nm_coordinates[3*atom+1]-vdc::system_centre[1], nm_coordinates[3*atom+2]-vdc::system_centre[2],
+                                  0.0, 0.0, 0.0, // no spin
+                                  0.3, 0.3, 0.3); // grey colour by default
 
-      incfile << line.str();
+      incfile.write(line, length);
 
    }
 
    incfile << std::flush;
    incfile.close();
 
-   // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
-
    return;
 
 }
@@ -12,11 +12,16 @@
 
 // C++ standard library headers
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 // program header
@@ -25,8 +30,108 @@
 namespace vdc{
 
 // forward function declarations
-bool read_spin_metadata(unsigned int file_id);
-void read_spin_data(unsigned int file_id);
+bool read_spin_metadata(unsigned int file_id, std::vector<std::string>& filenames, double& time);
+void open_spin_snapshot(uint64_t s, vdc::snapshot_t& snapshot);
+void close_spin_snapshot(vdc::snapshot_t& snapshot);
+void load_spin_snapshot(uint64_t s, vdc::snapshot_t& snapshot);
+void read_text_spin_data(vdc::snapshot_t& snapshot);
+uint64_t read_binary_spin_data(vdc::snapshot_t& snapshot, unsigned int file_id, unsigned int f, uint64_t atom_id, bool reconstruct);
+uint64_t read_encoded_spin_data(vdc::snapshot_t& snapshot, unsigned int file_id, unsigned int f, uint64_t atom_id, bool reconstruct);
+
+// file scope variables shared by all threads
+namespace{
+   bool container = false; // flag to specify spin data are in container files
+   std::vector<uint64_t> snapshot_ids; // ids of all available snapshots
+   std::vector<double> snapshot_times; // simulation time of all available snapshots
+   std::vector<vdc::mapped_file_t*> container_files; // mapped container files
+   std::mutex output_mutex; // mutex for screen output from threads
+}
+
+// types of binary spin data
+enum spin_data_type_t { full_data = 0, keyframe_data = 1, delta_data = 2 };
+
+//------------------------------------------------------------------------------
+// Function to determine type of binary spin data from start of data
+//------------------------------------------------------------------------------
+spin_data_type_t spin_data_type(const char* data, const uint64_t size){
+   if(size < 48 || std::memcmp(data, "VSPINQ01", 8) != 0) return full_data;
+   if(unpack_uint(data + 24, 4) != 0) return delta_data;
+   return keyframe_data;
+}
+
+//------------------------------------------------------------------------------
+// Function to determine number of atoms in binary spin data
+//------------------------------------------------------------------------------
+uint64_t spin_data_num_atoms(const char* data, const uint64_t size){
+   if(size < 8) return 0;
+   if(spin_data_type(data, size) == full_data) return unpack_uint(data, 8);
+   return unpack_uint(data + 8, 8);
+}
+
+//------------------------------------------------------------------------------
+// Function to output encoding of compact spin data of snapshot s to screen
+//------------------------------------------------------------------------------
+void print_spin_encoding(uint64_t s){
+
+   vdc::snapshot_t snapshot;
+   vdc::open_spin_snapshot(s, snapshot);
+
+   if(snapshot.data.size() > 0 && spin_data_type(snapshot.data[0], snapshot.data_size[0]) != full_data){
+
+      const char* header = snapshot.data[0] + 8;
+      const uint64_t encoding      = unpack_uint(header +  8, 4);
+      const uint64_t bits_per_spin = unpack_uint(header + 12, 4);
+      const uint64_t error_bits    = unpack_uint(header + 24, 8);
+
+      double max_error = 0.0;
+      std::memcpy(&max_error, &error_bits, sizeof(double));
+
+      std::cout << "Spin data use " << (encoding == 1 ? "octahedral " : "spherical ") << bits_per_spin
+                << " bit encoding, maximum error " << max_error*180.0/M_PI << " degrees" << std::endl;
+
+   }
+
+   vdc::close_spin_snapshot(snapshot);
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to convert a contiguous block of snapshots, run on each thread
+//------------------------------------------------------------------------------
+void convert_spin_snapshots(const uint64_t first, const uint64_t last){
+
+   // spin data and decoding state for this thread
+   vdc::snapshot_t snapshot;
+   snapshot.spins.resize(3*vdc::num_atoms);
+
+   for(uint64_t s = first; s < last; s++){
+
+      const unsigned int file_id = snapshot_ids[s];
+
+      // read spin data
+      vdc::load_spin_snapshot(s, snapshot);
+
+      // output povray file
+      if(vdc::povray) output_inc_file(file_id, snapshot.spins);
+
+      if(vdc::cells) vdc::output_cell_file(file_id, snapshot.spins);
+
+      // output vtk file
+      if(vdc::vtk) vdc::output_vtk_file(file_id, snapshot.spins);
+
+      // output informative message to user
+      std::lock_guard<std::mutex> lock(output_mutex);
+      std::cout << "Processed snapshot " << std::setfill('0') << std::setw(8) << file_id << std::endl;
+
+   }
+
+   vdc::close_spin_snapshot(snapshot);
+
+   return;
+
+}
 
 //------------------------------------------------------------------------------
 // Wrapper function to read coordinate metafile to initialise data structures
@@ -34,40 +139,88 @@ void read_spin_data(unsigned int file_id);
 //------------------------------------------------------------------------------
 void process_spins(){
 
-   int min_file_id = 0;
-   int max_file_id = 99999999;
-
    if(vdc::cells) vdc::initialise_cells();
 
-   unsigned int last_file_id = max_file_id;
+   if(vdc::vtk) vdc::initialise_vtk();
 
-   // loop over all spin files
-   for(unsigned int file_id = min_file_id; file_id < max_file_id; file_id++){
+   // determine available snapshots from container index or spin metafiles
+   container = vdc::read_container_metadata();
+   if(container){
+      vdc::read_container_indices(container_files);
+      snapshot_ids = vdc::container_snapshot_ids;
+      snapshot_times = vdc::container_snapshot_times;
+   }
+   else{
+      std::vector<std::string> filenames;
+      double time = 0.0;
+      for(uint64_t file_id = 0; file_id <= vdc::range_max; file_id++){
+         if(!vdc::read_spin_metadata(file_id, filenames, time)) break;
+         snapshot_ids.push_back(file_id);
+         snapshot_times.push_back(time);
+      }
+   }
 
-      // read meta data
-      bool success = vdc::read_spin_metadata(file_id);
+   // determine snapshots in range (delta encoded snapshots before the range
+   // are still read if needed for decoding)
+   uint64_t first = 0;
+   while(first < snapshot_ids.size() && snapshot_ids[first] < vdc::range_min) first++;
+   uint64_t last = first;
+   while(last < snapshot_ids.size() && snapshot_ids[last] <= vdc::range_max) last++;
 
-      // if no success then break out of for loop
-      if(!success) break;
+   const uint64_t num_snapshots = last - first;
 
-      // read coordinate data
-      vdc::read_spin_data(file_id);
+   if(num_snapshots == 0){
+      std::cout << "No spin snapshots found in range " << vdc::range_min << " - " << vdc::range_max << std::endl;
+      return;
+   }
 
-      // output povray file
-      if(vdc::povray) output_inc_file(file_id);
+   // determine number of threads, by default one per hardware thread
+   unsigned int num_threads = vdc::num_threads;
+   if(num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+   if(num_threads > num_snapshots) num_threads = num_snapshots;
+
+   if(vdc::verbose){
+      std::cout << "--------------------------------------------------------------------" << std::endl;
+      std::cout << "Converting " << num_snapshots << " snapshots (" << snapshot_ids[first] << " - " << snapshot_ids[last-1]
+                << ") using " << num_threads << " threads" << std::endl;
+      std::cout << "--------------------------------------------------------------------" << std::endl;
+   }
 
-      if(vdc::cells) vdc::output_cell_file(file_id);
+   if(vdc::verbose && vdc::format == vdc::binary) print_spin_encoding(first);
 
-      last_file_id = file_id;
+   const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
 
+   // process contiguous blocks of snapshots on each thread so that delta
+   // encoded data are decoded in sequence
+   std::vector<std::thread> threads;
+   for(unsigned int t = 1; t < num_threads; t++){
+      threads.push_back(std::thread(convert_spin_snapshots, first + (num_snapshots*t)/num_threads, first + (num_snapshots*(t+1))/num_threads));
    }
+   convert_spin_snapshots(first, first + num_snapshots/num_threads);
+   for(unsigned int t = 0; t < threads.size(); t++) threads[t].join();
+
+   const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+   std::cout << "Converted " << num_snapshots << " snapshots in " << elapsed << " s (" << double(num_snapshots)/elapsed << " frames/s)" << std::endl;
+
+   // release container files
+   for(unsigned int f = 0; f < container_files.size(); f++) delete container_files[f];
+   container_files.resize(0);
 
    // set global start and end file id
-   vdc::final_file_id = last_file_id;
+   vdc::start_file_id = snapshot_ids[first];
+   vdc::final_file_id = snapshot_ids[last-1];
 
    // output povray file
    if(vdc::povray) output_povray_file();
 
+   // output vtk time series file
+   if(vdc::vtk){
+      std::vector<uint64_t> file_ids(snapshot_ids.begin() + first, snapshot_ids.begin() + last);
+      std::vector<double> times(snapshot_times.begin() + first, snapshot_times.begin() + last);
+      vdc::output_vtk_time_series(file_ids, times);
+   }
+
    return;
 
 }
@@ -93,7 +246,7 @@ void process_spins(){
 //       #------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-bool read_spin_metadata(unsigned int file_id){
+bool read_spin_metadata(unsigned int file_id, std::vector<std::string>& filenames, double& time){
 
    // determine file name
    std::stringstream filename;
@@ -110,32 +263,32 @@ bool read_spin_metadata(unsigned int file_id){
       return false;
    }
 
-   // Metafile found - inform the user and process data
-   if(vdc::verbose) std::cout << "--------------------------------------------------------------------" << std::endl;
-   std::cout << "Processing snapshot " << std::setfill('0') << std::setw(8) << file_id << std::endl;
-   if(vdc::verbose) std::cout << "   Reading spin meta-data file " << filename.str() << std::endl;
-
    std::string line; // line string variable
 
-   // read in file header (not useful - need to read in variables)
-   for(int i=0; i<10; i++) getline(smfile, line);
+   // read in file header
+   for(int i=0; i<5; i++) getline(smfile, line);
+
+   // get simulation time
+   getline(smfile, line);
+   line.erase (line.begin(), line.begin()+6);
+   time = atof(line.c_str());
+
+   // skip field, temperature and magnetisation
+   for(int i=0; i<4; i++) getline(smfile, line);
 
    // get number of subsidiary files
    getline(smfile, line);
    line.erase (line.begin(), line.begin()+22);
    unsigned int num_spin_files=atoi(line.c_str());
 
-   if(vdc::verbose) std::cout << "   Number of data files: " << num_spin_files << std::endl;
-
-   vdc::spin_filenames.resize(0);
+   filenames.resize(0);
 
    for(int file = 0; file < num_spin_files; file++){
       getline(smfile, line);
       line.erase(remove(line.begin(), line.end(), '\t'), line.end());
       line.erase(remove(line.begin(), line.end(), ' '), line.end());
       line.erase(remove(line.begin(), line.end(), '\r'), line.end());
-      vdc::spin_filenames.push_back(line);
-      if(vdc::verbose) std::cout << "      " << line << std::endl;
+      filenames.push_back(line);
    }
 
    return true;
@@ -143,85 +296,337 @@ bool read_spin_metadata(unsigned int file_id){
 }
 
 //------------------------------------------------------------------------------
-// Function to read in coordinate data from subsidiary files
+// Function to locate spin data of snapshot s, mapping separate data files
+// into memory if needed
+//------------------------------------------------------------------------------
+void open_spin_snapshot(uint64_t s, vdc::snapshot_t& snapshot){
+
+   if(container){
+      vdc::open_container_snapshot(container_files, s, snapshot);
+      return;
+   }
+
+   const unsigned int file_id = snapshot_ids[s];
+
+   double time = 0.0;
+   if(!vdc::read_spin_metadata(file_id, snapshot.filenames, time)){
+      std::cerr << std::endl << "   Error! Spin meta-data file for snapshot " << file_id << " cannot be opened. Exiting" << std::endl;
+      exit(1);
+   }
+
+   const unsigned int num_files = snapshot.filenames.size();
+
+   // allocate mapped files
+   while(snapshot.files.size() < num_files) snapshot.files.push_back(new vdc::mapped_file_t);
+
+   snapshot.data.resize(num_files);
+   snapshot.data_size.resize(num_files);
+
+   for(unsigned int f = 0; f < num_files; f++){
+      if(!snapshot.files[f]->open(snapshot.filenames[f])){
+         std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" cannot be opened. Exiting" << std::endl;
+         exit(1);
+      }
+      snapshot.data[f] = snapshot.files[f]->data;
+      snapshot.data_size[f] = snapshot.files[f]->size;
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to release mapped spin data files
 //------------------------------------------------------------------------------
-void read_spin_data(unsigned int file_id){
+void close_spin_snapshot(vdc::snapshot_t& snapshot){
 
-   if(vdc::verbose) std::cout << "   Reading spin data... " << std::flush;
+   for(unsigned int f = 0; f < snapshot.files.size(); f++) delete snapshot.files[f];
+   snapshot.files.resize(0);
+   snapshot.data.resize(0);
+   snapshot.data_size.resize(0);
 
-   // resize arrays
-   if(vdc::spins.size() != 3*vdc::num_atoms) vdc::spins.resize(3*vdc::num_atoms);
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read in spin data of snapshot s. Delta encoded data are decoded
+// starting from the last key frame of each file unless the previous snapshot
+// was already decoded by this thread.
+//------------------------------------------------------------------------------
+void load_spin_snapshot(uint64_t s, vdc::snapshot_t& snapshot){
+
+   const int64_t file_id = snapshot_ids[s];
+
+   if(vdc::format == vdc::text){
+      double time = 0.0;
+      if(!vdc::read_spin_metadata(file_id, snapshot.filenames, time)){
+         std::cerr << std::endl << "   Error! Spin meta-data file for snapshot " << file_id << " cannot be opened. Exiting" << std::endl;
+         exit(1);
+      }
+      vdc::read_text_spin_data(snapshot);
+      return;
+   }
+
+   vdc::open_spin_snapshot(s, snapshot);
+
+   const unsigned int num_files = snapshot.data.size();
+   if(snapshot.spin_code_file_id.size() != num_files) snapshot.spin_code_file_id.resize(num_files, -1);
+
+   // find earliest snapshot from which delta encoded files must be decoded
+   std::vector<bool> required(num_files, false);
+   unsigned int num_required = 0;
+   for(unsigned int f = 0; f < num_files; f++){
+      if(spin_data_type(snapshot.data[f], snapshot.data_size[f]) == delta_data && snapshot.spin_code_file_id[f] != file_id - 1){
+         required[f] = true;
+         num_required++;
+      }
+   }
+
+   int64_t start = s;
+   for(int64_t k = int64_t(s) - 1; k >= 0 && num_required > 0; k--){
+      vdc::open_spin_snapshot(k, snapshot);
+      for(unsigned int f = 0; f < num_files; f++){
+         if(!required[f]) continue;
+         // already decoded on this thread or key frame
+         if(snapshot.spin_code_file_id[f] == int64_t(snapshot_ids[k]) ||
+            spin_data_type(snapshot.data[f], snapshot.data_size[f]) != delta_data){
+            required[f] = false;
+            num_required--;
+            start = k;
+         }
+      }
+   }
+
+   // decode codes of preceding snapshots without reconstructing spins
+   for(int64_t k = start; k < int64_t(s); k++){
+      vdc::open_spin_snapshot(k, snapshot);
+      const int64_t id = snapshot_ids[k];
+      uint64_t atom_id = 0;
+      for(unsigned int f = 0; f < num_files; f++){
+         const spin_data_type_t type = spin_data_type(snapshot.data[f], snapshot.data_size[f]);
+         const int64_t last_id = snapshot.spin_code_file_id[f];
+         if(type != full_data && last_id < id && (type == keyframe_data || last_id == id - 1)){
+            vdc::read_binary_spin_data(snapshot, id, f, atom_id, false);
+         }
+         atom_id += spin_data_num_atoms(snapshot.data[f], snapshot.data_size[f]);
+      }
+   }
+
+   // read spin data of snapshot
+   if(start < int64_t(s)) vdc::open_spin_snapshot(s, snapshot);
+
+   uint64_t atom_id = 0;
+   for(unsigned int f = 0; f < num_files; f++){
+      atom_id += vdc::read_binary_spin_data(snapshot, file_id, f, atom_id, true);
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read in spin data from text files
+//------------------------------------------------------------------------------
+void read_text_spin_data(vdc::snapshot_t& snapshot){
 
    // index counter
    uint64_t atom_id = 0;
 
    // loop over all files
-   for(unsigned int f = 0; f < vdc::spin_filenames.size(); f++){
-
-      switch (vdc::format){
-
-         case vdc::binary:{
-            uint64_t num_atoms_in_file = 0;
-            // open file in binary mode
-            std::ifstream ifile;
-            ifile.open(spin_filenames[f].c_str(), std::ios::binary); // check for errors
-            // check for open file
-            if(!ifile.is_open()){
-               std::cerr << std::endl << "   Error! Spin data file \"" << spin_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
-               exit(1);
-            }
-            // read number of atoms
-            ifile.read( (char*)&num_atoms_in_file,sizeof(uint64_t) );
-            // read spin data
-            ifile.read((char*)&vdc::spins[atom_id*3], sizeof(double)*num_atoms_in_file*3);
-            // increment counter
-            atom_id += num_atoms_in_file;
-            ifile.close();
-            break;
-         }
+   for(unsigned int f = 0; f < snapshot.filenames.size(); f++){
+
+      // open file
+      std::ifstream ifile;
+      ifile.open(snapshot.filenames[f].c_str()); // check for errors
+      // check for open file
+      if(!ifile.is_open()){
+         std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" cannot be opened. Exiting" << std::endl;
+         exit(1);
+      }
+
+      uint64_t num_atoms_in_file = 0;
+      std::string line;
+      getline(ifile, line);
+      {
+         std::istringstream ss(line);
+         ss >> num_atoms_in_file; // interpret as uint64_t
+      }
+      if(atom_id + num_atoms_in_file > vdc::num_atoms){
+         std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" has too many atoms. Exiting" << std::endl;
+         exit(1);
+      }
+      double x,y,z;
+      // loop over all atoms in file and load as x,y,z sets
+      for(uint64_t idx = 0; idx < num_atoms_in_file; idx++){
+         getline(ifile, line);
+         std::istringstream ss(line);
+         ss >> x >> y >> z;
+         snapshot.spins[3*atom_id + 0] = x;
+         snapshot.spins[3*atom_id + 1] = y;
+         snapshot.spins[3*atom_id + 2] = z;
+         // increment atom counter
+         atom_id += 1;
+      }
+      ifile.close();
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read binary spin data of file f (full or compact format),
+// returning the number of atoms read
+//------------------------------------------------------------------------------
+uint64_t read_binary_spin_data(vdc::snapshot_t& snapshot, unsigned int file_id, unsigned int f, uint64_t atom_id, bool reconstruct){
+
+   const char* data = snapshot.data[f];
+   const uint64_t size = snapshot.data_size[f];
+
+   // compact spin data
+   if(spin_data_type(data, size) != full_data) return read_encoded_spin_data(snapshot, file_id, f, atom_id, reconstruct);
+
+   // read number of atoms
+   const uint64_t num_atoms_in_file = spin_data_num_atoms(data, size);
+
+   if(size < 8 || atom_id + num_atoms_in_file > vdc::num_atoms){
+      std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" has too many atoms. Exiting" << std::endl;
+      exit(1);
+   }
+   if(size - 8 < sizeof(double)*num_atoms_in_file*3){
+      std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" is truncated. Exiting" << std::endl;
+      exit(1);
+   }
+
+   // read spin data
+   if(num_atoms_in_file > 0) std::memcpy(&snapshot.spins[atom_id*3], data + 8, sizeof(double)*num_atoms_in_file*3);
+
+   return num_atoms_in_file;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to read compact (quantised) spin data of file f and decode to spin
+// vectors, returning the number of atoms in the file. If reconstruct is false
+// only the codes are decoded (for delta decoding of later snapshots). The
+// format is described in src/config/encode.cpp.
+//------------------------------------------------------------------------------
+uint64_t read_encoded_spin_data(vdc::snapshot_t& snapshot, unsigned int file_id, unsigned int f, uint64_t atom_id, bool reconstruct){
+
+   // read header
+   const char* header = snapshot.data[f] + 8;
+   const uint64_t size = snapshot.data_size[f];
+
+   const uint64_t num_atoms_in_file = unpack_uint(header +  0, 8);
+   const uint64_t encoding          = unpack_uint(header +  8, 4);
+   const uint64_t bits_per_spin     = unpack_uint(header + 12, 4);
+   const uint64_t delta             = unpack_uint(header + 16, 4);
+   const uint64_t num_bytes         = unpack_uint(header + 32, 8);
+
+   if((encoding != 1 && encoding != 2) || (bits_per_spin != 32 && bits_per_spin != 48) || atom_id + num_atoms_in_file > vdc::num_atoms){
+      std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" has invalid header. Exiting" << std::endl;
+      exit(1);
+   }
+
+   // encoded data follow header
+   const char* data = snapshot.data[f] + 48;
+   if(num_bytes > size - 48){
+      std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" is truncated. Exiting" << std::endl;
+      exit(1);
+   }
 
-         case vdc::text:{
-            // open file
-            std::ifstream ifile;
-            ifile.open(spin_filenames[f].c_str()); // check for errors
-            // check for open file
-            if(!ifile.is_open()){
-               std::cerr << std::endl << "   Error! Spin data file \"" << spin_filenames[f] << "\" cannot be opened. Exiting" << std::endl;
-               exit(1);
-            }
-
-            uint64_t num_atoms_in_file = 0;
-            std::string line;
-            getline(ifile, line);
-            {
-               std::istringstream ss(line);
-               ss >> num_atoms_in_file; // interpret as uint64_t
-            }
-            double x,y,z;
-            int type_id, category_id;
-            // loop over all atoms in file and load as x,y,z sets
-            for(uint64_t idx = 0; idx < num_atoms_in_file; idx++){
-               getline(ifile, line);
-               std::istringstream ss(line);
-               ss >> x >> y >> z;
-               vdc::spins[3*atom_id + 0] = x;
-               vdc::spins[3*atom_id + 1] = y;
-               vdc::spins[3*atom_id + 2] = z;
-               // increment atom counter
-               atom_id += 1;
-            }
-            ifile.close();
-            break;
+   const int bits = bits_per_spin/2;
+   const uint32_t mask = (uint32_t(1) << bits) - 1;
+   const uint64_t num_codes = 2*num_atoms_in_file;
+
+   if(snapshot.spin_codes.size() != 2*vdc::num_atoms) snapshot.spin_codes.resize(2*vdc::num_atoms, 0);
+   if(snapshot.spin_code_file_id.size() != snapshot.data.size()) snapshot.spin_code_file_id.resize(snapshot.data.size(), -1);
+
+   uint32_t* codes = &snapshot.spin_codes[2*atom_id];
+
+   if(delta){
+
+      // delta frames require previous snapshot
+      if(snapshot.spin_code_file_id[f] != int64_t(file_id) - 1){
+         std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" is delta encoded and requires previous snapshot. Exiting" << std::endl;
+         exit(1);
+      }
+
+      uint64_t byte = 0;
+      for(uint64_t i = 0; i < num_codes; i++){
+         // read variable length integer
+         uint64_t zz = 0;
+         int shift = 0;
+         while(byte < num_bytes){
+            const unsigned char c = data[byte++];
+            zz |= uint64_t(c & 0x7F) << shift;
+            shift += 7;
+            if(c < 0x80) break;
          }
+         // undo zig-zag encoding
+         const int64_t d = int64_t(zz >> 1) ^ -int64_t(zz & 1);
+         codes[i] = uint32_t(int64_t(codes[i]) + d) & mask;
+      }
+
+   }
+   else{
 
+      const int bytes_per_code = bits/8;
+      if(num_bytes < num_codes*bytes_per_code){
+         std::cerr << std::endl << "   Error! Spin data file \"" << snapshot.filenames[f] << "\" is truncated. Exiting" << std::endl;
+         exit(1);
       }
+      for(uint64_t i = 0; i < num_codes; i++) codes[i] = unpack_uint(&data[bytes_per_code*i], bytes_per_code);
 
    }
 
-   // output informative message to user
-   if(vdc::verbose) std::cout << "done!" << std::endl;
+   snapshot.spin_code_file_id[f] = file_id;
 
-   return;
+   if(!reconstruct) return num_atoms_in_file;
+
+   // reconstruct spin directions
+   const double steps = double((uint32_t(1) << bits) - 2);
+   double* s = &snapshot.spins[3*atom_id];
+
+   if(encoding == 1){
+
+      // octahedral
+      const double scale = 2.0/steps;
+      for(uint64_t i = 0; i < num_atoms_in_file; i++){
+         double u = double(codes[2*i+0])*scale - 1.0;
+         double v = double(codes[2*i+1])*scale - 1.0;
+         const double z = 1.0 - fabs(u) - fabs(v);
+         if(z < 0.0){
+            const double fu = (1.0 - fabs(v))*(u >= 0.0 ? 1.0 : -1.0);
+            const double fv = (1.0 - fabs(u))*(v >= 0.0 ? 1.0 : -1.0);
+            u = fu;
+            v = fv;
+         }
+         const double inorm = 1.0/sqrt(u*u + v*v + z*z);
+         s[3*i+0] = u*inorm;
+         s[3*i+1] = v*inorm;
+         s[3*i+2] = z*inorm;
+      }
+
+   }
+   else{
+
+      // spherical
+      const double theta_scale = M_PI/steps;
+      const double phi_scale = 2.0*M_PI/double(uint64_t(1) << bits);
+      for(uint64_t i = 0; i < num_atoms_in_file; i++){
+         const double theta = double(codes[2*i+0])*theta_scale;
+         const double phi = double(codes[2*i+1])*phi_scale - M_PI;
+         s[3*i+0] = sin(theta)*cos(phi);
+         s[3*i+1] = sin(theta)*sin(phi);
+         s[3*i+2] = cos(theta);
+      }
+
+   }
+
+   return num_atoms_in_file;
 
 }
 
@@ -14,7 +14,10 @@
 #define VDC_H_
 
 // C++ standard library headers
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <string>
 #include <vector>
 
 namespace vdc{
@@ -24,6 +27,15 @@ namespace vdc{
    extern bool xyz;
    extern bool povray;
    extern bool cells;
+   extern bool vtk;
+   extern bool vtk_float32; // flag to specify single precision vtk data
+
+   // number of threads for processing snapshots in parallel
+   extern unsigned int num_threads;
+
+   // range of snapshots to convert (inclusive)
+   extern uint64_t range_min;
+   extern uint64_t range_max;
 
    // enumerated integers for option selection
    enum format_t{ binary = 0, text = 1};
@@ -51,7 +63,6 @@ namespace vdc{
    extern std::vector<int> type;
 
    extern std::vector<double> coordinates;
-   extern std::vector<double> spins;
 
    // non-magnetic atom data
    extern uint64_t num_nm_atoms;
@@ -66,27 +77,89 @@ namespace vdc{
 
    extern std::vector<int> atom_cell_id;
    extern std::vector<double> cell_coords;
-   extern std::vector< std::vector< std::vector <double> > > cell_magnetization;
 
    // array to store subsidiary data file names
    extern std::vector <std::string> coord_filenames;
-   extern std::vector <std::string> spin_filenames;
+   extern std::vector <uint64_t> coord_file_atoms; // number of atoms in each coordinate file
    extern std::vector <std::string> nm_filenames;
 
+   // spin data container files and offsets of spin data of each snapshot
+   extern std::vector <std::string> container_filenames;
+   extern std::vector <uint64_t> container_snapshot_ids;
+   extern std::vector <double> container_snapshot_times;
+   extern std::vector < std::vector <uint64_t> > container_offsets;
+
+   //---------------------------------------------------------------------------
+   // Class for read only access to a memory mapped data file. If the file
+   // cannot be mapped it is read into memory instead.
+   //---------------------------------------------------------------------------
+   class mapped_file_t{
+
+   public:
+
+      mapped_file_t();
+      ~mapped_file_t();
+
+      bool open(const std::string& filename);
+      void close();
+
+      const char* data; // file contents
+      uint64_t size; // file size (bytes)
+
+   private:
+
+      bool mapped;
+      std::vector<char> buffer;
+
+      // mapped files cannot be copied
+      mapped_file_t(const mapped_file_t&);
+      mapped_file_t& operator=(const mapped_file_t&);
+
+   };
+
+   // spin data of one snapshot and codes of last compact spin snapshot for
+   // delta decoding, one set for each thread
+   struct snapshot_t{
+      std::vector<double> spins;
+      std::vector<uint32_t> spin_codes;
+      std::vector<int64_t> spin_code_file_id; // snapshot decoded last for each data file
+      std::vector<std::string> filenames; // spin data files of snapshot
+      std::vector<mapped_file_t*> files; // mapped spin data files
+      std::vector<const char*> data; // spin data of snapshot in each file
+      std::vector<uint64_t> data_size; // maximum size of spin data in each file
+   };
+
    // Functions
+   void command(int argc, char* argv[]);
+
    void process_coordinates();
    void process_spins();
 
+   bool read_container_metadata();
+   void read_container_indices(std::vector<mapped_file_t*>& files);
+   void open_container_snapshot(std::vector<mapped_file_t*>& files, uint64_t s, vdc::snapshot_t& snapshot);
+
+   // function to unpack little-endian integer from byte buffer
+   inline uint64_t unpack_uint(const char* buffer, const int num_bytes){
+      uint64_t value = 0;
+      for(int b = num_bytes-1; b >= 0; b--) value = (value << 8) | uint64_t((unsigned char)buffer[b]);
+      return value;
+   }
+
    // forward function declarations
    void read_nm_metadata();
    void read_nm_data();
 
    void output_xyz_file();
-   void output_inc_file(unsigned int spin_file_id);
+   void output_inc_file(unsigned int spin_file_id, const std::vector<double>& spins);
    void output_povray_file();
 
+   void initialise_vtk();
+   void output_vtk_file(unsigned int spin_file_id, const std::vector<double>& spins);
+   void output_vtk_time_series(const std::vector<uint64_t>& file_ids, const std::vector<double>& times);
+
    void initialise_cells();
-   void output_cell_file(unsigned int spin_file_id);
+   void output_cell_file(unsigned int spin_file_id, const std::vector<double>& spins);
 
    void rgb( const double& ireal, double &red, double &green, double &blue);
 
@@ -0,0 +1,295 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) agent 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+
+// program header
+#include "vdc.hpp"
+
+//------------------------------------------------------------------------------
+// Spin data are written as VTK XML unstructured grid (.vtu) files with the
+// array data appended as raw binary, each array preceded by its size in bytes
+// (UInt64). Atoms are stored as points without cells, with point data:
+//
+//    spin     - spin direction (Float64 or Float32, 3 components)
+//    type     - material id (Int32)
+//    category - category id (Int32)
+//
+// Each output group of the simulation (coordinate data file) is written as a
+// separate piece file spins-XXXXXXXX-GGGGGG.vtu collected by a parallel
+// spins-XXXXXXXX.pvtu file so that the pieces can be loaded in parallel. A
+// single group is written as spins-XXXXXXXX.vtu. Non-magnetic atoms are added
+// to the last piece with zero spin. The time series is collected in spins.pvd.
+//------------------------------------------------------------------------------
+
+namespace vdc{
+
+// file scope variables
+namespace{
+   std::vector<uint64_t> piece_start; // first magnetic atom in each piece
+   std::vector<uint64_t> piece_atoms; // number of magnetic atoms in each piece
+   std::vector<uint64_t> piece_points; // total number of atoms in each piece
+   std::vector< std::vector<char> > piece_coordinates; // point coordinates in each piece (output precision)
+   std::vector< std::vector<char> > piece_types; // material id of atoms in each piece
+   std::vector< std::vector<char> > piece_categories; // category of atoms in each piece
+}
+
+//------------------------------------------------------------------------------
+// Function to append real data to byte buffer in output precision
+//------------------------------------------------------------------------------
+void append_vtk_real_data(std::vector<char>& buffer, const double* data, const uint64_t n){
+
+   const uint64_t start = buffer.size();
+
+   if(vdc::vtk_float32){
+      buffer.resize(start + n*sizeof(float));
+      for(uint64_t i = 0; i < n; i++){
+         const float value = data[i];
+         std::memcpy(&buffer[start + i*sizeof(float)], &value, sizeof(float));
+      }
+   }
+   else if(n > 0){
+      buffer.resize(start + n*sizeof(double));
+      std::memcpy(&buffer[start], data, n*sizeof(double));
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to append integer data to byte buffer
+//------------------------------------------------------------------------------
+void append_vtk_int_data(std::vector<char>& buffer, const int* data, const uint64_t n){
+
+   if(n == 0) return;
+
+   const uint64_t start = buffer.size();
+   buffer.resize(start + n*sizeof(int));
+   std::memcpy(&buffer[start], data, n*sizeof(int));
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to determine pieces and store static point data (coordinates, type
+// and category) in output format
+//------------------------------------------------------------------------------
+void initialise_vtk(){
+
+   // one piece per coordinate data file, or all atoms if inconsistent
+   std::vector<uint64_t> file_atoms = vdc::coord_file_atoms;
+   uint64_t total_atoms = 0;
+   for(unsigned int f = 0; f < file_atoms.size(); f++) total_atoms += file_atoms[f];
+   if(file_atoms.size() == 0 || total_atoms != vdc::num_atoms) file_atoms.assign(1, vdc::num_atoms);
+
+   const unsigned int num_pieces = file_atoms.size();
+
+   piece_start.resize(num_pieces);
+   piece_atoms.resize(num_pieces);
+   piece_points.resize(num_pieces);
+   piece_coordinates.resize(num_pieces);
+   piece_types.resize(num_pieces);
+   piece_categories.resize(num_pieces);
+
+   uint64_t start = 0;
+   for(unsigned int p = 0; p < num_pieces; p++){
+
+      piece_start[p] = start;
+      piece_atoms[p] = file_atoms[p];
+      piece_points[p] = file_atoms[p];
+
+      append_vtk_real_data(piece_coordinates[p], &vdc::coordinates[3*start], 3*file_atoms[p]);
+      append_vtk_int_data(piece_types[p], &vdc::type[start], file_atoms[p]);
+      append_vtk_int_data(piece_categories[p], &vdc::category[start], file_atoms[p]);
+
+      // add non-magnetic atoms to last piece
+      if(p == num_pieces - 1 && vdc::num_nm_atoms > 0){
+         piece_points[p] += vdc::num_nm_atoms;
+         append_vtk_real_data(piece_coordinates[p], &vdc::nm_coordinates[0], 3*vdc::num_nm_atoms);
+         append_vtk_int_data(piece_types[p], &vdc::nm_type[0], vdc::num_nm_atoms);
+         append_vtk_int_data(piece_categories[p], &vdc::nm_category[0], vdc::num_nm_atoms);
+      }
+
+      start += file_atoms[p];
+
+   }
+
+   if(vdc::verbose) std::cout << "Writing vtk files with " << num_pieces << " pieces per snapshot in "
+                              << (vdc::vtk_float32 ? "single" : "double") << " precision" << std::endl;
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to write single piece of spin data to vtu file
+//------------------------------------------------------------------------------
+void output_vtu_piece(const std::string& filename, const unsigned int p, const std::vector<char>& spin_data){
+
+   const std::string real_type = vdc::vtk_float32 ? "Float32" : "Float64";
+
+   // sizes of appended data blocks (each preceded by 8 byte size)
+   const uint64_t block_size[4] = { spin_data.size(), piece_types[p].size(), piece_categories[p].size(), piece_coordinates[p].size() };
+   uint64_t offset[7];
+   offset[0] = 0;
+   for(int b = 1; b < 7; b++) offset[b] = offset[b-1] + sizeof(uint64_t) + (b <= 4 ? block_size[b-1] : 0);
+
+   std::ostringstream xml;
+   xml << "<?xml version=\"1.0\"?>\n";
+   xml << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+   xml << "  <UnstructuredGrid>\n";
+   xml << "    <Piece NumberOfPoints=\"" << piece_points[p] << "\" NumberOfCells=\"0\">\n";
+   xml << "      <PointData Vectors=\"spin\" Scalars=\"type\">\n";
+   xml << "        <DataArray type=\"" << real_type << "\" Name=\"spin\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offset[0] << "\"/>\n";
+   xml << "        <DataArray type=\"Int32\" Name=\"type\" format=\"appended\" offset=\"" << offset[1] << "\"/>\n";
+   xml << "        <DataArray type=\"Int32\" Name=\"category\" format=\"appended\" offset=\"" << offset[2] << "\"/>\n";
+   xml << "      </PointData>\n";
+   xml << "      <Points>\n";
+   xml << "        <DataArray type=\"" << real_type << "\" NumberOfComponents=\"3\" format=\"appended\" offset=\"" << offset[3] << "\"/>\n";
+   xml << "      </Points>\n";
+   xml << "      <Cells>\n";
+   xml << "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"" << offset[4] << "\"/>\n";
+   xml << "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"" << offset[5] << "\"/>\n";
+   xml << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offset[6] << "\"/>\n";
+   xml << "      </Cells>\n";
+   xml << "    </Piece>\n";
+   xml << "  </UnstructuredGrid>\n";
+   xml << "  <AppendedData encoding=\"raw\">\n   _";
+
+   std::ofstream ofile(filename.c_str(), std::ios::binary);
+   if(!ofile.is_open()){
+      std::cerr << "Error! vtk file \"" << filename << "\" cannot be opened for writing. Exiting" << std::endl;
+      exit(1);
+   }
+
+   const std::string header = xml.str();
+   ofile.write(header.c_str(), header.size());
+
+   // write appended data blocks
+   const std::vector<char>* blocks[4] = { &spin_data, &piece_types[p], &piece_categories[p], &piece_coordinates[p] };
+   for(int b = 0; b < 4; b++){
+      ofile.write(reinterpret_cast<const char*>(&block_size[b]), sizeof(uint64_t));
+      if(block_size[b] > 0) ofile.write(&(*blocks[b])[0], block_size[b]);
+   }
+
+   // empty cell arrays
+   const uint64_t zero = 0;
+   for(int b = 4; b < 7; b++) ofile.write(reinterpret_cast<const char*>(&zero), sizeof(uint64_t));
+
+   ofile << "\n  </AppendedData>\n";
+   ofile << "</VTKFile>\n";
+
+   ofile.close();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to output spin data of a single snapshot in vtk format
+//------------------------------------------------------------------------------
+void output_vtk_file(unsigned int spin_file_id, const std::vector<double>& spins){
+
+   const unsigned int num_pieces = piece_start.size();
+
+   // spin data of one piece in output format
+   std::vector<char> spin_data;
+
+   for(unsigned int p = 0; p < num_pieces; p++){
+
+      spin_data.resize(0);
+      append_vtk_real_data(spin_data, &spins[3*piece_start[p]], 3*piece_atoms[p]);
+
+      // non-magnetic atoms have no spin
+      if(piece_points[p] > piece_atoms[p]){
+         const std::vector<double> zero(3*(piece_points[p] - piece_atoms[p]), 0.0);
+         append_vtk_real_data(spin_data, &zero[0], zero.size());
+      }
+
+      std::stringstream filename;
+      filename << "spins-" << std::setfill('0') << std::setw(8) << spin_file_id;
+      if(num_pieces > 1) filename << "-" << std::setw(6) << p;
+      filename << ".vtu";
+
+      output_vtu_piece(filename.str(), p, spin_data);
+
+   }
+
+   // output parallel file collecting pieces
+   if(num_pieces > 1){
+
+      const std::string real_type = vdc::vtk_float32 ? "Float32" : "Float64";
+
+      std::stringstream filename;
+      filename << "spins-" << std::setfill('0') << std::setw(8) << spin_file_id << ".pvtu";
+
+      std::ofstream ofile(filename.str().c_str());
+      ofile << "<?xml version=\"1.0\"?>\n";
+      ofile << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+      ofile << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+      ofile << "    <PPointData Vectors=\"spin\" Scalars=\"type\">\n";
+      ofile << "      <PDataArray type=\"" << real_type << "\" Name=\"spin\" NumberOfComponents=\"3\"/>\n";
+      ofile << "      <PDataArray type=\"Int32\" Name=\"type\"/>\n";
+      ofile << "      <PDataArray type=\"Int32\" Name=\"category\"/>\n";
+      ofile << "    </PPointData>\n";
+      ofile << "    <PPoints>\n";
+      ofile << "      <PDataArray type=\"" << real_type << "\" NumberOfComponents=\"3\"/>\n";
+      ofile << "    </PPoints>\n";
+      ofile << "    <PCells>\n";
+      ofile << "      <PDataArray type=\"Int64\" Name=\"connectivity\"/>\n";
+      ofile << "      <PDataArray type=\"Int64\" Name=\"offsets\"/>\n";
+      ofile << "      <PDataArray type=\"UInt8\" Name=\"types\"/>\n";
+      ofile << "    </PCells>\n";
+      for(unsigned int p = 0; p < num_pieces; p++){
+         ofile << "    <Piece Source=\"spins-" << std::setfill('0') << std::setw(8) << spin_file_id << "-" << std::setw(6) << p << ".vtu\"/>\n";
+      }
+      ofile << "  </PUnstructuredGrid>\n";
+      ofile << "</VTKFile>\n";
+      ofile.close();
+
+   }
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to output time series file spins.pvd collecting all snapshots
+//------------------------------------------------------------------------------
+void output_vtk_time_series(const std::vector<uint64_t>& file_ids, const std::vector<double>& times){
+
+   const std::string extension = piece_start.size() > 1 ? ".pvtu" : ".vtu";
+
+   std::ofstream ofile("spins.pvd");
+   ofile << "<?xml version=\"1.0\"?>\n";
+   ofile << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+   ofile << "  <Collection>\n";
+   for(uint64_t s = 0; s < file_ids.size(); s++){
+      ofile << "    <DataSet timestep=\"" << std::setprecision(10) << times[s] << "\" group=\"\" part=\"0\" file=\"spins-"
+            << std::setfill('0') << std::setw(8) << file_ids[s] << extension << "\"/>\n";
+   }
+   ofile << "  </Collection>\n";
+   ofile << "</VTKFile>\n";
+   ofile.close();
+
+   return;
+
+}
+
+} // end of namespace vdc